@@ -48,6 +48,8 @@ private slots:
 
     void testEmpty();
 
+    void benchmarkKeyStrokes();
+
 private:
     void assertButton (const ButtonShortcut& shortcut, int buttonNumber) const;
     void assertEquals (const ButtonShortcut& shortcut1, const ButtonShortcut& shortcut2) const;
@@ -223,6 +225,18 @@ void TestButtonShortcut::testButton()
 }
 
 
+void TestButtonShortcut::benchmarkKeyStrokes()
+{
+    ButtonShortcut shortcut;
+
+    QBENCHMARK {
+        shortcut.set(QLatin1String("key +ctrl +shift +pgdn -pgdn"));
+        shortcut.toQKeySequenceString();
+        shortcut.toString();
+    }
+}
+
+
 void TestButtonShortcut::testEmpty() {
 
     ButtonShortcut shortcut1;
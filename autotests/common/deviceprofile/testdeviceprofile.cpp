@@ -22,6 +22,8 @@
 
 #include <QtTest>
 
+#include <type_traits>
+
 using namespace Wacom;
 
 /**
@@ -37,6 +39,7 @@ private slots:
     void testConstructor();
     void testSetter();
     void testCopy();
+    void testCopyOnWrite();
 };
 
 QTEST_MAIN(TestDeviceProfile)
@@ -64,6 +67,39 @@ void TestDeviceProfile::testCopy()
     CommonTestUtils::assertValues(profile3);
 }
 
+void TestDeviceProfile::testCopyOnWrite()
+{
+    DeviceProfile profile1(DeviceType::Stylus);
+    CommonTestUtils::setValues(profile1);
+
+    // modifying a copy must not change the original
+    DeviceProfile profile2(profile1);
+    profile2.setProperty(Property::Button1, QLatin1String("changed"));
+    profile2.setDeviceType(DeviceType::Eraser);
+
+    CommonTestUtils::assertValues(profile1);
+    QCOMPARE (profile1.getDeviceType(), DeviceType::Stylus);
+    QCOMPARE (profile2.getDeviceType(), DeviceType::Eraser);
+    QCOMPARE (profile2.getProperty(Property::Button1), QLatin1String("changed"));
+
+    // a moved profile keeps all values
+    DeviceProfile profile3(std::move(profile2));
+    QCOMPARE (profile3.getDeviceType(), DeviceType::Eraser);
+    QCOMPARE (profile3.getProperty(Property::Button1), QLatin1String("changed"));
+
+    // the moved-from profile is still a valid empty profile
+    QCOMPARE (profile2.getDeviceType(), DeviceType::Unknown);
+    QVERIFY  (profile2.getName().isEmpty());
+    QVERIFY  (profile2.getProperty(Property::Button1).isEmpty());
+
+    // containers only move profiles if moving can not throw
+    static_assert(std::is_nothrow_move_constructible<DeviceProfile>::value, "DeviceProfile has to be nothrow movable");
+    static_assert(std::is_nothrow_move_assignable<DeviceProfile>::value, "DeviceProfile has to be nothrow movable");
+
+    profile2 = profile1;
+    CommonTestUtils::assertValues(profile2);
+}
+
 void TestDeviceProfile::testSetter()
 {
     DeviceProfile profile;
@@ -130,6 +130,15 @@ void TestEnum::testFind()
     const EnumTest* find = EnumTest::find(QLatin1String("VAL01_PRIO50"));
     QVERIFY(find != nullptr);
     QCOMPARE(*find, EnumTest::VAL01_PRIO50);
+
+    const EnumTest* findIgnoreCase = EnumTest::find(QLatin1String("vAl02_PriO99"));
+    QVERIFY(findIgnoreCase != nullptr);
+    QCOMPARE(*findIgnoreCase, EnumTest::VAL02_PRIO99);
+
+    // every instance has to be found by its own key
+    for (EnumTest::const_iterator iter = EnumTest::begin() ; iter != EnumTest::end() ; ++iter) {
+        QCOMPARE(EnumTest::find(iter->key()), &(*iter));
+    }
 }
 
 void TestEnum::testIterator()
@@ -0,0 +1,235 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/pressurecurve.h"
+
+#include <QList>
+#include <QRandomGenerator>
+#include <QtTest>
+
+using namespace Wacom;
+
+
+/**
+ * @file testpressurecurve.cpp
+ *
+ * @test UnitTest for the pressure curve model class
+ */
+class TestPressureCurve : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFromString();
+    void testInvalidInput();
+    void testFromControlPoint();
+    void testLinear();
+    void testEvaluate();
+    void testBatchEvaluate();
+    void testPolyline();
+
+    void benchmarkBatchEvaluate();
+    void benchmarkEvaluate();
+};
+
+QTEST_MAIN(TestPressureCurve)
+
+void TestPressureCurve::testFromString()
+{
+    PressureCurve curve;
+
+    QVERIFY(curve.fromString(QLatin1String(" 10  20 80 90 ")));
+    QCOMPARE(curve.x1(), 10);
+    QCOMPARE(curve.y1(), 20);
+    QCOMPARE(curve.x2(), 80);
+    QCOMPARE(curve.y2(), 90);
+    QCOMPARE(curve.toString(), QLatin1String("10 20 80 90"));
+
+    QCOMPARE(PressureCurve(curve.toString()), curve);
+    QVERIFY(PressureCurve::isValid(u"0 100 100 0"));
+}
+
+void TestPressureCurve::testInvalidInput()
+{
+    const PressureCurve linear;
+
+    QStringList invalidCurves;
+    invalidCurves << QString() << QLatin1String("0 0 100") << QLatin1String("0 0 100 100 0")
+                  << QLatin1String("a 0 100 100") << QLatin1String("0 -1 100 100")
+                  << QLatin1String("0 0 101 100") << QLatin1String("0.5 0 100 100");
+
+    foreach (const QString& invalidCurve, invalidCurves) {
+        PressureCurve curve(10, 20, 30, 40);
+
+        QVERIFY2(!PressureCurve::isValid(invalidCurve), qPrintable(invalidCurve));
+        QVERIFY2(!curve.fromString(invalidCurve), qPrintable(invalidCurve));
+        QCOMPARE(curve, linear);
+    }
+
+    // out of range values are clamped
+    QCOMPARE(PressureCurve(-5, 0, 100, 120).toString(), QLatin1String("0 0 100 100"));
+}
+
+void TestPressureCurve::testFromControlPoint()
+{
+    // the second control point mirrors the first one
+    const PressureCurve curve = PressureCurve::fromControlPoint(20, 70);
+
+    QCOMPARE(curve.toString(), QLatin1String("20 70 30 80"));
+
+    // such a curve is symmetric to the diagonal from (0,1) to (1,0)
+    for (int i = 0 ; i < 10 ; ++i) {
+        const float x = i / 10.f;
+        const float y = curve.evaluate(x);
+
+        QVERIFY(qAbs(curve.evaluate(1.f - y) - (1.f - x)) < 0.02f);
+    }
+}
+
+void TestPressureCurve::testLinear()
+{
+    const PressureCurve curve;
+
+    QVERIFY(curve.isLinear());
+    QVERIFY(PressureCurve(QLatin1String("30 30 60 60")).isLinear());
+    QVERIFY(!PressureCurve(QLatin1String("0 50 50 100")).isLinear());
+
+    const float* lut = curve.lookupTable();
+
+    for (int i = 0 ; i < PressureCurve::LUT_SIZE ; ++i) {
+        QVERIFY(qAbs(lut[i] - static_cast<float>(i) / (PressureCurve::LUT_SIZE - 1)) < 0.001f);
+    }
+}
+
+void TestPressureCurve::testEvaluate()
+{
+    const PressureCurve soft(QLatin1String("0 75 25 100"));
+    const PressureCurve firm(QLatin1String("75 0 100 25"));
+
+    // the end points are fixed
+    QVERIFY(qAbs(soft.evaluate(0.f)) < 0.001f);
+    QVERIFY(qAbs(soft.evaluate(1.f) - 1.f) < 0.001f);
+
+    // out of range input is clamped
+    QCOMPARE(soft.evaluate(-1.f), soft.evaluate(0.f));
+    QCOMPARE(soft.evaluate(2.f), soft.evaluate(1.f));
+
+    // a soft curve reports more pressure, a firm curve less
+    QVERIFY(soft.evaluate(.5f) > .6f);
+    QVERIFY(firm.evaluate(.5f) < .4f);
+
+    // the output never decreases for increasing input
+    const float* lut = soft.lookupTable();
+
+    for (int i = 1 ; i < PressureCurve::LUT_SIZE ; ++i) {
+        QVERIFY(lut[i] >= lut[i - 1]);
+    }
+}
+
+void TestPressureCurve::testBatchEvaluate()
+{
+    // reference values of the curves as flattened by the wacom driver
+    const int   count             = 5;
+    const float references[count] = { .1f, .25f, .5f, .75f, .9f };
+
+    const struct {
+        const char* curve;
+        float       results[count];
+    } driverCurves[] = {
+        { "0 0 100 100",  { .1f,       .25f,      .5f,       .75f,      .9f       } },
+        { "0 75 25 100",  { .563081f,  .798259f,  .934335f,  .973140f,  .989256f  } },
+        { "75 0 100 25",  { .010744f,  .026860f,  .065665f,  .201741f,  .436919f  } },
+        { "10 40 60 90",  { .158065f,  .395161f,  .683673f,  .841837f,  .936735f  } },
+    };
+
+    float results[count];
+
+    for (const auto& driverCurve : driverCurves) {
+        PressureCurve(QLatin1String(driverCurve.curve)).evaluate(references, results, count);
+
+        for (int i = 0 ; i < count ; ++i) {
+            QVERIFY2(qAbs(results[i] - driverCurve.results[i]) < 0.0001f,
+                     qPrintable(QString::fromLatin1("%1 at %2").arg(QLatin1String(driverCurve.curve)).arg(references[i])));
+        }
+    }
+
+    // a batch gives the same results as single evaluations
+    const PressureCurve curve(QLatin1String("10 40 60 90"));
+    QRandomGenerator    random(1);
+
+    QList<float> pressures(1000);
+    QList<float> batchResults(pressures.size());
+
+    for (float& pressure : pressures) {
+        pressure = static_cast<float>(random.generateDouble());
+    }
+
+    curve.evaluate(pressures.constData(), batchResults.data(), pressures.size());
+
+    for (int i = 0 ; i < pressures.size() ; ++i) {
+        QCOMPARE(batchResults.at(i), curve.evaluate(pressures.at(i)));
+    }
+}
+
+void TestPressureCurve::testPolyline()
+{
+    const QPolygonF polyline = PressureCurve(QLatin1String("0 75 25 100")).toPolyline(16);
+
+    QCOMPARE(polyline.size(), 17);
+    QCOMPARE(polyline.first(), QPointF(0, 0));
+    QCOMPARE(polyline.last(), QPointF(1, 1));
+}
+
+void TestPressureCurve::benchmarkBatchEvaluate()
+{
+    const PressureCurve curve(QLatin1String("10 40 60 90"));
+    QRandomGenerator    random(1);
+
+    QList<float> pressures(1 << 20);
+    QList<float> results(pressures.size());
+
+    for (float& pressure : pressures) {
+        pressure = static_cast<float>(random.generateDouble());
+    }
+
+    QBENCHMARK {
+        curve.evaluate(pressures.constData(), results.data(), pressures.size());
+    }
+}
+
+void TestPressureCurve::benchmarkEvaluate()
+{
+    const PressureCurve curve(QLatin1String("10 40 60 90"));
+    QRandomGenerator    random(1);
+
+    QList<float> pressures(1 << 20);
+    QList<float> results(pressures.size());
+
+    for (float& pressure : pressures) {
+        pressure = static_cast<float>(random.generateDouble());
+    }
+
+    QBENCHMARK {
+        for (int i = 0 ; i < pressures.size() ; ++i) {
+            results[i] = curve.evaluate(pressures.at(i));
+        }
+    }
+}
+
+#include "testpressurecurve.moc"
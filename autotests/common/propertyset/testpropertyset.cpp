@@ -249,6 +249,12 @@ void TestPropertySet::testMap()
     const PropertySetTest* findId = PropertySetTest::map(Property::Touch);
     QVERIFY(findId != NULL);
     QVERIFY(*findId == PropertySetTest::VAL01_PRIO50);
+
+    // copies of a property have to map to the same instance
+    const Property copy(Property::StripLeftUp);
+    const PropertySetTest* findCopy = PropertySetTest::map(copy);
+    QVERIFY(findCopy != NULL);
+    QVERIFY(*findCopy == PropertySetTest::VAL02_PRIO99);
 }
 
 void TestPropertySet::testOperator()
@@ -0,0 +1,201 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/screenmap.h"
+#include "common/screenspace.h"
+#include "common/tabletarea.h"
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+using namespace Wacom;
+
+
+/**
+ * @file testscreenmap.cpp
+ *
+ * @test UnitTest for the screen map model class
+ */
+class TestScreenMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFromString();
+    void testEmptyArea();
+    void testInvalidInput();
+    void testRoundTrip();
+
+    void benchmarkFromString();
+    void benchmarkToString();
+
+private:
+    ScreenSpace createScreenSpace(QRandomGenerator& random) const;
+    TabletArea  createTabletArea(QRandomGenerator& random) const;
+    ScreenMap   createScreenMap(QRandomGenerator& random, QList<ScreenSpace>& screens) const;
+};
+
+QTEST_MAIN(TestScreenMap)
+
+void TestScreenMap::testFromString()
+{
+    ScreenMap map(QLatin1String("HDMI-1:0 0 100 200| desktop : 10 20 30 40 |areax1x2x3x4:1 2 3 4"));
+
+    QCOMPARE(map.getMapping(ScreenSpace(QLatin1String("HDMI-1"))), TabletArea(QRect(0, 0, 100, 200)));
+    QCOMPARE(map.getMapping(ScreenSpace::desktop()), TabletArea(QRect(10, 20, 20, 20)));
+    QCOMPARE(map.getMapping(ScreenSpace::area(QRect(1, 2, 3, 4))), TabletArea(QRect(1, 2, 2, 2)));
+
+    // parsing the same string again must give the same result
+    ScreenMap cached(QLatin1String("HDMI-1:0 0 100 200| desktop : 10 20 30 40 |areax1x2x3x4:1 2 3 4"));
+    QCOMPARE(cached.toString(), map.toString());
+}
+
+void TestScreenMap::testEmptyArea()
+{
+    TabletArea geometry(QRect(0, 0, 1000, 500));
+    TabletArea other(QRect(0, 0, 2000, 1000));
+    QString    mapping = QLatin1String("desktop:0 0 0 0");
+
+    // empty areas are replaced by the geometry of each map, even if the parse result is cached
+    ScreenMap map(geometry);
+    map.fromString(mapping);
+
+    ScreenMap otherMap(other);
+    otherMap.fromString(mapping);
+
+    QCOMPARE(map.getMapping(ScreenSpace::desktop()), geometry);
+    QCOMPARE(otherMap.getMapping(ScreenSpace::desktop()), other);
+}
+
+void TestScreenMap::testInvalidInput()
+{
+    const QStringList inputs = {
+        QString(),
+        QLatin1String("|"),
+        QLatin1String(":"),
+        QLatin1String("::|::"),
+        QLatin1String("desktop"),
+        QLatin1String("desktop:1 2 3"),
+        QLatin1String("desktop:a b c d"),
+        QLatin1String("desktop:1 2 3 4:5"),
+        QLatin1String("areaxxx:1 2 3 4"),
+        QLatin1String("areax1x2x3x4x5:1 2 3 4")
+    };
+
+    foreach (const QString& input, inputs) {
+        ScreenMap map(input);
+        ScreenMap copy(map.toString());
+        QCOMPARE(copy.toString(), map.toString());
+    }
+
+    // random garbage must not crash the parser
+    QRandomGenerator random(42);
+    const QString    alphabet = QLatin1String("0123456789 :|xdesktoparea-");
+
+    for (int i = 0 ; i < 1000 ; ++i) {
+        QString input;
+        int     length = random.bounded(64);
+
+        for (int j = 0 ; j < length ; ++j) {
+            input.append(alphabet.at(random.bounded(alphabet.size())));
+        }
+
+        ScreenMap map(input);
+        map.toString();
+    }
+}
+
+void TestScreenMap::testRoundTrip()
+{
+    QRandomGenerator random(4711);
+
+    for (int i = 0 ; i < 500 ; ++i) {
+        QList<ScreenSpace> screens;
+        ScreenMap          map    = createScreenMap(random, screens);
+        ScreenMap          parsed(map.toString());
+
+        foreach (const ScreenSpace& screen, screens) {
+            QCOMPARE(parsed.getMapping(screen), map.getMapping(screen));
+        }
+
+        ScreenMap reparsed(parsed.toString());
+
+        foreach (const ScreenSpace& screen, screens) {
+            QCOMPARE(reparsed.getMapping(screen), map.getMapping(screen));
+        }
+    }
+}
+
+void TestScreenMap::benchmarkFromString()
+{
+    QRandomGenerator   random(1);
+    QList<ScreenSpace> screens;
+    QString            mapping = createScreenMap(random, screens).toString();
+
+    QBENCHMARK {
+        ScreenMap map;
+        map.fromString(mapping);
+    }
+}
+
+void TestScreenMap::benchmarkToString()
+{
+    QRandomGenerator   random(1);
+    QList<ScreenSpace> screens;
+    ScreenMap          map = createScreenMap(random, screens);
+
+    QBENCHMARK {
+        map.toString();
+    }
+}
+
+ScreenSpace TestScreenMap::createScreenSpace(QRandomGenerator& random) const
+{
+    switch (random.bounded(3)) {
+        case 0:
+            return ScreenSpace::desktop();
+        case 1:
+            return ScreenSpace::monitor(QString::fromLatin1("DP-%1").arg(random.bounded(10)));
+        default:
+            return ScreenSpace::area(QRect(random.bounded(4000), random.bounded(4000),
+                                           1 + random.bounded(4000), 1 + random.bounded(4000)));
+    }
+}
+
+TabletArea TestScreenMap::createTabletArea(QRandomGenerator& random) const
+{
+    return TabletArea(QRect(random.bounded(10000), random.bounded(10000),
+                            1 + random.bounded(10000), 1 + random.bounded(10000)));
+}
+
+ScreenMap TestScreenMap::createScreenMap(QRandomGenerator& random, QList<ScreenSpace>& screens) const
+{
+    ScreenMap map(createTabletArea(random));
+    int       count = 1 + random.bounded(8);
+
+    for (int i = 0 ; i < count ; ++i) {
+        ScreenSpace screen = createScreenSpace(random);
+        map.setMapping(screen, createTabletArea(random));
+        screens.append(screen);
+    }
+
+    return map;
+}
+
+#include "testscreenmap.moc"
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/screentopology.h"
+
+#include <QGuiApplication>
+#include <QtTest>
+
+using namespace Wacom;
+
+
+/**
+ * @file testscreentopology.cpp
+ *
+ * @test UnitTest for the screen topology snapshot
+ */
+class TestScreenTopology : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty();
+    void testOutputs();
+    void testMatrices();
+    void testCurrent();
+
+private:
+    ScreenTopology createTopology(quint64 generation = 0) const;
+};
+
+QTEST_MAIN(TestScreenTopology)
+
+ScreenTopology TestScreenTopology::createTopology(quint64 generation) const
+{
+    ScreenTopology::Output left;
+    left.name     = QLatin1String("HDMI-1");
+    left.geometry = QRect(0, 0, 1000, 800);
+
+    ScreenTopology::Output right;
+    right.name     = QLatin1String("DP-2");
+    right.geometry = QRect(1000, 200, 1000, 600);
+    right.rotation = ScreenRotation::CW;
+
+    return ScreenTopology({ left, right }, left.name, generation);
+}
+
+void TestScreenTopology::testEmpty()
+{
+    ScreenTopology topology;
+
+    QCOMPARE(topology.outputCount(), 0);
+    QVERIFY(topology.desktopGeometry().isEmpty());
+    QVERIFY(topology.desktopMatrix().isIdentity());
+    QVERIFY(topology.areaMatrix(QRect(0, 0, 10, 10)).isIdentity());
+    QVERIFY(topology.outputRotation(QLatin1String("HDMI-1")) == ScreenRotation::NONE);
+}
+
+void TestScreenTopology::testOutputs()
+{
+    ScreenTopology topology = createTopology(3);
+
+    QCOMPARE(topology.generation(), quint64(3));
+    QCOMPARE(topology.outputCount(), 2);
+    QCOMPARE(topology.outputNames(), QStringList({ QLatin1String("DP-2"), QLatin1String("HDMI-1") }));
+    QCOMPARE(topology.primaryOutput(), QLatin1String("HDMI-1"));
+    QCOMPARE(topology.desktopGeometry(), QRect(0, 0, 2000, 800));
+
+    QVERIFY(topology.hasOutput(QLatin1String("DP-2")));
+    QVERIFY(!topology.hasOutput(QLatin1String("VGA-1")));
+    QCOMPARE(topology.outputGeometry(QLatin1String("DP-2")), QRect(1000, 200, 1000, 600));
+    QCOMPARE(topology.outputGeometry(QLatin1String("VGA-1")), QRect());
+    QVERIFY(topology.outputRotation(QLatin1String("DP-2")) == ScreenRotation::CW);
+    QVERIFY(topology.outputRotation(QLatin1String("HDMI-1")) == ScreenRotation::NONE);
+
+    // copies share the snapshot
+    ScreenTopology copy = topology;
+    QCOMPARE(copy.generation(), topology.generation());
+    QCOMPARE(copy.desktopGeometry(), topology.desktopGeometry());
+}
+
+void TestScreenTopology::testMatrices()
+{
+    ScreenTopology topology = createTopology();
+    bool           found    = false;
+
+    QVERIFY(topology.desktopMatrix().isIdentity());
+
+    QTransform matrix = topology.outputMatrix(QLatin1String("DP-2"), &found);
+    QVERIFY(found);
+    QCOMPARE(matrix.m11(), 0.5);
+    QCOMPARE(matrix.m22(), 0.75);
+    QCOMPARE(matrix.dx(), 0.5);
+    QCOMPARE(matrix.dy(), 0.25);
+    QCOMPARE(matrix.m12(), 0.0);
+    QCOMPARE(matrix.m21(), 0.0);
+
+    // unknown outputs are mapped to the whole desktop
+    matrix = topology.outputMatrix(QLatin1String("VGA-1"), &found);
+    QVERIFY(!found);
+    QVERIFY(matrix.isIdentity());
+
+    QVERIFY(topology.areaMatrix(QRect(0, 0, 1000, 800)) == topology.outputMatrix(QLatin1String("HDMI-1")));
+}
+
+void TestScreenTopology::testCurrent()
+{
+    // the snapshot is only rebuilt if a screen changes
+    ScreenTopology first  = ScreenTopology::current();
+    ScreenTopology second = ScreenTopology::current();
+
+    QVERIFY(first.generation() > 0);
+    QCOMPARE(second.generation(), first.generation());
+    QCOMPARE(second.outputCount(), QGuiApplication::screens().count());
+}
+
+#include "testscreentopology.moc"
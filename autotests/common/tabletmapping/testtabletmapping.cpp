@@ -0,0 +1,122 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/tabletmapping.h"
+
+#include <QtTest>
+
+using namespace Wacom;
+
+
+/**
+ * @file testtabletmapping.cpp
+ *
+ * @test UnitTest for the tablet mapping matrix calculation
+ */
+class TestTabletMapping : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testOutput();
+    void testRotation();
+    void testLetterbox();
+    void testPropertyValues();
+
+private:
+    void comparePoint(const QTransform& matrix, const QPointF& device, const QPointF& expected) const;
+};
+
+QTEST_MAIN(TestTabletMapping)
+
+void TestTabletMapping::comparePoint(const QTransform& matrix, const QPointF& device, const QPointF& expected) const
+{
+    QPointF mapped = matrix.map(device);
+
+    QVERIFY2(qAbs(mapped.x() - expected.x()) < 1e-9 && qAbs(mapped.y() - expected.y()) < 1e-9,
+             qPrintable(QString::fromLatin1("(%1, %2) != (%3, %4)").arg(mapped.x()).arg(mapped.y()).arg(expected.x()).arg(expected.y())));
+}
+
+void TestTabletMapping::testOutput()
+{
+    QRect desktop(0, 0, 2000, 1000);
+
+    QVERIFY(TabletMapping::calculateMatrix(desktop, desktop).isIdentity());
+    QVERIFY(TabletMapping::calculateMatrix(QRect(), desktop).isIdentity());
+
+    // the right half of the desktop
+    QTransform matrix = TabletMapping::calculateMatrix(desktop, QRect(1000, 0, 1000, 1000));
+
+    comparePoint(matrix, QPointF(0, 0), QPointF(0.5, 0));
+    comparePoint(matrix, QPointF(1, 1), QPointF(1, 1));
+    comparePoint(matrix, QPointF(0.5, 0.5), QPointF(0.75, 0.5));
+}
+
+void TestTabletMapping::testRotation()
+{
+    QRect desktop(0, 0, 2000, 1000);
+    QRect output(1000, 0, 1000, 1000);
+
+    // the upper left corner of the tablet ends up in the corner the rotation moves it to
+    QTransform matrix = TabletMapping::calculateMatrix(desktop, output, ScreenRotation::CW);
+    comparePoint(matrix, QPointF(0, 0), QPointF(1, 0));
+    comparePoint(matrix, QPointF(1, 0), QPointF(1, 1));
+
+    matrix = TabletMapping::calculateMatrix(desktop, output, ScreenRotation::CCW);
+    comparePoint(matrix, QPointF(0, 0), QPointF(0.5, 1));
+    comparePoint(matrix, QPointF(1, 0), QPointF(0.5, 0));
+
+    matrix = TabletMapping::calculateMatrix(desktop, output, ScreenRotation::HALF);
+    comparePoint(matrix, QPointF(0, 0), QPointF(1, 1));
+    comparePoint(matrix, QPointF(1, 1), QPointF(0.5, 0));
+
+    // auto modes are no real rotations
+    QVERIFY(TabletMapping::calculateMatrix(desktop, output, ScreenRotation::AUTO) == TabletMapping::calculateMatrix(desktop, output));
+}
+
+void TestTabletMapping::testLetterbox()
+{
+    QRectF target(0, 0, 1600, 900);
+
+    // a 4:3 tablet on a 16:9 screen gets bars on the left and right
+    QCOMPARE(TabletMapping::letterbox(target, 4.0 / 3.0), QRectF(200, 0, 1200, 900));
+
+    // a 2:1 tablet gets bars at the top and the bottom
+    QCOMPARE(TabletMapping::letterbox(target, 2.0), QRectF(0, 50, 1600, 800));
+
+    // no aspect ratio, no letterboxing
+    QCOMPARE(TabletMapping::letterbox(target, 0), target);
+
+    QTransform matrix = TabletMapping::calculateMatrix(QRect(0, 0, 1600, 900), target.toRect(), ScreenRotation::NONE, 4.0 / 3.0);
+    comparePoint(matrix, QPointF(0, 0), QPointF(0.125, 0));
+    comparePoint(matrix, QPointF(1, 1), QPointF(0.875, 1));
+}
+
+void TestTabletMapping::testPropertyValues()
+{
+    QTransform   matrix = TabletMapping::calculateMatrix(QRect(0, 0, 2000, 1000), QRect(1000, 0, 1000, 1000), ScreenRotation::CW);
+    QList<float> values = TabletMapping::toPropertyValues(matrix);
+
+    QCOMPARE(values.size(), 9);
+    QCOMPARE(values, QList<float>({ 0.0f, -0.5f, 1.0f,
+                                    1.0f,  0.0f, 0.0f,
+                                    0.0f,  0.0f, 1.0f }));
+}
+
+#include "testtabletmapping.moc"
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kcmodule/areaselectionwidget.h"
+
+#include <QtTest>
+
+#include <QMouseEvent>
+
+using namespace Wacom;
+
+/**
+ * @file testareaselection.cpp
+ *
+ * @test UnitTest for the area selection widget
+ */
+class TestAreaSelection: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testMouseMoveWithoutDrag();
+    void testDragSelectedArea();
+    void benchmarkDrag();
+
+private:
+    void sendMouseEvent(QEvent::Type type, const QPoint& position, Qt::MouseButtons buttons);
+
+    AreaSelectionWidget* m_widget = nullptr;
+};
+
+QTEST_MAIN(TestAreaSelection)
+
+
+
+void TestAreaSelection::init()
+{
+    // a large multi monitor layout
+    QMap<QString, QRect> areas;
+    areas.insert(QLatin1String("DP-1"),     QRect(0, 0, 2560, 1440));
+    areas.insert(QLatin1String("DP-2"),     QRect(2560, 0, 3840, 2160));
+    areas.insert(QLatin1String("HDMI-1"),   QRect(6400, 0, 1920, 1080));
+
+    m_widget = new AreaSelectionWidget();
+    m_widget->setOutOfBoundsMargin(.1);
+    m_widget->setWidgetTargetSize(QSize(400, 400));
+    m_widget->setAreas(areas, areas.keys());
+}
+
+
+
+void TestAreaSelection::cleanup()
+{
+    delete m_widget;
+    m_widget = nullptr;
+}
+
+
+
+void TestAreaSelection::testMouseMoveWithoutDrag()
+{
+    const QRect selection = m_widget->getSelection();
+
+    sendMouseEvent(QEvent::MouseMove, m_widget->rect().center(), Qt::NoButton);
+    sendMouseEvent(QEvent::MouseMove, m_widget->rect().center() + QPoint(20, 5), Qt::NoButton);
+
+    QCOMPARE(m_widget->getSelection(), selection);
+}
+
+
+
+void TestAreaSelection::testDragSelectedArea()
+{
+    QSignalSpy spy(m_widget, &AreaSelectionWidget::selectionChanged);
+
+    const QRect  selection = m_widget->getSelection();
+    const QPoint start     = m_widget->rect().center();
+
+    sendMouseEvent(QEvent::MouseButtonPress, start, Qt::LeftButton);
+    sendMouseEvent(QEvent::MouseMove, start + QPoint(10, 0), Qt::LeftButton);
+
+    // the selection moves, but keeps its size
+    QVERIFY(m_widget->getSelection().x() > selection.x());
+    QCOMPARE(m_widget->getSelection().y(), selection.y());
+    QCOMPARE(m_widget->getSelection().size(), selection.size());
+    QCOMPARE(spy.count(), 0);
+
+    sendMouseEvent(QEvent::MouseButtonRelease, start + QPoint(10, 0), Qt::NoButton);
+    QCOMPARE(spy.count(), 1);
+}
+
+
+
+void TestAreaSelection::benchmarkDrag()
+{
+    m_widget->show();
+
+    if (!QTest::qWaitForWindowExposed(m_widget)) {
+        QSKIP("The widget can not be shown on this platform.");
+    }
+
+    const QPoint start = m_widget->rect().center();
+
+    m_widget->setSelection(QRect(2560, 0, 3840, 2160), false);
+    sendMouseEvent(QEvent::MouseButtonPress, start, Qt::LeftButton);
+
+    // move the selection back and forth and paint every step
+    QBENCHMARK {
+        for (int step = 1 ; step <= 40 ; ++step) {
+            const int offset = (step <= 20) ? step : 40 - step;
+            sendMouseEvent(QEvent::MouseMove, start + QPoint(offset, offset / 2), Qt::LeftButton);
+            QCoreApplication::processEvents();
+        }
+    }
+
+    sendMouseEvent(QEvent::MouseButtonRelease, start, Qt::NoButton);
+}
+
+
+
+void TestAreaSelection::sendMouseEvent(QEvent::Type type, const QPoint& position, Qt::MouseButtons buttons)
+{
+    const Qt::MouseButton button = (type == QEvent::MouseMove) ? Qt::NoButton : Qt::LeftButton;
+
+    QMouseEvent event(type, QPointF(position), m_widget->mapToGlobal(QPointF(position)), button, buttons, Qt::NoModifier);
+    QCoreApplication::sendEvent(m_widget, &event);
+}
+
+
+
+#include "testareaselection.moc"
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kcmodule/pressurecurvewidget.h"
+
+#include <QtTest>
+
+#include <QImage>
+#include <QPointingDevice>
+#include <QTabletEvent>
+
+using namespace Wacom;
+
+/**
+ * @file testpressurecurvewidget.cpp
+ *
+ * @test UnitTest for the pressure curve widget
+ */
+class TestPressureCurveWidget: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testCurveCache();
+    void testMergeTabletEvents();
+    void testPenLiftedBeforeUpdate();
+
+private:
+    bool isCurvePixel(const QPoint& position) const;
+
+    void sendTabletEvent(QEvent::Type type, const QPointF& position, qreal pressure);
+
+    PressureCurveWidget* m_widget = nullptr;
+};
+
+QTEST_MAIN(TestPressureCurveWidget)
+
+
+
+void TestPressureCurveWidget::init()
+{
+    // a linear curve from the lower left to the upper right corner
+    m_widget = new PressureCurveWidget();
+    m_widget->resize(100, 100);
+    m_widget->setControlPoints(0, 0, 100, 100);
+}
+
+
+
+void TestPressureCurveWidget::cleanup()
+{
+    delete m_widget;
+    m_widget = nullptr;
+}
+
+
+
+void TestPressureCurveWidget::testCurveCache()
+{
+    QVERIFY(isCurvePixel(QPoint(55, 45)));
+
+    // the cached curve follows the control points
+    m_widget->setControlPoints(0, 75, 25, 100);
+    QVERIFY(!isCurvePixel(QPoint(55, 45)));
+
+    // and the size of the widget
+    m_widget->setControlPoints(0, 0, 100, 100);
+    m_widget->resize(200, 200);
+    QVERIFY(isCurvePixel(QPoint(110, 90)));
+}
+
+
+
+void TestPressureCurveWidget::testMergeTabletEvents()
+{
+    QSignalSpy spy(m_widget, &PressureCurveWidget::controlPointsChanged);
+
+    // grab the control point in the lower left corner and drag it around
+    sendTabletEvent(QEvent::TabletPress, QPointF(2, 98), 0.5);
+
+    for (int step = 1 ; step <= 10 ; ++step) {
+        sendTabletEvent(QEvent::TabletMove, QPointF(2 + step * 4, 98 - step * 4), 0.5);
+    }
+
+    QCOMPARE(spy.count(), 0);
+
+    // the burst of events results in one move to the latest position
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(spy.last().at(0).toString(), QLatin1String("42 42 58 58"));
+
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 1);
+}
+
+
+
+void TestPressureCurveWidget::testPenLiftedBeforeUpdate()
+{
+    QSignalSpy spy(m_widget, &PressureCurveWidget::controlPointsChanged);
+
+    sendTabletEvent(QEvent::TabletPress, QPointF(2, 98), 0.5);
+    sendTabletEvent(QEvent::TabletMove, QPointF(22, 78), 0.5);
+    sendTabletEvent(QEvent::TabletRelease, QPointF(22, 78), 0);
+
+    // the last move is applied even though the pen was lifted before the next update
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.last().at(0).toString(), QLatin1String("22 22 78 78"));
+
+    QTest::qWait(50);
+    QCOMPARE(spy.count(), 1);
+}
+
+
+
+bool TestPressureCurveWidget::isCurvePixel(const QPoint& position) const
+{
+    const QImage image = m_widget->grab().toImage();
+
+    return (qGray(image.pixel(position)) < 128);
+}
+
+
+
+void TestPressureCurveWidget::sendTabletEvent(QEvent::Type type, const QPointF& position, qreal pressure)
+{
+    const Qt::MouseButtons buttons = (type == QEvent::TabletRelease) ? Qt::NoButton : Qt::LeftButton;
+
+    QTabletEvent event(type, QPointingDevice::primaryPointingDevice(), position, m_widget->mapToGlobal(position),
+                       pressure, 0, 0, 0, 0, 0, Qt::NoModifier, Qt::LeftButton, buttons);
+    QCoreApplication::sendEvent(m_widget, &event);
+}
+
+
+
+#include "testpressurecurvewidget.moc"
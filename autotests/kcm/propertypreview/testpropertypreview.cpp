@@ -0,0 +1,229 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kcmodule/propertypreview.h"
+
+#include <QtTest>
+
+#include <QList>
+#include <QPair>
+
+using namespace Wacom;
+
+/**
+ * A property preview which does not talk to the daemon but records
+ * every value it would have sent to a device.
+ */
+class PropertyPreviewRecorder : public PropertyPreview
+{
+public:
+    PropertyPreviewRecorder(const QStringList& deviceTypes) : PropertyPreview(QLatin1String("TestTablet"), deviceTypes) {}
+
+    QMap<QString, QVariantMap>           deviceValues; //!< The values each device currently has.
+    QList<QPair<QString, QVariantMap> >  sent;         //!< Every value set which was sent to a device.
+
+protected:
+    QVariantMap readProperties(const QString& deviceType, const QStringList& properties) override
+    {
+        QVariantMap result;
+
+        if (!deviceValues.contains(deviceType)) {
+            return result;
+        }
+
+        foreach (const QString& property, properties) {
+            result.insert(property, deviceValues.value(deviceType).value(property));
+        }
+
+        return result;
+    }
+
+    void writeProperties(const QString& deviceType, const QVariantMap& values) override
+    {
+        sent.append(qMakePair(deviceType, values));
+
+        for (auto value = values.constBegin() ; value != values.constEnd() ; ++value) {
+            deviceValues[deviceType].insert(value.key(), value.value());
+        }
+    }
+};
+
+
+/**
+ * @file testpropertypreview.cpp
+ *
+ * @test UnitTest for the rate limited property preview
+ */
+class TestPropertyPreview: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testCoalescing();
+    void testMissingDevice();
+    void testRateLimit();
+    void testRevert();
+    void testRevertTwice();
+
+private:
+    QVariantMap areaValues(const QString& area) const;
+
+    PropertyPreviewRecorder* m_preview = nullptr;
+};
+
+QTEST_MAIN(TestPropertyPreview)
+
+
+
+void TestPropertyPreview::init()
+{
+    m_preview = new PropertyPreviewRecorder(QStringList() << QLatin1String("stylus") << QLatin1String("eraser"));
+    m_preview->deviceValues[QLatin1String("stylus")] = areaValues(QLatin1String("0 0 100 100"));
+    m_preview->deviceValues[QLatin1String("eraser")] = areaValues(QLatin1String("0 0 100 100"));
+    m_preview->readOriginalValues(QStringList() << QLatin1String("Area"));
+}
+
+
+
+void TestPropertyPreview::cleanup()
+{
+    delete m_preview;
+    m_preview = nullptr;
+}
+
+
+
+void TestPropertyPreview::testCoalescing()
+{
+    m_preview->setInterval(50);
+
+    // the first preview is sent right away to both devices
+    m_preview->preview(areaValues(QLatin1String("1 1 50 50")));
+
+    QCOMPARE(m_preview->sent.size(), 2);
+    QVERIFY(m_preview->isActive());
+
+    // everything after that is pending until the interval elapsed
+    m_preview->preview(areaValues(QLatin1String("2 2 50 50")));
+    m_preview->preview(areaValues(QLatin1String("3 3 50 50")));
+
+    QCOMPARE(m_preview->sent.size(), 2);
+
+    // only the latest value is sent
+    QTRY_COMPARE(m_preview->sent.size(), 4);
+    QCOMPARE(m_preview->sent.at(2).second, areaValues(QLatin1String("3 3 50 50")));
+    QCOMPARE(m_preview->sent.at(3).second, areaValues(QLatin1String("3 3 50 50")));
+}
+
+
+
+void TestPropertyPreview::testMissingDevice()
+{
+    // the eraser reports no value, so it is previewed but can not be restored
+    m_preview->deviceValues.remove(QLatin1String("eraser"));
+    m_preview->readOriginalValues(QStringList() << QLatin1String("Area"));
+
+    m_preview->preview(areaValues(QLatin1String("1 1 50 50")));
+    m_preview->revert();
+
+    QCOMPARE(m_preview->sent.size(), 3);
+    QCOMPARE(m_preview->sent.at(0).first, QLatin1String("stylus"));
+    QCOMPARE(m_preview->sent.at(1).first, QLatin1String("eraser"));
+    QCOMPARE(m_preview->sent.at(2).first, QLatin1String("stylus"));
+    QCOMPARE(m_preview->sent.at(2).second, areaValues(QLatin1String("0 0 100 100")));
+}
+
+
+
+void TestPropertyPreview::testRateLimit()
+{
+    m_preview->setInterval(50);
+
+    QCOMPARE(m_preview->getInterval(), 50);
+
+    m_preview->preview(areaValues(QLatin1String("1 1 50 50")));
+    m_preview->preview(areaValues(QLatin1String("2 2 50 50")));
+
+    QCOMPARE(m_preview->sent.size(), 2);
+
+    // the pending value is sent once the interval elapsed
+    QTRY_COMPARE(m_preview->sent.size(), 4);
+    QCOMPARE(m_preview->sent.last().second, areaValues(QLatin1String("2 2 50 50")));
+
+    // nothing is sent if nothing is pending
+    QTest::qWait(100);
+    QCOMPARE(m_preview->sent.size(), 4);
+}
+
+
+
+void TestPropertyPreview::testRevert()
+{
+    m_preview->setInterval(60000);
+
+    m_preview->preview(areaValues(QLatin1String("1 1 50 50")));
+    m_preview->preview(areaValues(QLatin1String("2 2 50 50")));
+    m_preview->revert();
+
+    QVERIFY(!m_preview->isActive());
+
+    // the pending value is dropped and the original value restored
+    QCOMPARE(m_preview->sent.size(), 4);
+    QCOMPARE(m_preview->deviceValues.value(QLatin1String("stylus")), areaValues(QLatin1String("0 0 100 100")));
+    QCOMPARE(m_preview->deviceValues.value(QLatin1String("eraser")), areaValues(QLatin1String("0 0 100 100")));
+}
+
+
+
+void TestPropertyPreview::testRevertTwice()
+{
+    // nothing has to be restored if nothing was previewed
+    m_preview->revert();
+    QVERIFY(m_preview->sent.isEmpty());
+
+    // the original values are kept, so a later preview can be reverted again
+    m_preview->preview(areaValues(QLatin1String("1 1 50 50")));
+    m_preview->revert();
+    m_preview->revert();
+
+    QCOMPARE(m_preview->sent.size(), 4);
+
+    m_preview->preview(areaValues(QLatin1String("2 2 50 50")));
+    m_preview->revert();
+
+    QCOMPARE(m_preview->sent.size(), 8);
+    QCOMPARE(m_preview->deviceValues.value(QLatin1String("stylus")), areaValues(QLatin1String("0 0 100 100")));
+}
+
+
+
+QVariantMap TestPropertyPreview::areaValues(const QString& area) const
+{
+    QVariantMap values;
+    values.insert(QLatin1String("Area"), area);
+
+    return values;
+}
+
+
+
+#include "testpropertypreview.moc"
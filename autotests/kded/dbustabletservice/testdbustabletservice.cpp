@@ -23,6 +23,7 @@
 
 #include "common/dbustabletinterface.h"
 #include "common/tabletinformation.h"
+#include "common/tabletsnapshot.h"
 
 #include <QtTest>
 
@@ -55,6 +56,11 @@ private slots:
     void testOnTabletRemoved();
     void testSetProfile();
     void testSetProperty();
+    void testSetProperties();
+    void testGetTabletSnapshot();
+    void testStateChanged();
+    void testPropertiesChanged();
+    void testDevicePropertiesChanged();
 
     //! Run once after all tests.
     void cleanupTestCase();
@@ -166,6 +172,7 @@ void TestDBusTabletService::initTestCase()
 
     // connect tablet handler to tablet service
     connect(&m_tabletHandlerMock, &TabletHandlerMock::profileChanged, m_tabletService, &DBusTabletService::onProfileChanged);
+    connect(&m_tabletHandlerMock, &TabletHandlerMock::propertyChanged, m_tabletService, &DBusTabletService::onPropertyChanged);
     connect(&m_tabletHandlerMock, &TabletHandlerMock::tabletAdded,    m_tabletService, &DBusTabletService::onTabletAdded);
     connect(&m_tabletHandlerMock, &TabletHandlerMock::tabletRemoved,  m_tabletService, &DBusTabletService::onTabletRemoved);
 }
@@ -312,4 +319,198 @@ void TestDBusTabletService::testSetProperty()
 
 
 
+void TestDBusTabletService::testSetProperties()
+{
+    QVariantMap values;
+    values.insert(Property::Mode.key(),  QLatin1String("absolute"));
+    values.insert(Property::Touch.key(), QLatin1String("off"));
+    values.insert(QLatin1String("NoSuchProperty"), QLatin1String("invalid"));
+
+    // set all properties at once
+    DBusTabletInterface::instance().setProperties(QLatin1String("TabletId"), DeviceType::Touch.key(), values);
+
+    QCOMPARE(m_tabletHandlerMock.m_deviceType, DeviceType::Touch.key());
+    QCOMPARE(m_tabletHandlerMock.m_properties.size(), 2);
+    QCOMPARE(m_tabletHandlerMock.m_properties.value(Property::Mode.key()), QLatin1String("absolute"));
+    QCOMPARE(m_tabletHandlerMock.m_properties.value(Property::Touch.key()), QLatin1String("off"));
+
+    // read one of them back, invalid properties are skipped
+    m_tabletHandlerMock.m_property      = Property::Touch.key();
+    m_tabletHandlerMock.m_propertyValue = QLatin1String("off");
+
+    QStringList properties;
+    properties << Property::Touch.key() << QLatin1String("NoSuchProperty");
+
+    QDBusReply<QVariantMap> actualValues = DBusTabletInterface::instance().getProperties(QLatin1String("TabletId"), DeviceType::Touch.key(), properties);
+    QVERIFY(actualValues.isValid());
+    QCOMPARE(actualValues.value().size(), 1);
+    QCOMPARE(actualValues.value().value(Property::Touch.key()).toString(), QLatin1String("off"));
+}
+
+
+
+void TestDBusTabletService::testGetTabletSnapshot()
+{
+    TabletInformation expectedInformation;
+
+    foreach(const TabletInfo& tabletInfo, TabletInfo::list()) {
+        expectedInformation.set(tabletInfo, tabletInfo.key());
+    }
+
+    // unknown tablets do not have a snapshot
+    QDBusReply<QVariantMap> reply = DBusTabletInterface::instance().getTabletSnapshot(QLatin1String("TabletId"));
+    QVERIFY(reply.isValid());
+    QVERIFY(!TabletSnapshot(reply.value()).isValid());
+
+    m_tabletHandlerMock.emitTabletAdded(expectedInformation);
+    m_tabletHandlerMock.emitProfileChanged(QLatin1String("TabletId"), QLatin1String("Snapshot Profile"));
+    m_tabletHandlerMock.m_rotationList = QStringList() << QLatin1String("Snapshot Profile");
+
+    reply = DBusTabletInterface::instance().getTabletSnapshot(QLatin1String("TabletId"));
+    QVERIFY(reply.isValid());
+
+    TabletSnapshot snapshot(reply.value());
+    QVERIFY(snapshot.isValid());
+
+    foreach(const TabletInfo& info, TabletInfo::list()) {
+        QCOMPARE(snapshot.getInformation(info), expectedInformation.get(info));
+    }
+
+    QCOMPARE(snapshot.getDeviceList(), expectedInformation.getDeviceList());
+    QCOMPARE(snapshot.hasPadButtons(), expectedInformation.hasButtons());
+    QCOMPARE(snapshot.getProfile(), QLatin1String("Snapshot Profile"));
+    QCOMPARE(snapshot.getProfileList(), m_tabletHandlerMock.m_profiles);
+    QCOMPARE(snapshot.getProfileRotationList(), m_tabletHandlerMock.m_rotationList);
+
+    m_tabletHandlerMock.emitTabletRemoved(QLatin1String("TabletId"));
+}
+
+
+
+void TestDBusTabletService::testStateChanged()
+{
+    TabletInformation information;
+    information.set(TabletInfo::TabletId, QLatin1String("TabletId"));
+
+    m_tabletHandlerMock.emitTabletAdded(information);
+
+    QSignalSpy spy(m_tabletService, &DBusTabletService::stateChanged);
+
+    QDBusReply<QVariantMap> reply = DBusTabletInterface::instance().getTabletSnapshot(QLatin1String("TabletId"));
+    QVERIFY(reply.isValid());
+    const uint version = TabletSnapshot(reply.value()).getStateVersion();
+
+    // a property which is part of the snapshot publishes a delta
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Mode.key(), QLatin1String("relative"));
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toString(), QLatin1String("TabletId"));
+    QCOMPARE(spy.at(0).at(1).toUInt(), version + 1);
+
+    TabletSnapshot delta(spy.at(0).at(2).toMap());
+    QCOMPARE(delta.getStateVersion(), version + 1);
+    QCOMPARE(delta.getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("relative"));
+    QVERIFY(!delta.hasProfile());
+
+    // all other properties and unchanged values are not published
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Button1.key(), QLatin1String("1"));
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Mode.key(), QLatin1String("relative"));
+    QVERIFY(!spy.wait(200));
+    QCOMPARE(spy.count(), 1);
+
+    // all changes of one event loop turn are published as one version
+    m_tabletHandlerMock.emitProfileChanged(QLatin1String("TabletId"), QLatin1String("Delta Profile"));
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Mode.key(), QLatin1String("absolute"));
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(1).toUInt(), version + 2);
+    QCOMPARE(TabletSnapshot(spy.at(1).at(2).toMap()).getProfile(), QLatin1String("Delta Profile"));
+    QCOMPARE(TabletSnapshot(spy.at(1).at(2).toMap()).getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+
+    // merging the deltas into the old snapshot gives the current snapshot
+    TabletSnapshot mirror(reply.value());
+    mirror.merge(TabletSnapshot(spy.at(0).at(2).toMap()));
+    mirror.merge(TabletSnapshot(spy.at(1).at(2).toMap()));
+
+    reply = DBusTabletInterface::instance().getTabletSnapshot(QLatin1String("TabletId"));
+    QVERIFY(reply.isValid());
+
+    TabletSnapshot current(reply.value());
+    QCOMPARE(mirror.getStateVersion(), current.getStateVersion());
+    QCOMPARE(mirror.getProfile(), current.getProfile());
+
+    // a snapshot publishes pending changes first, so other clients do not miss them
+    m_tabletHandlerMock.emitProfileChanged(QLatin1String("TabletId"), QLatin1String("Snapshot Profile"));
+    current = TabletSnapshot(m_tabletService->getTabletSnapshot(QLatin1String("TabletId")));
+
+    QCOMPARE(spy.count(), 3);
+    QCOMPARE(spy.at(2).at(1).toUInt(), version + 3);
+    QCOMPARE(TabletSnapshot(spy.at(2).at(2).toMap()).getProfile(), QLatin1String("Snapshot Profile"));
+    QCOMPARE(current.getStateVersion(), version + 3);
+    QVERIFY(!spy.wait(200));
+
+    m_tabletHandlerMock.emitTabletRemoved(QLatin1String("TabletId"));
+}
+
+
+
+void TestDBusTabletService::testPropertiesChanged()
+{
+    QSignalSpy spy(m_tabletService, &DBusTabletService::propertiesChanged);
+
+    // several writes are published as one signal once the window elapsed
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Mode.key(), QLatin1String("absolute"));
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Button1.key(), QLatin1String("1"));
+    DBusTabletInterface::instance().setProperty(QLatin1String("TabletId"), DeviceType::Stylus.key(), Property::Mode.key(), QLatin1String("relative"));
+    QCOMPARE(spy.count(), 0);
+
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toString(), QLatin1String("TabletId"));
+    QCOMPARE(spy.at(0).at(1).toString(), DeviceType::Stylus.key());
+
+    QMap<QString,QString> expectedValues;
+    expectedValues.insert(Property::Mode.key(),    QLatin1String("relative"));
+    expectedValues.insert(Property::Button1.key(), QLatin1String("1"));
+
+    QCOMPARE(spy.at(0).at(2).value< QMap<QString,QString> >(), expectedValues);
+
+    // nothing else is pending
+    QVERIFY(!spy.wait(200));
+}
+
+
+
+void TestDBusTabletService::testDevicePropertiesChanged()
+{
+    TabletInformation information;
+    information.set(TabletInfo::TabletId, QLatin1String("TabletId"));
+
+    m_tabletHandlerMock.emitTabletAdded(information);
+    m_tabletHandlerMock.setProperty(QLatin1String("TabletId"), DeviceType::Touch, Property::Touch, QLatin1String("off"));
+
+    QSignalSpy spy(m_tabletService, &DBusTabletService::stateChanged);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+
+    // an external change publishes the current values of the device
+    m_tabletHandlerMock.m_propertyValue = QLatin1String("on");
+    m_tabletService->onDevicePropertiesChanged(QLatin1String("TabletId"), DeviceType::Touch);
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(TabletSnapshot(spy.at(1).at(2).toMap()).getProperty(DeviceType::Touch, Property::Touch), QLatin1String("on"));
+
+    // unchanged values, devices without snapshot properties and unknown tablets publish nothing
+    m_tabletService->onDevicePropertiesChanged(QLatin1String("TabletId"), DeviceType::Touch);
+    m_tabletService->onDevicePropertiesChanged(QLatin1String("TabletId"), DeviceType::Pad);
+    m_tabletService->onDevicePropertiesChanged(QLatin1String("UnknownTablet"), DeviceType::Touch);
+    QVERIFY(!spy.wait(200));
+    QCOMPARE(spy.count(), 2);
+
+    m_tabletHandlerMock.emitTabletRemoved(QLatin1String("TabletId"));
+}
+
+
+
 #include "testdbustabletservice.moc"
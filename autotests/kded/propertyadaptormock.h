@@ -23,6 +23,7 @@
 #include "propertyadaptor.h"
 
 #include <QMap>
+#include <QStringList>
 
 namespace Wacom
 {
@@ -53,11 +54,12 @@ public:
 
     bool setProperty(const Wacom::Property& property, const QString& value) override
     {
-        if (!supportsProperty(property)) {
+        if (!supportsProperty(property) || m_failingProperties.contains(property.key())) {
             return false;
         }
 
         m_properties.insert(property.key(), value);
+        m_setProperties.append(property.key());
         return true;
     }
 
@@ -68,6 +70,8 @@ public:
 
 
     QMap<QString,QString> m_properties;
+    QStringList           m_setProperties;      //!< The keys of all properties which were set, in the order they were set.
+    QStringList           m_failingProperties;  //!< The keys of properties which can not be set.
 };
 }
 #endif
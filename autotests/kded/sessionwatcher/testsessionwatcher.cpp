@@ -0,0 +1,220 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kded/sessionwatcher.h"
+
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QSignalSpy>
+#include <QtTest>
+
+using namespace Wacom;
+
+/**
+ * A stand-in for the logind manager which is registered on the session bus.
+ */
+class FakeLogindManager : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.login1.Manager")
+
+public Q_SLOTS:
+    QDBusObjectPath GetSession(const QString& sessionId)
+    {
+        if (sessionId != QLatin1String("31")) {
+            sendErrorReply(QLatin1String("org.freedesktop.login1.NoSuchSession"), QLatin1String("No session found."));
+            return QDBusObjectPath();
+        }
+
+        return QDBusObjectPath(QLatin1String("/org/freedesktop/login1/session/_31"));
+    }
+
+Q_SIGNALS:
+    void PrepareForSleep(bool start);
+};
+
+
+/**
+ * @file testsessionwatcher.cpp
+ *
+ * @test UnitTest for the session watcher using a local logind stand-in
+ */
+class TestSessionWatcher: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testSleep();
+    void testSessionSwitch();
+    void testSleepWhileInactive();
+    void testUnknownSession();
+
+private:
+    void setSessionActive(bool active, const QString& interface = QLatin1String("org.freedesktop.login1.Session"));
+
+    static const QString SERVICE;
+
+    FakeLogindManager m_manager;
+};
+
+const QString TestSessionWatcher::SERVICE = QLatin1String("org.kde.wacomtablet.test.login1");
+
+QTEST_MAIN(TestSessionWatcher)
+
+
+
+void TestSessionWatcher::initTestCase()
+{
+    QDBusConnection connection = QDBusConnection::sessionBus();
+
+    if (!connection.isConnected()) {
+        QSKIP("No D-Bus session bus available.");
+    }
+
+    // the watcher looks up the session by its id
+    qputenv("XDG_SESSION_ID", "31");
+
+    QVERIFY(connection.registerService(SERVICE));
+    QVERIFY(connection.registerObject(QLatin1String("/org/freedesktop/login1"), &m_manager, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals));
+}
+
+
+void TestSessionWatcher::cleanupTestCase()
+{
+    QDBusConnection connection = QDBusConnection::sessionBus();
+
+    connection.unregisterObject(QLatin1String("/org/freedesktop/login1"));
+    connection.unregisterService(SERVICE);
+}
+
+
+
+void TestSessionWatcher::setSessionActive(bool active, const QString& interface)
+{
+    QDBusMessage message = QDBusMessage::createSignal(QLatin1String("/org/freedesktop/login1/session/_31"),
+                                                      QLatin1String("org.freedesktop.DBus.Properties"),
+                                                      QLatin1String("PropertiesChanged"));
+
+    QVariantMap changedProperties;
+    changedProperties.insert(QLatin1String("Active"), active);
+
+    message << interface << changedProperties << QStringList();
+
+    QVERIFY(QDBusConnection::sessionBus().send(message));
+}
+
+
+
+void TestSessionWatcher::testSleep()
+{
+    SessionWatcher watcher(QDBusConnection::sessionBus(), SERVICE);
+    QSignalSpy     pausedSpy(&watcher, SIGNAL(sessionPaused()));
+    QSignalSpy     resumedSpy(&watcher, SIGNAL(sessionResumed()));
+
+    QVERIFY(watcher.start());
+
+    emit m_manager.PrepareForSleep(true);
+    QTRY_COMPARE(pausedSpy.count(), 1);
+    QCOMPARE(resumedSpy.count(), 0);
+
+    emit m_manager.PrepareForSleep(false);
+    QTRY_COMPARE(resumedSpy.count(), 1);
+    QCOMPARE(pausedSpy.count(), 1);
+}
+
+
+
+void TestSessionWatcher::testSessionSwitch()
+{
+    SessionWatcher watcher(QDBusConnection::sessionBus(), SERVICE);
+    QSignalSpy     pausedSpy(&watcher, SIGNAL(sessionPaused()));
+    QSignalSpy     resumedSpy(&watcher, SIGNAL(sessionResumed()));
+
+    QVERIFY(watcher.start());
+    QTRY_COMPARE(watcher.getSessionPath(), QLatin1String("/org/freedesktop/login1/session/_31"));
+
+    setSessionActive(false);
+    QTRY_COMPARE(pausedSpy.count(), 1);
+
+    // changes of other interfaces are ignored
+    setSessionActive(true, QLatin1String("org.freedesktop.login1.User"));
+    QTest::qWait(100);
+    QCOMPARE(resumedSpy.count(), 0);
+
+    setSessionActive(true);
+    QTRY_COMPARE(resumedSpy.count(), 1);
+    QCOMPARE(pausedSpy.count(), 1);
+}
+
+
+
+void TestSessionWatcher::testSleepWhileInactive()
+{
+    SessionWatcher watcher(QDBusConnection::sessionBus(), SERVICE);
+    QSignalSpy     pausedSpy(&watcher, SIGNAL(sessionPaused()));
+    QSignalSpy     resumedSpy(&watcher, SIGNAL(sessionResumed()));
+
+    QVERIFY(watcher.start());
+    QTRY_COMPARE(watcher.getSessionPath(), QLatin1String("/org/freedesktop/login1/session/_31"));
+
+    setSessionActive(false);
+    QTRY_COMPARE(pausedSpy.count(), 1);
+
+    emit m_manager.PrepareForSleep(true);
+    emit m_manager.PrepareForSleep(false);
+    QTest::qWait(100);
+
+    // the session is still inactive
+    QCOMPARE(pausedSpy.count(), 1);
+    QCOMPARE(resumedSpy.count(), 0);
+
+    setSessionActive(true);
+    QTRY_COMPARE(resumedSpy.count(), 1);
+}
+
+
+
+void TestSessionWatcher::testUnknownSession()
+{
+    qputenv("XDG_SESSION_ID", "42");
+
+    SessionWatcher watcher(QDBusConnection::sessionBus(), SERVICE);
+    QSignalSpy     pausedSpy(&watcher, SIGNAL(sessionPaused()));
+
+    // suspend is still watched without a session
+    QVERIFY(watcher.start());
+    QTest::qWait(100);
+    QVERIFY(watcher.getSessionPath().isEmpty());
+
+    setSessionActive(false);
+    QTest::qWait(100);
+    QCOMPARE(pausedSpy.count(), 0);
+
+    emit m_manager.PrepareForSleep(true);
+    QTRY_COMPARE(pausedSpy.count(), 1);
+
+    qputenv("XDG_SESSION_ID", "31");
+}
+
+#include "testsessionwatcher.moc"
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kded/procsystemadaptor.h"
+#include "kded/sysfsledwriter.h"
+#include "common/property.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace Wacom;
+
+/**
+ * @file testsysfsledwriter.cpp
+ *
+ * @test UnitTest for the sysfs LED writer using a fake sysfs tree
+ */
+class TestSysfsLedWriter: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testLegacyLeds();
+    void testLedClass();
+    void testOtherDeviceUntouched();
+    void testInvalidValues();
+    void testMissingDevice();
+    void testProcSystemAdaptor();
+
+private:
+    /**
+     * Creates a HID device with an event device below it and links
+     * it in class/input like the kernel does.
+     */
+    QString createDevice(const QString& hidName, const QString& eventName);
+
+    void createFile(const QString& path, const QString& content = QString());
+    QString readFile(const QString& path) const;
+
+    QTemporaryDir* m_sysfs;
+};
+
+QTEST_MAIN(TestSysfsLedWriter)
+
+void TestSysfsLedWriter::init()
+{
+    m_sysfs = new QTemporaryDir();
+    QVERIFY(m_sysfs->isValid());
+    QVERIFY(QDir(m_sysfs->path()).mkpath(QLatin1String("class/input")));
+}
+
+
+void TestSysfsLedWriter::cleanup()
+{
+    delete m_sysfs;
+    m_sysfs = nullptr;
+}
+
+
+void TestSysfsLedWriter::testLegacyLeds()
+{
+    QString device = createDevice(QLatin1String("0003:056A:00B9.0001"), QLatin1String("event5"));
+
+    createFile(device + QLatin1String("/wacom_led/status_led0_select"));
+    createFile(device + QLatin1String("/wacom_led/status_led1_select"));
+    createFile(device + QLatin1String("/wacom_led/status0_luminance"));
+    createFile(device + QLatin1String("/wacom_led/status1_luminance"));
+
+    SysfsLedWriter writer(QLatin1String("/dev/input/event5"), m_sysfs->path());
+
+    QVERIFY(writer.isAvailable());
+    QCOMPARE(writer.getDeviceDirectory(), QFileInfo(device).canonicalFilePath());
+
+    QVERIFY(writer.setStatusLED(2));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status_led0_select")), QLatin1String("2"));
+
+    QVERIFY(writer.setStatusLED(5));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status_led1_select")), QLatin1String("1"));
+
+    QVERIFY(writer.setStatusLEDBrightness(32));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status0_luminance")), QLatin1String("32"));
+
+    QVERIFY(writer.setStatusLEDBrightness(200));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status1_luminance")), QLatin1String("72"));
+}
+
+
+void TestSysfsLedWriter::testLedClass()
+{
+    QString device = createDevice(QLatin1String("0003:056A:0357.0002"), QLatin1String("event7"));
+
+    for (int led = 0 ; led < 4 ; ++led) {
+        QString ledPath = QString::fromLatin1("%1/leds/0003:056A:0357.0002::wacom-0.%2").arg(device).arg(led);
+        createFile(ledPath + QLatin1String("/brightness"), QLatin1String("0"));
+        createFile(ledPath + QLatin1String("/max_brightness"), QLatin1String("127"));
+    }
+
+    SysfsLedWriter writer(QLatin1String("/dev/input/event7"), m_sysfs->path());
+
+    QVERIFY(writer.isAvailable());
+
+    QVERIFY(writer.setStatusLED(3));
+    QCOMPARE(readFile(device + QLatin1String("/leds/0003:056A:0357.0002::wacom-0.3/brightness")), QLatin1String("127"));
+    QCOMPARE(readFile(device + QLatin1String("/leds/0003:056A:0357.0002::wacom-0.0/brightness")), QLatin1String("0"));
+
+    // the second group does not exist on this device
+    QVERIFY(!writer.setStatusLED(4));
+
+    // there is no luminance using the LED class interface
+    QVERIFY(!writer.setStatusLEDBrightness(32));
+}
+
+
+void TestSysfsLedWriter::testOtherDeviceUntouched()
+{
+    QString device = createDevice(QLatin1String("0003:056A:00B9.0001"), QLatin1String("event5"));
+    QString other  = createDevice(QLatin1String("0003:056A:00BA.0002"), QLatin1String("event9"));
+
+    createFile(device + QLatin1String("/wacom_led/status_led0_select"), QLatin1String("0"));
+    createFile(other  + QLatin1String("/wacom_led/status_led0_select"), QLatin1String("0"));
+
+    SysfsLedWriter writer(QLatin1String("/dev/input/event9"), m_sysfs->path());
+
+    QVERIFY(writer.setStatusLED(1));
+    QCOMPARE(readFile(other  + QLatin1String("/wacom_led/status_led0_select")), QLatin1String("1"));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status_led0_select")), QLatin1String("0"));
+}
+
+
+void TestSysfsLedWriter::testInvalidValues()
+{
+    QString device = createDevice(QLatin1String("0003:056A:00B9.0001"), QLatin1String("event5"));
+
+    createFile(device + QLatin1String("/wacom_led/status_led0_select"), QLatin1String("0"));
+    createFile(device + QLatin1String("/wacom_led/status0_luminance"), QLatin1String("0"));
+
+    SysfsLedWriter writer(QLatin1String("/dev/input/event5"), m_sysfs->path());
+
+    QVERIFY(!writer.setStatusLED(-1));
+    QVERIFY(!writer.setStatusLED(8));
+    QVERIFY(!writer.setStatusLEDBrightness(-1));
+    QVERIFY(!writer.setStatusLEDBrightness(256));
+
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status_led0_select")), QLatin1String("0"));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status0_luminance")), QLatin1String("0"));
+}
+
+
+void TestSysfsLedWriter::testMissingDevice()
+{
+    createDevice(QLatin1String("0003:056A:00B9.0001"), QLatin1String("event5"));
+
+    SysfsLedWriter noLeds(QLatin1String("/dev/input/event5"), m_sysfs->path());
+    QVERIFY(!noLeds.isAvailable());
+    QVERIFY(!noLeds.setStatusLED(0));
+
+    SysfsLedWriter unknown(QLatin1String("/dev/input/event42"), m_sysfs->path());
+    QVERIFY(!unknown.isAvailable());
+    QVERIFY(unknown.getDeviceDirectory().isEmpty());
+
+    SysfsLedWriter empty(QString(), m_sysfs->path());
+    QVERIFY(!empty.isAvailable());
+}
+
+
+void TestSysfsLedWriter::testProcSystemAdaptor()
+{
+    QString device = createDevice(QLatin1String("0003:056A:00B9.0001"), QLatin1String("event5"));
+
+    createFile(device + QLatin1String("/wacom_led/status_led0_select"));
+    createFile(device + QLatin1String("/wacom_led/status1_luminance"));
+
+    ProcSystemAdaptor adaptor(QLatin1String("Pad"), QLatin1String("/dev/input/event5"), m_sysfs->path());
+
+    QVERIFY(adaptor.setProperty(Property::StatusLEDs, QLatin1String("3")));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status_led0_select")), QLatin1String("3"));
+
+    QVERIFY(adaptor.setProperty(Property::StatusLEDsBrightness, QLatin1String("255")));
+    QCOMPARE(readFile(device + QLatin1String("/wacom_led/status1_luminance")), QLatin1String("127"));
+
+    QVERIFY(!adaptor.setProperty(Property::StatusLEDs, QLatin1String("invalid")));
+}
+
+
+QString TestSysfsLedWriter::createDevice(const QString& hidName, const QString& eventName)
+{
+    QDir    root(m_sysfs->path());
+    QString device    = QString::fromLatin1("devices/pci0000:00/usb1/1-1/1-1:1.0/%1").arg(hidName);
+    QString eventPath = QString::fromLatin1("%1/input/input%2/%3").arg(device).arg(eventName.mid(5)).arg(eventName);
+
+    if (!root.mkpath(eventPath)) {
+        return QString();
+    }
+
+    QFile::link(root.absoluteFilePath(eventPath), root.absoluteFilePath(QLatin1String("class/input/") + eventName));
+
+    return root.absoluteFilePath(device);
+}
+
+
+void TestSysfsLedWriter::createFile(const QString& path, const QString& content)
+{
+    QVERIFY(QDir().mkpath(QFileInfo(path).absolutePath()));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content.toLatin1());
+}
+
+
+QString TestSysfsLedWriter::readFile(const QString& path) const
+{
+    QFile file(path);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    return QString::fromLatin1(file.readAll().trimmed());
+}
+
+#include "testsysfsledwriter.moc"
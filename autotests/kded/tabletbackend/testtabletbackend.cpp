@@ -48,6 +48,10 @@ private slots:
     void testSetDeviceProfile();
     void testSetProfile();
     void testSetProperty();
+    void testFingerprint();
+    void testRemapDevice();
+    void testLetterbox();
+    void testPropertyCache();
     void cleanupTestCase();
 
 private:
@@ -236,6 +240,192 @@ void TestTabletBackend::testSetProperty()
 
 
 
+void TestTabletBackend::testFingerprint()
+{
+    // cleanup
+    m_stylusXinputAdaptor->m_properties.clear();
+    m_stylusXsetwacomAdaptor->m_properties.clear();
+
+    // nothing was captured yet
+    QCOMPARE(m_tabletBackend->restoreFingerprint(), -1);
+
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Rotate, QLatin1String("none")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Area, QLatin1String("0 0 1000 1000")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::PressureCurve, QLatin1String("0 0 100 100")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::ScreenSpace, QLatin1String("desktop")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Mode, QLatin1String("absolute")));
+
+    // nothing was lost
+    m_tabletBackend->captureFingerprint();
+    QCOMPARE(m_tabletBackend->restoreFingerprint(), 0);
+
+    // a fingerprint is only used once
+    QCOMPARE(m_tabletBackend->restoreFingerprint(), -1);
+
+    m_tabletBackend->captureFingerprint();
+
+    // the X server resets some properties
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Area.key(), QLatin1String("0 0 31496 19685"));
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Rotate.key(), QLatin1String("half"));
+    m_stylusXinputAdaptor->m_properties.insert(Property::ScreenSpace.key(), QLatin1String("1 0 0 0 1 0 0 0 1"));
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Mode.key(), QLatin1String("relative"));
+    m_stylusXsetwacomAdaptor->m_setProperties.clear();
+
+    // only lost properties of the fingerprint are restored, the rotation before the area
+    QCOMPARE(m_tabletBackend->restoreFingerprint(), 3);
+    QCOMPARE(m_stylusXsetwacomAdaptor->m_setProperties, QStringList() << Property::Rotate.key() << Property::Area.key());
+
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Rotate), QLatin1String("none"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 1000 1000"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::ScreenSpace), QLatin1String("desktop"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::PressureCurve), QLatin1String("0 0 100 100"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("relative"));
+
+    // a property which can not be restored makes the caller apply everything again
+    m_tabletBackend->captureFingerprint();
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::PressureCurve.key(), QLatin1String("0 10 90 100"));
+    m_stylusXsetwacomAdaptor->m_failingProperties.append(Property::PressureCurve.key());
+
+    QCOMPARE(m_tabletBackend->restoreFingerprint(), -1);
+
+    m_stylusXsetwacomAdaptor->m_failingProperties.clear();
+}
+
+
+
+void TestTabletBackend::testRemapDevice()
+{
+    // cleanup
+    m_stylusXinputAdaptor->m_properties.clear();
+    m_stylusXsetwacomAdaptor->m_properties.clear();
+
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("relative"), QLatin1String("0 0 500 500"), QLatin1String("HDMI-1")));
+
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("relative"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 500 500"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::ScreenSpace), QLatin1String("HDMI-1"));
+
+    // unchanged values are not set again
+    m_stylusXinputAdaptor->m_properties.clear();
+    m_stylusXsetwacomAdaptor->m_properties.clear();
+
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("relative"), QLatin1String("0 0 500 500"), QLatin1String("HDMI-1")));
+    QVERIFY(m_stylusXinputAdaptor->m_properties.isEmpty());
+    QVERIFY(m_stylusXsetwacomAdaptor->m_properties.isEmpty());
+
+    // only the mode changed
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("absolute"), QLatin1String("0 0 500 500"), QLatin1String("HDMI-1")));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+    QVERIFY(!m_stylusXsetwacomAdaptor->m_properties.contains(Property::Area.key()));
+    QVERIFY(m_stylusXinputAdaptor->m_properties.isEmpty());
+
+    // the screen space depends on the area
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("absolute"), QLatin1String("0 0 800 500"), QLatin1String("HDMI-1")));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 800 500"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::ScreenSpace), QLatin1String("HDMI-1"));
+
+    // a value set by other means is set again
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Mode, QLatin1String("relative")));
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("absolute"), QLatin1String("0 0 800 500"), QLatin1String("HDMI-1")));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+
+    // values changed outside of the backend are set again
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Mode.key(), QLatin1String("relative"));
+    m_tabletBackend->invalidateProperties(DeviceType::Stylus);
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QLatin1String("absolute"), QLatin1String("0 0 800 500"), QLatin1String("HDMI-1")));
+    QCOMPARE(m_stylusXsetwacomAdaptor->m_properties.value(Property::Mode.key()), QLatin1String("absolute"));
+
+    // empty values are not set
+    m_stylusXinputAdaptor->m_properties.clear();
+    m_stylusXsetwacomAdaptor->m_properties.clear();
+    m_tabletBackend->invalidateProperties(DeviceType::Stylus);
+
+    QVERIFY(m_tabletBackend->remapDevice(DeviceType::Stylus, QString(), QString(), QString()));
+    QVERIFY(m_stylusXinputAdaptor->m_properties.isEmpty());
+    QVERIFY(m_stylusXsetwacomAdaptor->m_properties.isEmpty());
+
+    // unsupported devices can not be remapped
+    QVERIFY(!m_tabletBackend->remapDevice(DeviceType::Touch, QLatin1String("absolute"), QLatin1String("0 0 800 500"), QLatin1String("HDMI-1")));
+}
+
+
+
+void TestTabletBackend::testLetterbox()
+{
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::ScreenSpace, QLatin1String("HDMI-1")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::KeepAspectRatio, QLatin1String("false")));
+
+    // without a letterbox the screen space does not depend on the area
+    m_stylusXinputAdaptor->m_setProperties.clear();
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Area, QLatin1String("0 0 600 500")));
+    QVERIFY(m_stylusXinputAdaptor->m_setProperties.isEmpty());
+
+    // a letterboxed screen space follows the area and the rotation
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::KeepAspectRatio, QLatin1String("true")));
+    m_stylusXinputAdaptor->m_setProperties.clear();
+
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Area, QLatin1String("0 0 800 500")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Rotate, QLatin1String("cw")));
+    QCOMPARE(m_stylusXinputAdaptor->m_setProperties, QStringList() << Property::ScreenSpace.key() << Property::ScreenSpace.key());
+    QCOMPARE(m_stylusXinputAdaptor->m_properties.value(Property::ScreenSpace.key()), QLatin1String("HDMI-1"));
+
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::KeepAspectRatio, QLatin1String("false")));
+}
+
+
+
+void TestTabletBackend::testPropertyCache()
+{
+    // cleanup
+    m_stylusXinputAdaptor->m_properties.clear();
+    m_stylusXsetwacomAdaptor->m_properties.clear();
+    m_tabletBackend->invalidateProperties(DeviceType::Unknown);
+
+    // values are read from the device only once
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Mode.key(), QLatin1String("absolute"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Mode.key(), QLatin1String("relative"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+
+    // values which were set are cached as well
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Area, QLatin1String("0 0 1000 1000")));
+    m_stylusXsetwacomAdaptor->m_properties.remove(Property::Area.key());
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 1000 1000"));
+
+    // invalidating a different device keeps the values
+    m_tabletBackend->invalidateProperties(DeviceType::Eraser);
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+
+    // invalidated values are read from the device again
+    m_tabletBackend->invalidateProperties(DeviceType::Stylus);
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("relative"));
+    QVERIFY(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area).isEmpty());
+
+    // the area is read from the device again after the driver reset it on rotation
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Area, QLatin1String("0 0 1000 1000")));
+    QVERIFY(m_tabletBackend->setProperty(DeviceType::Stylus, Property::Rotate, QLatin1String("half")));
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Area.key(), QLatin1String("0 0 2000 2000"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 2000 2000"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Rotate), QLatin1String("half"));
+
+    // changes of someone else drop only the values of the changed properties
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Rotate.key(), QLatin1String("cw"));
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Area.key(), QLatin1String("0 0 1000 1000"));
+    m_tabletBackend->invalidateProperties(DeviceType::Stylus, QList<Property>() << Property::Rotate);
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Rotate), QLatin1String("cw"));
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Area), QLatin1String("0 0 2000 2000"));
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Area.key(), QLatin1String("0 0 2000 2000"));
+
+    // a verified cache always returns the device value
+    m_stylusXsetwacomAdaptor->m_properties.insert(Property::Mode.key(), QLatin1String("absolute"));
+    m_tabletBackend->setPropertyCacheVerified(true);
+    QCOMPARE(m_tabletBackend->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("absolute"));
+    m_tabletBackend->setPropertyCacheVerified(false);
+}
+
+
+
 void TestTabletBackend::cleanupTestCase()
 {
     delete m_tabletBackend;
@@ -111,3 +111,46 @@ bool TabletBackendMock::setProperty(const DeviceType& type, const Property& prop
 }
 
 
+bool TabletBackendMock::remapDevice(const DeviceType& type, const QString& mode, const QString& area, const QString& screenSpace)
+{
+    ++m_deviceRemaps;
+
+    bool isRemapped = setProperty(type, Property::Mode, mode);
+    isRemapped = setProperty(type, Property::Area, area) && isRemapped;
+    isRemapped = setProperty(type, Property::ScreenSpace, screenSpace) && isRemapped;
+
+    return isRemapped;
+}
+
+
+void TabletBackendMock::invalidateProperties(const DeviceType& type)
+{
+    m_invalidatedDevices.append(type.key());
+}
+
+
+void TabletBackendMock::invalidateProperties(const DeviceType& type, const QList<Property>& properties)
+{
+    foreach (const Property& property, properties) {
+        m_invalidatedProperties.append(type.key() + QLatin1Char('/') + property.key());
+    }
+}
+
+
+void TabletBackendMock::setPropertyCacheVerified(bool verify)
+{
+    m_isCacheVerified = verify;
+}
+
+
+void TabletBackendMock::captureFingerprint()
+{
+    ++m_fingerprintCaptures;
+}
+
+
+int TabletBackendMock::restoreFingerprint()
+{
+    ++m_fingerprintRestores;
+    return m_restoredProperties;
+}
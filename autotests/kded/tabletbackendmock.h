@@ -27,6 +27,7 @@
 
 #include <QMap>
 #include <QString>
+#include <QStringList>
 
 namespace Wacom
 {
@@ -54,6 +55,18 @@ public:
 
     bool setProperty(const DeviceType& type, const Property& property, const QString& value) override;
 
+    bool remapDevice(const DeviceType& type, const QString& mode, const QString& area, const QString& screenSpace) override;
+
+    void invalidateProperties(const DeviceType& type) override;
+
+    void invalidateProperties(const DeviceType& type, const QList<Property>& properties) override;
+
+    void setPropertyCacheVerified(bool verify) override;
+
+    void captureFingerprint() override;
+
+    int restoreFingerprint() override;
+
 
     QString           m_propertyAdaptorType; //!< The device type of the property adaptor.
     PropertyAdaptor*  m_propertyAdaptor;     //!< The property adaptor which was set by addAdaptor()
@@ -66,6 +79,16 @@ public:
 
     QMap<QString, PropertyAdaptorMock<DeviceProperty>* > m_properties; //!< Properties which were set.
 
+    int               m_deviceRemaps        = 0;   //!< Number of times remapDevice() was called.
+
+    QStringList       m_invalidatedDevices;            //!< The device types passed to invalidateProperties()
+    QStringList       m_invalidatedProperties;         //!< The device types and property keys passed to invalidateProperties()
+    bool              m_isCacheVerified     = false;   //!< The value passed to setPropertyCacheVerified()
+
+    int               m_fingerprintCaptures = 0;   //!< Number of times captureFingerprint() was called.
+    int               m_fingerprintRestores = 0;   //!< Number of times restoreFingerprint() was called.
+    int               m_restoredProperties  = -1;  //!< The value returned by restoreFingerprint()
+
 }; // CLASS
 }  // NAMESPACE
 #endif // HEADER PROTECTION
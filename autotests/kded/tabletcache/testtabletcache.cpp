@@ -0,0 +1,229 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kded/tabletcache.h"
+#include "common/deviceinformation.h"
+#include "common/deviceprofile.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace Wacom;
+
+/**
+ * @file testtabletcache.cpp
+ *
+ * @test UnitTest for the persistent tablet cache
+ */
+class TestTabletCache: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testClosed();
+    void testTablet();
+    void testProfile();
+    void testBrokenFile();
+
+private:
+    TabletInformation createTablet() const;
+    TabletProfile createProfile(const QString& name) const;
+
+    QTemporaryDir* m_tempDir = nullptr;
+    QString        m_fileName;
+};
+
+QTEST_MAIN(TestTabletCache)
+
+
+
+void TestTabletCache::init()
+{
+    m_tempDir  = new QTemporaryDir;
+    m_fileName = m_tempDir->path() + QLatin1String("/cache/tablets.cache");
+
+    QVERIFY(m_tempDir->isValid());
+}
+
+
+void TestTabletCache::cleanup()
+{
+    TabletCache::instance().close();
+
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+
+
+TabletInformation TestTabletCache::createTablet() const
+{
+    TabletInformation info(0x357);
+
+    info.set(TabletInfo::CompanyId, QLatin1String("056A"));
+    info.set(TabletInfo::TabletName, QLatin1String("Wacom Intuos Pro M"));
+    info.set(TabletInfo::TabletModel, QLatin1String("PTH-660"));
+    info.set(TabletInfo::NumPadButtons, 9);
+    info.set(TabletInfo::HasTouchRing, true);
+
+    QMap<QString, QString> buttonMap;
+    buttonMap.insert(QLatin1String("1"), QLatin1String("2"));
+    buttonMap.insert(QLatin1String("2"), QLatin1String("3"));
+    info.setButtonMap(buttonMap);
+
+    return info;
+}
+
+
+TabletProfile TestTabletCache::createProfile(const QString& name) const
+{
+    TabletProfile profile(name);
+
+    DeviceProfile stylus(DeviceType::Stylus);
+    stylus.setProperty(Property::Mode, QLatin1String("absolute"));
+    stylus.setProperty(Property::PressureCurve, QLatin1String("0 10 90 100"));
+    profile.setDevice(stylus);
+
+    DeviceProfile pad(DeviceType::Pad);
+    pad.setProperty(Property::Button1, QLatin1String("key ctrl z"));
+    profile.setDevice(pad);
+
+    return profile;
+}
+
+
+
+void TestTabletCache::testClosed()
+{
+    TabletCache& cache = TabletCache::instance();
+    TabletInformation info = createTablet();
+    TabletProfile profile;
+
+    QVERIFY(!cache.isOpen());
+
+    // a closed cache never remembers anything
+    QVERIFY(cache.storeTablet(info));
+    QVERIFY(cache.storeProfile(info.getUniqueDeviceId(), createProfile(QLatin1String("Default"))));
+
+    QVERIFY(!cache.lookupTablet(info.getUniqueDeviceId(), info));
+    QVERIFY(!cache.lookupProfile(info.getUniqueDeviceId(), QLatin1String("Default"), profile));
+}
+
+
+
+void TestTabletCache::testTablet()
+{
+    TabletCache& cache = TabletCache::instance();
+    TabletInformation info = createTablet();
+
+    // devices are never cached
+    info.setDevice(DeviceInformation(DeviceType::Stylus, QLatin1String("Wacom Intuos Pro M Pen stylus")));
+
+    cache.open(m_fileName);
+    QVERIFY(cache.isOpen());
+    QVERIFY(cache.storeTablet(info));
+    QVERIFY(!cache.storeTablet(info));
+    cache.close();
+
+    QVERIFY(QFile::exists(m_fileName));
+
+    cache.open(m_fileName);
+
+    TabletInformation cachedInfo;
+    QVERIFY(cache.lookupTablet(QLatin1String("056A:0357"), cachedInfo));
+    QVERIFY(!cache.lookupTablet(QLatin1String("056A:0358"), cachedInfo));
+
+    TabletInformation expectedInfo = createTablet();
+
+    QVERIFY(cachedInfo == expectedInfo);
+    QCOMPARE(cachedInfo.getButtonMap(), expectedInfo.getButtonMap());
+    QVERIFY(!cachedInfo.hasDevice(DeviceType::Stylus));
+
+    // a changed button map is an update
+    QMap<QString, QString> buttonMap = expectedInfo.getButtonMap();
+    buttonMap.insert(QLatin1String("3"), QLatin1String("8"));
+    expectedInfo.setButtonMap(buttonMap);
+
+    QVERIFY(cache.storeTablet(expectedInfo));
+}
+
+
+
+void TestTabletCache::testProfile()
+{
+    TabletCache& cache = TabletCache::instance();
+    const QString uniqueId = createTablet().getUniqueDeviceId();
+
+    cache.open(m_fileName);
+    QVERIFY(cache.storeProfile(uniqueId, createProfile(QLatin1String("Drawing"))));
+    QVERIFY(!cache.storeProfile(uniqueId, createProfile(QLatin1String("Drawing"))));
+    cache.close();
+
+    cache.open(m_fileName);
+
+    TabletProfile profile;
+    QVERIFY(!cache.lookupProfile(uniqueId, QLatin1String("Default"), profile));
+    QVERIFY(cache.lookupProfile(uniqueId, QLatin1String("Drawing"), profile));
+
+    QCOMPARE(profile.getName(), QLatin1String("Drawing"));
+    QVERIFY(profile.hasDevice(DeviceType::Stylus));
+    QVERIFY(profile.hasDevice(DeviceType::Pad));
+    QVERIFY(!profile.hasDevice(DeviceType::Eraser));
+    QCOMPARE(profile.getDevice(DeviceType::Stylus).getProperty(Property::Mode), QLatin1String("absolute"));
+    QCOMPARE(profile.getDevice(DeviceType::Stylus).getProperty(Property::PressureCurve), QLatin1String("0 10 90 100"));
+    QCOMPARE(profile.getDevice(DeviceType::Pad).getProperty(Property::Button1), QLatin1String("key ctrl z"));
+
+    // only the last profile of a tablet is kept
+    QVERIFY(cache.storeProfile(uniqueId, createProfile(QLatin1String("Default"))));
+    QVERIFY(!cache.lookupProfile(uniqueId, QLatin1String("Drawing"), profile));
+    QVERIFY(cache.lookupProfile(uniqueId, QLatin1String("Default"), profile));
+}
+
+
+
+void TestTabletCache::testBrokenFile()
+{
+    TabletCache& cache = TabletCache::instance();
+    TabletInformation info = createTablet();
+
+    QVERIFY(QDir().mkpath(m_tempDir->path() + QLatin1String("/cache")));
+
+    QFile file(m_fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("this is not a tablet cache");
+    file.close();
+
+    // broken files are ignored and replaced
+    cache.open(m_fileName);
+    QVERIFY(cache.isOpen());
+    QVERIFY(!cache.lookupTablet(info.getUniqueDeviceId(), info));
+
+    QVERIFY(cache.storeTablet(createTablet()));
+    cache.close();
+
+    cache.open(m_fileName);
+    QVERIFY(cache.lookupTablet(info.getUniqueDeviceId(), info));
+}
+
+#include "testtabletcache.moc"
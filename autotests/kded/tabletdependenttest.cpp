@@ -18,7 +18,7 @@
  */
 
 #include "tabletdependenttest.h"
-#include "kded/x11tabletfinder.h"
+#include "common/x11tabletfinder.h"
 
 using namespace Wacom;
 
@@ -22,8 +22,15 @@
 
 #include "kded/tablethandler.h"
 #include "kded/tabletbackendfactory.h"
+#include "kded/tabletfinder.h"
+#include "common/tabletdatabase.h"
 #include "common/tabletinformation.h"
 #include "common/screensinfo.h"
+#include "common/screenspace.h"
+#include "common/screentopology.h"
+
+#include <KConfig>
+#include <KConfigGroup>
 
 #include <QtTest>
 
@@ -55,8 +62,11 @@ private slots:
 
 private:
     void testListProfiles();
+    void testOnDevicePropertiesChanged();
     void testOnScreenRotated();
+    void testOnSessionResumed();
     void testOnTabletAdded();
+    void testOnTabletPrepared();
     void testOnTabletRemoved();
     void testOnTogglePenMode();
     void testOnToggleTouch();
@@ -149,6 +159,8 @@ void TestTabletHandler::cleanupTestCase()
 void TestTabletHandler::test()
 {
     // only one test method as the test has to be executed in a specific order
+    testOnTabletPrepared();
+
     testOnTabletAdded();
 
     testSetProperty();
@@ -163,6 +175,10 @@ void TestTabletHandler::test()
 
     testOnScreenRotated();
 
+    testOnSessionResumed();
+
+    testOnDevicePropertiesChanged();
+
     testOnTabletRemoved();
 }
 
@@ -183,6 +199,25 @@ void TestTabletHandler::testListProfiles()
 void TestTabletHandler::testOnScreenRotated()
 {
     m_tabletHandler->onMapToScreen1();
+
+    // a single screen is mapped as the desktop, which is announced only once
+    if (ScreenTopology::current().outputCount() == 1) {
+        QStringList mappedScreens;
+        QMetaObject::Connection connection = connect(m_tabletHandler, &TabletHandler::propertyChanged,
+                                                     [&mappedScreens](const QString&, const DeviceType& deviceType, const Property& property, const QString& value) {
+            if (property == Property::ScreenSpace) {
+                mappedScreens.append(deviceType.key() + QLatin1Char('/') + value);
+            }
+        });
+
+        m_tabletHandler->onMapToScreen1();
+        m_tabletHandler->onScreenGeometryChanged();
+        disconnect(connection);
+
+        QVERIFY(mappedScreens.isEmpty());
+        QCOMPARE(m_tabletHandler->getProperty(QLatin1String("4321"), DeviceType::Stylus, Property::ScreenSpace), ScreenSpace::desktop().toString());
+    }
+
     // reset screen rotation
     m_tabletHandler->setProperty(QLatin1String("4321"), DeviceType::Stylus, Property::Rotate, ScreenRotation::NONE.key());
     m_tabletHandler->setProperty(QLatin1String("4321"), DeviceType::Eraser, Property::Rotate, ScreenRotation::NONE.key());
@@ -196,8 +231,21 @@ void TestTabletHandler::testOnScreenRotated()
     QCOMPARE(m_tabletHandler->getProperty(QLatin1String("4321"), DeviceType::Stylus, Property::Rotate), ScreenRotation::NONE.key());
     QCOMPARE(m_tabletHandler->getProperty(QLatin1String("4321"), DeviceType::Touch, Property::Rotate), ScreenRotation::NONE.key());
 
+    // the new rotation is announced only after it was written
+    QStringList announced;
+    QMetaObject::Connection connection = connect(m_tabletHandler, &TabletHandler::propertyChanged,
+                                                 [this, &announced](const QString&, const DeviceType& deviceType, const Property& property, const QString& value) {
+        if (property == Property::Rotate) {
+            QCOMPARE(m_backendMock->getProperty(deviceType, property), value);
+            announced.append(deviceType.key() + QLatin1Char('/') + value);
+        }
+    });
+
     // rotate screen
     m_tabletHandler->onScreenRotated(ScreensInfo::getPrimaryScreenName(), Qt::InvertedLandscapeOrientation);
+    disconnect(connection);
+
+    QVERIFY(announced.contains(DeviceType::Stylus.key() + QLatin1Char('/') + ScreenRotation::HALF.key()));
 
     // validate result
     QCOMPARE(m_tabletHandler->getProperty(QLatin1String("4321"), DeviceType::Eraser, Property::Rotate), ScreenRotation::HALF.key());
@@ -207,6 +255,74 @@ void TestTabletHandler::testOnScreenRotated()
     QWARN("testOnScreenRotated(): PASSED!");
 }
 
+
+
+void TestTabletHandler::testOnDevicePropertiesChanged()
+{
+    const QStringList deviceProperties = QStringList() << QLatin1String("Coordinate Transformation Matrix")
+                                                       << QLatin1String("Wacom Serial IDs")
+                                                       << QLatin1String("Wacom Tablet Area");
+
+    m_backendMock->m_invalidatedDevices.clear();
+    m_backendMock->m_invalidatedProperties.clear();
+
+    QStringList changedDevices;
+    QMetaObject::Connection connection = connect(m_tabletHandler, &TabletHandler::devicePropertiesChanged,
+                                                 [&changedDevices](const QString &tabletId, const DeviceType& deviceType) {
+        changedDevices.append(tabletId + QLatin1Char('/') + deviceType.key());
+    });
+
+    // echoes of the changes we just made are ignored
+    m_tabletHandler->setProperty(QLatin1String("4321"), DeviceType::Stylus, Property::Mode, QLatin1String("absolute"));
+    m_tabletHandler->onDevicePropertiesChanged(QLatin1String("Stylus Device"), deviceProperties);
+    QVERIFY(m_backendMock->m_invalidatedProperties.isEmpty());
+    QVERIFY(changedDevices.isEmpty());
+
+    QTest::qWait(1000);
+
+    // unknown devices and properties we do not configure are ignored
+    m_tabletHandler->onDevicePropertiesChanged(QLatin1String("Unknown Device"), deviceProperties);
+    m_tabletHandler->onDevicePropertiesChanged(QLatin1String("Stylus Device"), QStringList() << QLatin1String("Wacom Serial IDs"));
+    QVERIFY(m_backendMock->m_invalidatedProperties.isEmpty());
+
+    // only the mapped properties of the device which changed are invalidated
+    m_tabletHandler->onDevicePropertiesChanged(QLatin1String("Stylus Device"), deviceProperties);
+    disconnect(connection);
+
+    QCOMPARE(m_backendMock->m_invalidatedProperties, QStringList() << DeviceType::Stylus.key() + QLatin1String("/") + Property::ScreenSpace.key()
+                                                                   << DeviceType::Stylus.key() + QLatin1String("/") + Property::Area.key());
+    QCOMPARE(changedDevices, QStringList() << QLatin1String("4321/") + DeviceType::Stylus.key());
+    QVERIFY(m_backendMock->m_invalidatedDevices.isEmpty());
+
+    QWARN("testOnDevicePropertiesChanged(): PASSED!");
+}
+
+
+
+void TestTabletHandler::testOnSessionResumed()
+{
+    m_tabletHandler->onSessionPaused();
+
+    QCOMPARE(m_backendMock->m_fingerprintCaptures, 1);
+
+    // lost settings are restored by the backend
+    m_profileChanged.clear();
+    m_backendMock->m_restoredProperties = 2;
+    m_tabletHandler->onSessionResumed();
+
+    QCOMPARE(m_backendMock->m_fingerprintRestores, 1);
+    QVERIFY(m_profileChanged.isEmpty());
+
+    // without a fingerprint the whole profile is applied again
+    m_backendMock->m_restoredProperties = -1;
+    m_tabletHandler->onSessionResumed();
+
+    QCOMPARE(m_backendMock->m_fingerprintRestores, 2);
+    QCOMPARE(m_profileChanged, QLatin1String("test"));
+
+    QWARN("testOnSessionResumed(): PASSED!");
+}
+
 void TestTabletHandler::testOnTabletAdded()
 {
     QVERIFY(!m_tabletAdded);
@@ -291,6 +407,65 @@ void TestTabletHandler::testOnTabletAdded()
 
 
 
+void TestTabletHandler::testOnTabletPrepared()
+{
+    const QString companyFile = QLatin1String("testtablethandler.companylist");
+    TabletDatabase::instance().setDatabase(KdedTestUtils::getAbsoluteDir(companyFile), companyFile);
+
+    // runs the udev path of the tablet finder against a handler with its own copy of the test data
+    auto addPreparedTablet = [](bool isRemovedByUdev) {
+        QTemporaryDir tempDir;
+        const QString profilePath = tempDir.filePath(QLatin1String("testtablethandler.profilesrc"));
+        const QString configPath  = tempDir.filePath(QLatin1String("testtablethandler.configrc"));
+
+        QFile::copy(KdedTestUtils::getAbsolutePath(QLatin1String("testtablethandler.profilesrc")), profilePath);
+        QFile::copy(KdedTestUtils::getAbsolutePath(QLatin1String("testtablethandler.configrc")), configPath);
+
+        TabletHandler     tabletHandler(profilePath, configPath);
+        TabletInformation preparedInfo;
+        QString           profile;
+
+        QObject::connect(&TabletFinder::instance(), &TabletFinder::tabletPrepared, &tabletHandler, &TabletHandler::onTabletPrepared);
+        QObject::connect(&TabletFinder::instance(), &TabletFinder::preparedTabletRemoved, &tabletHandler, &TabletHandler::onPreparedTabletRemoved);
+        QObject::connect(&TabletFinder::instance(), &TabletFinder::tabletPrepared, &tabletHandler, [&preparedInfo](const TabletInformation& info) {
+            preparedInfo = info;
+        });
+        QObject::connect(&tabletHandler, &TabletHandler::profileChanged, &tabletHandler, [&profile](const QString&, const QString& newProfile) {
+            profile = newProfile;
+        });
+
+        TabletFinder::instance().onUdevTabletAdded(0x1234, 0x4321);
+
+        if (isRemovedByUdev) {
+            TabletFinder::instance().onUdevTabletRemoved(0x1234, 0x4321);
+        }
+
+        // the profiles which were read ahead do not know about this change
+        KConfig profiles(profilePath, KConfig::SimpleConfig);
+        KConfigGroup(&profiles, QLatin1String("Bamboo Create")).group(QLatin1String("test")).deleteGroup();
+        profiles.sync();
+
+        TabletBackendFactory::setTabletBackendMock(new TabletBackendMock());
+        tabletHandler.onTabletAdded(preparedInfo);
+
+        if (!isRemovedByUdev) {
+            TabletFinder::instance().onUdevTabletRemoved(0x1234, 0x4321);
+        }
+
+        return profile;
+    };
+
+    // the profiles read ahead are applied without reading them again
+    QCOMPARE(addPreparedTablet(false), QLatin1String("test"));
+
+    // a tablet removed by udev does not keep its profiles read ahead
+    QCOMPARE(addPreparedTablet(true), QLatin1String("default"));
+
+    QWARN("testOnTabletPrepared(): PASSED!");
+}
+
+
+
 void TestTabletHandler::testOnTabletRemoved()
 {
     QVERIFY(!m_tabletRemoved);
@@ -353,8 +528,12 @@ void TestTabletHandler::testOnTogglePenMode()
     QCOMPARE(m_backendMock->getProperty(DeviceType::Eraser, Property::Mode), QLatin1String("Absolute"));
     QCOMPARE(m_backendMock->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("Absolute"));
 
+    int deviceRemaps = m_backendMock->m_deviceRemaps;
+
     m_tabletHandler->onTogglePenMode();
 
+    // stylus and eraser are remapped in one step each
+    QCOMPARE(m_backendMock->m_deviceRemaps, deviceRemaps + 2);
     QCOMPARE(m_backendMock->getProperty(DeviceType::Eraser, Property::Mode), QLatin1String("relative"));
     QCOMPARE(m_backendMock->getProperty(DeviceType::Stylus, Property::Mode), QLatin1String("relative"));
 
@@ -89,10 +89,25 @@ void TabletHandlerMock::setProfile(const QString& tabletId, const QString& profi
 
 void TabletHandlerMock::setProperty(const QString& tabletId, const DeviceType& deviceType, const Property& property, const QString& value)
 {
-    Q_UNUSED(tabletId)
     m_deviceType      = deviceType.key();
     m_property        = property.key();
     m_propertyValue   = value;
+
+    emit propertyChanged(tabletId, deviceType, property, value);
+}
+
+
+void TabletHandlerMock::setProperties(const QString& tabletId, const DeviceProfile& properties)
+{
+    Q_UNUSED(tabletId)
+    m_deviceType = properties.getName();
+    m_properties.clear();
+
+    foreach(const Property& property, properties.getProperties()) {
+        if (!properties.getProperty(property).isEmpty()) {
+            m_properties.insert(property.key(), properties.getProperty(property));
+        }
+    }
 }
 
 
@@ -23,6 +23,7 @@
 #include "tablethandlerinterface.h"
 #include "tabletinformation.h"
 
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QStringList>
@@ -57,9 +58,12 @@ public:
     //! Sets the given profile on the mock and emits a profileChanged signal.
     void setProfile(const QString& tabletId, const QString& profile) override;
 
-    //! Sets the given property value on the mock no matter which device or property is set.
+    //! Sets the given property value on the mock no matter which device or property is set and emits a propertyChanged signal.
     void setProperty(const QString& tabletId, const DeviceType& deviceType, const Property & property, const QString& value) override;
 
+    //! Stores the device type and all properties which were set.
+    void setProperties(const QString& tabletId, const DeviceProfile& properties) override;
+
     //! return mock rotation list
     QStringList getProfileRotationList(const QString& tabletId) override;
 
@@ -71,6 +75,8 @@ Q_SIGNALS:
 
     void profileChanged(const QString &tabletId, const QString& profile);
 
+    void propertyChanged(const QString &tabletId, const Wacom::DeviceType& deviceType, const Wacom::Property& property, const QString& value);
+
     void tabletAdded(const TabletInformation& info);
 
     void tabletRemoved(const QString &tabletId);
@@ -83,6 +89,7 @@ public:
     QStringList m_profiles;        //!< The list of profiles returned by this mock.
     QString     m_profile;         //!< The profile name returned by this mock.
     QStringList m_rotationList;    //!< The mock rotation list (only one not one per device)
+    QHash<QString,QString> m_properties; //!< All property values set by the last call to setProperties().
 
 
 }; // CLASS
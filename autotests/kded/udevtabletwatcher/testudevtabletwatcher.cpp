@@ -0,0 +1,307 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kded/udevtabletwatcher.h"
+
+#include <QSignalSpy>
+#include <QtTest>
+
+using namespace Wacom;
+
+/**
+ * @file testudevtabletwatcher.cpp
+ *
+ * @test UnitTest for the udev tablet watcher replaying a fake udev environment
+ */
+class TestUdevTabletWatcher: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testHotplug();
+    void testBluetoothTablet();
+    void testOtherDevicesIgnored();
+    void testTwoTablets();
+    void testStop();
+
+private:
+    /**
+     * A uevent as it would be received from the udev monitor.
+     */
+    struct FakeUevent
+    {
+        QString                 action;
+        QString                 sysPath;
+        QHash<QString, QString> properties;
+    };
+
+    /**
+     * The uevents of an USB Intuos Pro M (056a:0357) being plugged in.
+     */
+    QList<FakeUevent> intuosAdded() const;
+
+    /**
+     * The uevents of an USB Intuos Pro M (056a:0357) being removed.
+     */
+    QList<FakeUevent> intuosRemoved() const;
+
+    /**
+     * Replays the given uevents and returns the number of tablet events.
+     */
+    int replay(UdevTabletWatcher& watcher, const QList<FakeUevent>& events) const;
+};
+
+QTEST_MAIN(TestUdevTabletWatcher)
+
+
+
+QList<TestUdevTabletWatcher::FakeUevent> TestUdevTabletWatcher::intuosAdded() const
+{
+    const QString hid = QLatin1String("/sys/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/0003:056A:0357.0001");
+
+    QList<FakeUevent> events;
+
+    // the hid device shows up before the driver is bound
+    events.append({QLatin1String("add"), hid, {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("hid")},
+        {QLatin1String("HID_ID"), QLatin1String("0003:0000056A:00000357")}}});
+
+    events.append({QLatin1String("bind"), hid, {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("hid")},
+        {QLatin1String("DRIVER"), QLatin1String("wacom")},
+        {QLatin1String("HID_ID"), QLatin1String("0003:0000056A:00000357")}}});
+
+    events.append({QLatin1String("add"), hid + QLatin1String("/input/input20"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("PRODUCT"), QLatin1String("3/56a/357/110")},
+        {QLatin1String("ID_INPUT"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")}}});
+
+    events.append({QLatin1String("add"), hid + QLatin1String("/input/input20/event20"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("DEVNAME"), QLatin1String("/dev/input/event20")},
+        {QLatin1String("ID_INPUT"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")},
+        {QLatin1String("ID_VENDOR_ID"), QLatin1String("056a")},
+        {QLatin1String("ID_MODEL_ID"), QLatin1String("0357")}}});
+
+    events.append({QLatin1String("add"), hid + QLatin1String("/input/input21"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("PRODUCT"), QLatin1String("3/56a/357/110")},
+        {QLatin1String("ID_INPUT"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET_PAD"), QLatin1String("1")}}});
+
+    events.append({QLatin1String("add"), hid + QLatin1String("/input/input21/event21"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("DEVNAME"), QLatin1String("/dev/input/event21")},
+        {QLatin1String("ID_INPUT"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")},
+        {QLatin1String("ID_INPUT_TABLET_PAD"), QLatin1String("1")},
+        {QLatin1String("ID_VENDOR_ID"), QLatin1String("056a")},
+        {QLatin1String("ID_MODEL_ID"), QLatin1String("0357")}}});
+
+    // udev sends change events for devices it already announced
+    events.append({QLatin1String("change"), hid + QLatin1String("/input/input20/event20"), events.at(3).properties});
+
+    return events;
+}
+
+
+
+QList<TestUdevTabletWatcher::FakeUevent> TestUdevTabletWatcher::intuosRemoved() const
+{
+    QList<FakeUevent> events;
+
+    // remove events are sent children first
+    const QList<FakeUevent> added = intuosAdded();
+
+    for (int i = added.size() - 1 ; i >= 0 ; --i) {
+        if (added.at(i).action != QLatin1String("add")) {
+            continue;
+        }
+
+        events.append({QLatin1String("remove"), added.at(i).sysPath, added.at(i).properties});
+    }
+
+    return events;
+}
+
+
+
+int TestUdevTabletWatcher::replay(UdevTabletWatcher& watcher, const QList<FakeUevent>& events) const
+{
+    int handled = 0;
+
+    foreach (const FakeUevent& event, events) {
+        if (watcher.handleUevent(event.action, event.sysPath, event.properties)) {
+            ++handled;
+        }
+    }
+
+    return handled;
+}
+
+
+
+void TestUdevTabletWatcher::testHotplug()
+{
+    UdevTabletWatcher watcher;
+    QSignalSpy        addedSpy(&watcher, SIGNAL(tabletAdded(int,int)));
+    QSignalSpy        removedSpy(&watcher, SIGNAL(tabletRemoved(int,int)));
+
+    // all but the unbound hid device belong to the tablet
+    QCOMPARE(replay(watcher, intuosAdded()), 6);
+
+    // the tablet is announced once by its first device
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(addedSpy.at(0).at(0).toInt(), 0x056A);
+    QCOMPARE(addedSpy.at(0).at(1).toInt(), 0x0357);
+    QCOMPARE(removedSpy.count(), 0);
+
+    const QList<FakeUevent> removed = intuosRemoved();
+
+    // the tablet is removed with its last device
+    QCOMPARE(replay(watcher, removed.mid(0, removed.size() - 1)), removed.size() - 1);
+    QCOMPARE(removedSpy.count(), 0);
+
+    QCOMPARE(replay(watcher, removed.mid(removed.size() - 1)), 1);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(0).toInt(), 0x056A);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 0x0357);
+
+    // replugging announces the tablet again
+    replay(watcher, intuosAdded());
+    QCOMPARE(addedSpy.count(), 2);
+}
+
+
+
+void TestUdevTabletWatcher::testBluetoothTablet()
+{
+    UdevTabletWatcher watcher;
+    QSignalSpy        addedSpy(&watcher, SIGNAL(tabletAdded(int,int)));
+    QSignalSpy        removedSpy(&watcher, SIGNAL(tabletRemoved(int,int)));
+
+    const QString input = QLatin1String("/sys/devices/virtual/misc/uhid/0005:056A:0377.0003/input/input30");
+
+    // bluetooth devices have no usb vendor and model ids
+    QVERIFY(watcher.handleUevent(QLatin1String("add"), input, {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("PRODUCT"), QLatin1String("5/56a/377/1")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")}}));
+
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(addedSpy.at(0).at(0).toInt(), 0x056A);
+    QCOMPARE(addedSpy.at(0).at(1).toInt(), 0x0377);
+
+    // remove events are matched by path
+    QVERIFY(watcher.handleUevent(QLatin1String("remove"), input, QHash<QString, QString>()));
+    QCOMPARE(removedSpy.count(), 1);
+}
+
+
+
+void TestUdevTabletWatcher::testOtherDevicesIgnored()
+{
+    UdevTabletWatcher watcher;
+    QSignalSpy        addedSpy(&watcher, SIGNAL(tabletAdded(int,int)));
+    QSignalSpy        removedSpy(&watcher, SIGNAL(tabletRemoved(int,int)));
+
+    const QString hid = QLatin1String("/sys/devices/pci0000:00/0000:00:14.0/usb1/1-3/1-3:1.0/0003:046D:C31C.0002");
+
+    // a keyboard
+    QVERIFY(!watcher.handleUevent(QLatin1String("bind"), hid, {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("hid")},
+        {QLatin1String("DRIVER"), QLatin1String("hid-generic")},
+        {QLatin1String("HID_ID"), QLatin1String("0003:0000046D:0000C31C")}}));
+
+    QVERIFY(!watcher.handleUevent(QLatin1String("add"), hid + QLatin1String("/input/input40"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("PRODUCT"), QLatin1String("3/46d/c31c/110")},
+        {QLatin1String("ID_INPUT_KEYBOARD"), QLatin1String("1")}}));
+
+    // garbage from a broken device
+    QVERIFY(!watcher.handleUevent(QLatin1String("add"), hid + QLatin1String("/input/input41"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("input")},
+        {QLatin1String("PRODUCT"), QLatin1String("3/xyz")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")}}));
+
+    // other subsystems
+    QVERIFY(!watcher.handleUevent(QLatin1String("add"), QLatin1String("/sys/devices/virtual/block/loop0"), {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("block")},
+        {QLatin1String("ID_INPUT_TABLET"), QLatin1String("1")}}));
+
+    // removal of unknown devices
+    QVERIFY(!watcher.handleUevent(QLatin1String("remove"), hid, QHash<QString, QString>()));
+
+    QCOMPARE(addedSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 0);
+}
+
+
+
+void TestUdevTabletWatcher::testTwoTablets()
+{
+    UdevTabletWatcher watcher;
+    QSignalSpy        addedSpy(&watcher, SIGNAL(tabletAdded(int,int)));
+    QSignalSpy        removedSpy(&watcher, SIGNAL(tabletRemoved(int,int)));
+
+    const QString cintiq = QLatin1String("/sys/devices/pci0000:00/0000:00:14.0/usb1/1-4/1-4:1.0/0003:056A:0350.0004");
+
+    replay(watcher, intuosAdded());
+
+    QVERIFY(watcher.handleUevent(QLatin1String("bind"), cintiq, {
+        {QLatin1String("SUBSYSTEM"), QLatin1String("hid")},
+        {QLatin1String("DRIVER"), QLatin1String("wacom")},
+        {QLatin1String("HID_ID"), QLatin1String("0003:0000056A:00000350")}}));
+
+    QCOMPARE(addedSpy.count(), 2);
+    QCOMPARE(addedSpy.at(1).at(1).toInt(), 0x0350);
+
+    // removing one tablet does not affect the other one
+    replay(watcher, intuosRemoved());
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 0x0357);
+
+    QVERIFY(watcher.handleUevent(QLatin1String("unbind"), cintiq, QHash<QString, QString>()));
+    QCOMPARE(removedSpy.count(), 2);
+    QCOMPARE(removedSpy.at(1).at(1).toInt(), 0x0350);
+}
+
+
+
+void TestUdevTabletWatcher::testStop()
+{
+    UdevTabletWatcher watcher;
+    QSignalSpy        addedSpy(&watcher, SIGNAL(tabletAdded(int,int)));
+    QSignalSpy        removedSpy(&watcher, SIGNAL(tabletRemoved(int,int)));
+
+    replay(watcher, intuosAdded());
+    watcher.stop();
+
+    // all devices are forgotten
+    QCOMPARE(replay(watcher, intuosRemoved()), 0);
+    QCOMPARE(removedSpy.count(), 0);
+
+    replay(watcher, intuosAdded());
+    QCOMPARE(addedSpy.count(), 2);
+}
+
+#include "testudevtabletwatcher.moc"
@@ -19,19 +19,20 @@
 
 #include "buttonshortcut.h"
 
+#include "globalshortcutindex.h"
+
 #include <QRegularExpression>
 #include <QKeySequence>
 
 #include <KLocalizedString>
-#include <KGlobalAccel>
 
 
 using namespace Wacom;
 
 /*
  * When mapping multiple keys to the same name, the last entry
- * will be the default one. This is because QMap.find() returns
- * the most recently added value as default.
+ * will be the default one. This is because QHash.insert() replaces
+ * the value of an existing key.
  *
  * Example:
  *
@@ -106,6 +107,19 @@ QString buttonNumberToDescription(int buttonNr) {
     }
 }
 
+/*
+ * Appends a key to the sequence with its first character converted to
+ * uppercase and all other characters converted to lowercase.
+ */
+template<typename Key>
+static void appendPrettifiedKey(QString& sequence, const Key& key)
+{
+    for (qsizetype i = 0 ; i < key.size() ; ++i) {
+        const QChar keyChar = key.at(i);
+        sequence.append((i == 0) ? keyChar.toUpper() : keyChar.toLower());
+    }
+}
+
 namespace Wacom {
     class ButtonShortcutPrivate {
         public:
@@ -287,9 +301,9 @@ const QString ButtonShortcut::toDisplayString() const
 {
     Q_D (const ButtonShortcut);
 
-    QList< KGlobalShortcutInfo > globalShortcutList;
-    QString                      displayString;
-    int                          buttonNr = getButton();
+    QString displayString;
+    QString globalShortcutName;
+    int     buttonNr = getButton();
 
     switch (d->type) {
     case ShortcutType::BUTTON:
@@ -306,10 +320,10 @@ const QString ButtonShortcut::toDisplayString() const
         convertKeySequenceToQKeySequenceFormat(displayString);
 
         // check if a global shortcut is assigned to this sequence
-        globalShortcutList = KGlobalAccel::globalShortcutsByKey(QKeySequence(displayString));
+        globalShortcutName = GlobalShortcutIndex::instance().findShortcutName(QKeySequence(displayString));
 
-        if(!globalShortcutList.isEmpty()) {
-            displayString = globalShortcutList.at(0).uniqueName();
+        if(!globalShortcutName.isEmpty()) {
+            displayString = globalShortcutName;
         }
         break;
 
@@ -361,145 +375,157 @@ const QString ButtonShortcut::toString() const
 }
 
 
-bool ButtonShortcut::convertKey(QString& key, bool fromStorage) const
+void ButtonShortcut::appendKey(QString& sequence, QStringView key, bool fromStorage, QChar separator) const
 {
-    QMap<QString,QString>::ConstIterator iter;
-    QMap<QString,QString>::ConstIterator iterEnd;
+    // convert the key to lower case Latin1 to look it up in the conversion table
+    QLatin1String convertedKey;
+    char          buffer[32];
 
-    if (fromStorage) {
-        iter    = getConvertFromStorageMap().find(key.toLower());
-        iterEnd = getConvertFromStorageMap().constEnd();
-    } else {
-        iter    = getConvertToStorageMap().find(key.toLower());
-        iterEnd = getConvertToStorageMap().constEnd();
-    }
+    if (key.size() <= qsizetype(sizeof(buffer))) {
+        bool isLatin1 = true;
 
-    if (iter == iterEnd) {
-        return false;
+        for (qsizetype i = 0 ; i < key.size() && isLatin1 ; ++i) {
+            const QChar keyChar = key.at(i).toLower();
+
+            isLatin1  = (keyChar.unicode() < 0x80);
+            buffer[i] = char(keyChar.unicode());
+        }
+
+        if (isLatin1) {
+            const QHash<QLatin1String, QLatin1String>& table = getConversionTable(fromStorage);
+            auto iter = table.constFind(QLatin1String(buffer, key.size()));
+
+            if (iter != table.constEnd()) {
+                convertedKey = iter.value();
+            }
+        }
     }
 
-    key = iter.value();
+    if (!sequence.isEmpty()) {
+        sequence.append(separator);
+    }
 
-    return true;
+    if (convertedKey.isNull()) {
+        appendPrettifiedKey(sequence, key);
+    } else {
+        appendPrettifiedKey(sequence, convertedKey);
+    }
 }
 
 
-void ButtonShortcut::convertToNormalizedKeySequence(QString& sequence, bool fromStorage) const
+void ButtonShortcut::convertToNormalizedKeySequence(QString& sequence, bool fromStorage, QChar separator) const
 {
-    normalizeKeySequence(sequence);
+    QStringView input(sequence);
+    QString     result;
 
-    static const QRegularExpression rx(QStringLiteral("\\s+"));
-    QStringList keyList    = sequence.split (rx, Qt::SkipEmptyParts);
-    bool        isFirstKey = true;
+    result.reserve(sequence.size());
 
-    sequence.clear();
+    // When setting a shortcut like "ctrl+x", xsetwacom will convert it to "key +ctrl +x -x"
+    // therefore we just truncate the string on the whitespace before the first "-key" we find.
+    for (qsizetype i = 0 ; i < input.size() - 1 ; ++i) {
+        if (input.at(i) == QLatin1Char('-') && !input.at(i + 1).isSpace() && (i == 0 || input.at(i - 1).isSpace())) {
+            input.truncate((i > 0) ? i - 1 : 0);
+            break;
+        }
+    }
 
-    for (QStringList::iterator iter = keyList.begin() ; iter != keyList.end() ; ++iter) {
+    qsizetype pos          = 0;
+    bool      isFirstToken = true;
 
-        convertKey (*iter, fromStorage);
-        prettifyKey (*iter);
+    while (pos < input.size()) {
 
-        if (isFirstKey) {
-            sequence.append(*iter);
-            isFirstKey = false;
-        } else {
-            sequence.append(QString::fromLatin1(" %1").arg(*iter));
+        // find the next whitespace separated token
+        if (input.at(pos).isSpace()) {
+            ++pos;
+            continue;
+        }
+
+        qsizetype tokenStart = pos;
+
+        while (pos < input.size() && !input.at(pos).isSpace()) {
+            ++pos;
         }
+
+        QStringView token = input.mid(tokenStart, pos - tokenStart);
+
+        // skip leading "key " identifier from xsetwacom sequences
+        if (isFirstToken) {
+            isFirstToken = false;
+
+            if (pos < input.size() && token.compare(QLatin1String("key"), Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+        }
+
+        // Remove the '+' prefix from keys.
+        // This will convert shortcuts like "+ctrl +alt" to "ctrl alt", but not
+        // shortcuts like "ctrl +" which is required to keep compatibility to older
+        // (buggy) configuration files.
+        if (token.size() > 1 && token.at(0) == QLatin1Char('+')) {
+            token = token.mid(1);
+        }
+
+        // Split keys on plus signs between keys.
+        // This will convert shortcuts like "ctrl+alt+shift" or "Ctrl++" to "ctrl alt shift" or "Ctrl +".
+        // The character after a plus sign is always part of the next key, so "Ctrl++" is "Ctrl" and "+".
+        qsizetype keyStart  = 0;
+        qsizetype nextSplit = 1;
+
+        for (qsizetype i = 1 ; i < token.size() - 1 ; ++i) {
+            if (i >= nextSplit && token.at(i) == QLatin1Char('+')) {
+                appendKey(result, token.mid(keyStart, i - keyStart), fromStorage, separator);
+                keyStart  = i + 1;
+                nextSplit = i + 3;
+            }
+        }
+
+        appendKey(result, token.mid(keyStart), fromStorage, separator);
     }
+
+    sequence = result;
 }
 
 
 void ButtonShortcut::convertKeySequenceToStorageFormat(QString& sequence) const
 {
-    convertToNormalizedKeySequence(sequence, false);
+    convertToNormalizedKeySequence(sequence, false, QLatin1Char(' '));
 }
 
 
 void ButtonShortcut::convertKeySequenceToQKeySequenceFormat(QString& sequence) const
 {
-    convertToNormalizedKeySequence(sequence, true);
-    sequence.replace(QLatin1String(" "), QLatin1String("+"));
+    convertToNormalizedKeySequence(sequence, true, QLatin1Char('+'));
 }
 
 
 
-const QMap< QString, QString >& ButtonShortcut::getConvertFromStorageMap()
+const QHash<QLatin1String, QLatin1String>& ButtonShortcut::getConversionTable(bool fromStorage)
 {
-    static QMap<QString, QString> map = initConversionMap(true);
-    return map;
-}
+    static const QHash<QLatin1String, QLatin1String> fromStorageTable = initConversionTable(true);
+    static const QHash<QLatin1String, QLatin1String> toStorageTable   = initConversionTable(false);
 
-
-const QMap< QString, QString >& ButtonShortcut::getConvertToStorageMap()
-{
-    static QMap<QString, QString> map = initConversionMap(false);
-    return map;
+    return (fromStorage ? fromStorageTable : toStorageTable);
 }
 
 
-QMap< QString, QString > ButtonShortcut::initConversionMap(bool fromStorageMap)
+QHash<QLatin1String, QLatin1String> ButtonShortcut::initConversionTable(bool fromStorageTable)
 {
-    QMap<QString, QString> map;
+    QHash<QLatin1String, QLatin1String> table;
 
     for (int i = 0 ; ; ++i) {
         if (CONVERT_KEY_MAP_DATA[i][0] == nullptr || CONVERT_KEY_MAP_DATA[i][1] == nullptr) {
-            return map;
+            return table;
         }
 
-        if (fromStorageMap) {
-            map.insert(QLatin1String(CONVERT_KEY_MAP_DATA[i][0]), QLatin1String(CONVERT_KEY_MAP_DATA[i][1]));
+        // the table points to the static key data, so lookups do not need any allocations
+        if (fromStorageTable) {
+            table.insert(QLatin1String(CONVERT_KEY_MAP_DATA[i][0]), QLatin1String(CONVERT_KEY_MAP_DATA[i][1]));
         } else {
-            map.insert(QLatin1String(CONVERT_KEY_MAP_DATA[i][1]), QLatin1String(CONVERT_KEY_MAP_DATA[i][0]));
+            table.insert(QLatin1String(CONVERT_KEY_MAP_DATA[i][1]), QLatin1String(CONVERT_KEY_MAP_DATA[i][0]));
         }
     }
 
-    return map;
-}
-
-
-void ButtonShortcut::normalizeKeySequence(QString& sequence) const
-{
-    // When setting a shortcut like "ctrl+x", xsetwacom will convert it to "key +ctrl +x -x"
-    // therefore we just truncate the string on the first "-key" we find.
-    static const QRegularExpression minusKeyRx (QLatin1String ("(^|\\s)-\\S"));
-
-    const QRegularExpressionMatch minusKeyRxMatch = minusKeyRx.match(sequence);
-
-    if (minusKeyRxMatch.hasMatch()) {
-        sequence = sequence.left(minusKeyRxMatch.capturedStart());
-    }
-
-    // cleanup leading "key " identifier from xsetwacom sequences
-    static const QRegularExpression leadingKey(QStringLiteral("^\\s*key\\s+"), QRegularExpression::CaseInsensitiveOption);
-    sequence.remove(leadingKey);
-
-    // Remove all '+' prefixes from keys.
-    // This will convert shortcuts like "+ctrl +alt" to "ctrl alt", but not
-    // shortcuts like "ctrl +" which is required to keep compatibility to older
-    // (buggy) configuration files.
-    static const QRegularExpression plusPrefixes(QStringLiteral("(^|\\s)\\+(\\S)"), QRegularExpression::CaseInsensitiveOption);
-    sequence.replace(plusPrefixes, QLatin1String ("\\1\\2"));
-
-    // Cleanup plus signs between keys.
-    // This will convert shortcuts like "ctrl+alt+shift" or "Ctrl++" to "ctrl alt shift" or "Ctrl +".
-    static const QRegularExpression cleanupPlus(QStringLiteral("(\\S)\\+(\\S)"), QRegularExpression::CaseInsensitiveOption);
-    sequence.replace (cleanupPlus, QLatin1String ("\\1 \\2"));
-
-    // replace multiple whitespaces with one
-    static const QRegularExpression whitespaces(QStringLiteral("\\s{2,}"), QRegularExpression::CaseInsensitiveOption);
-    sequence.replace (whitespaces, QLatin1String (" "));
-
-    // trim the string
-    sequence = sequence.trimmed();
-}
-
-
-void ButtonShortcut::prettifyKey(QString& key) const
-{
-    if (!key.isEmpty()) {
-        key = key.toLower();
-        key[0] = key.at(0).toUpper();
-    }
+    return table;
 }
 
 
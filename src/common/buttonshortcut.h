@@ -20,9 +20,11 @@
 #ifndef BUTTONSHORTCUT_H
 #define BUTTONSHORTCUT_H
 
+#include <QHash>
+#include <QLatin1String>
 #include <QString>
 #include <QStringList>
-#include <QMap>
+#include <QStringView>
 
 namespace Wacom {
 
@@ -203,34 +205,39 @@ private:
      * format. The array has to be NULL terminated!
      *
      * DO NOT USE THIS ARRAY DIRECTLY! It is only required to build the static
-     * conversion maps and should not be used for anything else.
+     * conversion tables and should not be used for anything else.
      *
-     * @sa getConvertFromStorageMap()
-     * @sa getConvertToStorageMap()
+     * @sa getConversionTable()
      */
     static const char* CONVERT_KEY_MAP_DATA[][2];
 
     /**
-     * Converts a key from storage format to QKeySequence format or vice versa.
-     * Storage format is actually the format used by xsetwacom.
+     * Converts a key from storage format to QKeySequence format or vice versa
+     * and appends it prettified to the given sequence. Storage format is actually
+     * the format used by xsetwacom. Keys which are not in the conversion table
+     * are appended as they are.
      *
-     * @param key The key to convert. This parameter will also contain the conversion result.
+     * @param sequence The sequence to append the key to.
+     * @param key The key to convert.
      * @param fromStorage True to convert from xsetwacom to QKeySequence format, False to convert
      *                    from QKeySequence to xsetwacom format.
-     *
-     * @return True if the key was converted, false if it was not touched.
+     * @param separator The separator to insert if the sequence is not empty.
      */
-    bool convertKey(QString& key, bool fromStorage) const;
+    void appendKey(QString& sequence, QStringView key, bool fromStorage, QChar separator) const;
 
     /**
-     * Normalizes the key sequence and converts all keys.
-     * The result is a string of keys separated by whitespaces.
+     * Normalizes the key sequence and converts all keys in a single pass.
+     *
+     * The sequence is normalized by removing the leading "key" identifier and all
+     * unnecessary '+' signs. A sequence like "key +ctrl +x -x" as returned by
+     * xsetwacom is truncated at the first released key.
      *
      * @param sequence The sequence to convert. This parameter will also hold the result of the conversion.
      * @param fromStorage True to convert from xsetwacom to QKeySequence format, False to convert
      *                    from QKeySequence to xsetwacom format.
+     * @param separator The separator to put between the keys of the result.
      */
-    void convertToNormalizedKeySequence(QString& sequence, bool fromStorage) const;
+    void convertToNormalizedKeySequence(QString& sequence, bool fromStorage, QChar separator) const;
 
     /**
      * Normalizes the key sequence and converts it to storage format.
@@ -243,51 +250,28 @@ private:
 
     /**
      * Normalizes the key sequence and converts it to QKeySequence format.
-     * The result is a string of keys separated by whitespaces.
+     * The result is a string of keys separated by '+' signs.
      *
      * @param sequence The sequence to convert. This parameter will also hold the result of the conversion.
      */
     void convertKeySequenceToQKeySequenceFormat (QString& sequence) const;
 
     /**
-     * Returns the map which is used to convert keys from storage format to
-     * the QKeySequence format.
-     */
-    static const QMap<QString, QString>& getConvertFromStorageMap();
-
-    /**
-     * Returns the map which is used to convert keys from QKeySequence format to
-     * the storage format.
-     */
-    static const QMap<QString, QString>& getConvertToStorageMap();
-
-    /**
-     * This is just a helper method to initialize the static conversion maps.
-     * Do not use it for anything else!
+     * Returns the table which is used to convert lower case keys from storage
+     * format to QKeySequence format or vice versa.
      *
-     * @sa getConvertFromStorageMap()
-     * @sa getConvertToStorageMap()
+     * @param fromStorage True to get the table from xsetwacom to QKeySequence format,
+     *                    False to get the table from QKeySequence to xsetwacom format.
      */
-    static QMap<QString, QString> initConversionMap(bool fromStorageMap);
+    static const QHash<QLatin1String, QLatin1String>& getConversionTable(bool fromStorage);
 
     /**
-     * Normalizes the key sequence by removing all unnecessary '+' signs.
-     * The result is a string of keys and modifiers separated by a whitespace.
-     * This method also does some basic checks to verify that the syntax of
-     * the sequence is valid. If the sequence is invalid it will be cleared and
-     * the result will therefore be an empty string. The result of this method
-     * will be directly written into the parameter \a sequence.
-     *
-     * @param sequence The sequence to normalize.
-     */
-    void normalizeKeySequence(QString& sequence) const;
-
-    /**
-     * Prettifies a key by converting the first character to uppercase.
+     * This is just a helper method to initialize the static conversion tables.
+     * Do not use it for anything else!
      *
-     * @param key The key to prettify, this will also contain the result.
+     * @sa getConversionTable()
      */
-    void prettifyKey (QString& key) const;
+    static QHash<QLatin1String, QLatin1String> initConversionTable(bool fromStorageTable);
 
     /**
      * Sets a button sequence. This method expects that the given sequence is
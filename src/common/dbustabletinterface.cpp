@@ -20,6 +20,8 @@
 #include "dbustabletinterface.h"
 #include "stringutils.h"
 
+#include <QDBusMetaType>
+#include <QMap>
 #include <QString>
 #include <QMetaType>
 #include <QMutex>
@@ -70,8 +72,8 @@ void DBusTabletInterface::resetInterface()
 
 void DBusTabletInterface::registerMetaTypes()
 {
-    // nothing to register for now
     // we keep this method so we have a central location to manage meta-types from
 
     //qDBusRegisterMetaType<Wacom::TabletInformation>();
+    qDBusRegisterMetaType< QMap<QString,QString> >(); // a{ss} of the propertiesChanged signal
 }
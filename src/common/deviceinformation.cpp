@@ -19,9 +19,11 @@
 
 #include "deviceinformation.h"
 
+#include <QSharedData>
+
 namespace Wacom
 {
-    class DeviceInformationPrivate
+    class DeviceInformationPrivate : public QSharedData
     {
         public:
             DeviceInformationPrivate (const DeviceType& type) : deviceType (type) {}
@@ -39,42 +41,27 @@ namespace Wacom
 using namespace Wacom;
 
 DeviceInformation::DeviceInformation (const DeviceType& deviceType, const QString& deviceName)
-    : d_ptr (new DeviceInformationPrivate (deviceType))
+    : d (new DeviceInformationPrivate (deviceType))
 {
-    Q_D (DeviceInformation);
-
     d->deviceName   = deviceName;
 }
 
 
-DeviceInformation::DeviceInformation (const DeviceInformation& that)
-    : d_ptr (new DeviceInformationPrivate (that.d_ptr->deviceType))
-{
-    operator= (that);
-}
+DeviceInformation::DeviceInformation (const DeviceInformation& that) = default;
 
 
-DeviceInformation::~DeviceInformation()
-{
-    delete d_ptr;
-}
+DeviceInformation::DeviceInformation (DeviceInformation&& that) noexcept = default;
 
 
+DeviceInformation::~DeviceInformation() = default;
 
-DeviceInformation& DeviceInformation::operator= (const DeviceInformation& that)
-{
-    Q_D (DeviceInformation);
 
-    d->deviceId     = that.d_ptr->deviceId;
-    d->deviceName   = that.d_ptr->deviceName;
-    d->deviceNode   = that.d_ptr->deviceNode;
-    d->deviceType   = that.d_ptr->deviceType;
-    d->productId    = that.d_ptr->productId;
-    d->tabletSerial = that.d_ptr->tabletSerial;
-    d->vendorId     = that.d_ptr->vendorId;
 
-    return *this;
-}
+DeviceInformation& DeviceInformation::operator= (const DeviceInformation& that) = default;
+
+
+
+DeviceInformation& DeviceInformation::operator= (DeviceInformation&& that) noexcept = default;
 
 
 
@@ -87,15 +74,17 @@ bool DeviceInformation::operator!= (const DeviceInformation& that) const
 
 bool DeviceInformation::operator== (const DeviceInformation& that) const
 {
-    Q_D (const DeviceInformation);
+    if (d == that.d) {
+        return true; // shared copies are always equal
+    }
 
-    if (d->deviceName.compare(that.d_ptr->deviceName, Qt::CaseInsensitive) != 0 ||
-        d->deviceNode.compare(that.d_ptr->deviceNode, Qt::CaseInsensitive) != 0 ||
-        d->deviceId     != that.d_ptr->deviceId   ||
-        d->deviceType   != that.d_ptr->deviceType ||
-        d->productId    != that.d_ptr->productId  ||
-        d->tabletSerial != that.d_ptr->tabletSerial   ||
-        d->vendorId     != that.d_ptr->vendorId)
+    if (d->deviceName.compare(that.d->deviceName, Qt::CaseInsensitive) != 0 ||
+        d->deviceNode.compare(that.d->deviceNode, Qt::CaseInsensitive) != 0 ||
+        d->deviceId     != that.d->deviceId   ||
+        d->deviceType   != that.d->deviceType ||
+        d->productId    != that.d->productId  ||
+        d->tabletSerial != that.d->tabletSerial   ||
+        d->vendorId     != that.d->vendorId)
     {
         return false;
     }
@@ -106,14 +95,12 @@ bool DeviceInformation::operator== (const DeviceInformation& that) const
 
 long int DeviceInformation::getDeviceId() const
 {
-    Q_D (const DeviceInformation);
     return d->deviceId;
 }
 
 
 const QString& DeviceInformation::getDeviceNode() const
 {
-    Q_D (const DeviceInformation);
     return d->deviceNode;
 }
 
@@ -121,7 +108,6 @@ const QString& DeviceInformation::getDeviceNode() const
 
 const QString& DeviceInformation::getName() const
 {
-    Q_D (const DeviceInformation);
     return d->deviceName;
 }
 
@@ -129,7 +115,6 @@ const QString& DeviceInformation::getName() const
 
 long int DeviceInformation::getProductId() const
 {
-    Q_D (const DeviceInformation);
     return d->productId;
 }
 
@@ -137,7 +122,6 @@ long int DeviceInformation::getProductId() const
 
 long int DeviceInformation::getTabletSerial() const
 {
-    Q_D (const DeviceInformation);
     return d->tabletSerial;
 }
 
@@ -145,7 +129,6 @@ long int DeviceInformation::getTabletSerial() const
 
 const DeviceType& DeviceInformation::getType() const
 {
-    Q_D (const DeviceInformation);
     return d->deviceType;
 }
 
@@ -153,7 +136,6 @@ const DeviceType& DeviceInformation::getType() const
 
 long int DeviceInformation::getVendorId() const
 {
-    Q_D (const DeviceInformation);
     return d->vendorId;
 }
 
@@ -161,14 +143,12 @@ long int DeviceInformation::getVendorId() const
 
 void DeviceInformation::setDeviceId(long int deviceId)
 {
-    Q_D (DeviceInformation);
     d->deviceId = deviceId;
 }
 
 
 void DeviceInformation::setDeviceNode (const QString& deviceNode)
 {
-    Q_D (DeviceInformation);
     d->deviceNode = deviceNode;
 }
 
@@ -176,7 +156,6 @@ void DeviceInformation::setDeviceNode (const QString& deviceNode)
 
 void DeviceInformation::setProductId (long productId)
 {
-    Q_D (DeviceInformation);
     d->productId = productId;
 }
 
@@ -184,7 +163,6 @@ void DeviceInformation::setProductId (long productId)
 
 void DeviceInformation::setTabletSerial (long tabletSerial)
 {
-    Q_D (DeviceInformation);
     d->tabletSerial = tabletSerial;
 }
 
@@ -192,6 +170,5 @@ void DeviceInformation::setTabletSerial (long tabletSerial)
 
 void DeviceInformation::setVendorId (long vendorId)
 {
-    Q_D (DeviceInformation);
     d->vendorId = vendorId;
 }
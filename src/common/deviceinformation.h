@@ -22,6 +22,7 @@
 
 #include "devicetype.h"
 
+#include <QSharedDataPointer>
 #include <QString>
 
 namespace Wacom {
@@ -32,6 +33,8 @@ class DeviceInformationPrivate;
 /**
  * Device information structure which stores all information about a tablet
  * component (stylus, eraser, pad, ...).
+ *
+ * The data is implicitly shared, copies are cheap until one of them is modified.
  */
 class DeviceInformation
 {
@@ -39,9 +42,11 @@ class DeviceInformation
 public:
     DeviceInformation(const DeviceType& deviceType, const QString& deviceName);
     DeviceInformation(const DeviceInformation& that);
+    DeviceInformation(DeviceInformation&& that) noexcept;
     virtual ~DeviceInformation();
 
     DeviceInformation& operator= (const DeviceInformation& that);
+    DeviceInformation& operator= (DeviceInformation&& that) noexcept;
 
     bool operator!= (const DeviceInformation& that) const;
 
@@ -81,8 +86,7 @@ public:
 
 
 private:
-    Q_DECLARE_PRIVATE (DeviceInformation)
-    DeviceInformationPrivate *const d_ptr;
+    QSharedDataPointer<DeviceInformationPrivate> d;
 
 }; // CLASS
 }  // NAMESPACE
@@ -22,6 +22,7 @@
 #include "deviceproperty.h"
 
 #include <QHash>
+#include <QSharedData>
 
 using namespace Wacom;
 
@@ -30,7 +31,7 @@ namespace Wacom {
   * Private class of the DeviceProfile for the d-pointer
   *
   */
-class DeviceProfilePrivate {
+class DeviceProfilePrivate : public QSharedData {
 public:    
     DeviceType deviceType = DeviceType::Unknown;
     QString deviceTypeName;
@@ -44,35 +45,55 @@ public:
 };
 }
 
-DeviceProfile::DeviceProfile() : PropertyAdaptor(nullptr), d_ptr(new DeviceProfilePrivate) { }
+namespace
+{
+    /**
+     * The private of moved-from profiles, so they stay valid empty profiles
+     * and moving them does not need to allocate.
+     */
+    const QSharedDataPointer<DeviceProfilePrivate>& emptyPrivate()
+    {
+        static const QSharedDataPointer<DeviceProfilePrivate> empty(new DeviceProfilePrivate);
+        return empty;
+    }
+}
+
+DeviceProfile::DeviceProfile() : PropertyAdaptor(nullptr), d(new DeviceProfilePrivate) { }
 
 DeviceProfile::DeviceProfile(const DeviceType& type)
     : PropertyAdaptor(nullptr)
-    , d_ptr(new DeviceProfilePrivate)
+    , d(new DeviceProfilePrivate)
 {
     setDeviceType(type);
 }
 
 DeviceProfile::DeviceProfile(const DeviceProfile& profile)
-    : PropertyAdaptor(nullptr), d_ptr(new DeviceProfilePrivate)
+    : PropertyAdaptor(nullptr), d(profile.d)
 {
-    operator=(profile);
 }
 
-DeviceProfile::~DeviceProfile()
+DeviceProfile::DeviceProfile(DeviceProfile&& profile) noexcept
+    : PropertyAdaptor(nullptr), d(emptyPrivate())
 {
-    delete this->d_ptr;
+    d.swap(profile.d);
 }
 
+DeviceProfile::~DeviceProfile() = default;
+
 
 
 DeviceProfile& DeviceProfile::operator= ( const DeviceProfile& that )
 {
-    Q_D( DeviceProfile );
+    d = that.d;
+
+    return *this;
+}
+
 
-    d->deviceTypeName = that.d_ptr->deviceTypeName;
-    d->deviceType = that.d_ptr->deviceType;
-    d->config = that.d_ptr->config;
+
+DeviceProfile& DeviceProfile::operator= ( DeviceProfile&& that ) noexcept
+{
+    d.swap(that.d);
 
     return *this;
 }
@@ -127,7 +148,6 @@ const QString DeviceProfile::getButton(int number) const
 
 DeviceType DeviceProfile::getDeviceType() const
 {
-    Q_D(const DeviceProfile);
     return d->deviceType;
 }
 
@@ -135,7 +155,6 @@ DeviceType DeviceProfile::getDeviceType() const
 
 const QString& DeviceProfile::getName() const
 {
-    Q_D( const DeviceProfile );
     return d->deviceTypeName;
 }
 
@@ -143,7 +162,6 @@ const QString& DeviceProfile::getName() const
 
 const QString DeviceProfile::getProperty(const Property& property) const
 {
-    Q_D( const DeviceProfile );
     return d->config.value(property.key());
 }
 
@@ -224,7 +242,6 @@ bool DeviceProfile::setButton(int number, const QString& shortcut)
 
 void DeviceProfile::setDeviceType(const DeviceType& type)
 {
-    Q_D( DeviceProfile );
     d->deviceType = type;
     d->deviceTypeName = type.key();
 }
@@ -233,8 +250,6 @@ void DeviceProfile::setDeviceType(const DeviceType& type)
 
 bool DeviceProfile::setProperty(const Property& property, const QString& value)
 {
-    Q_D( DeviceProfile );
-
     if (!supportsProperty(property)) {
         return false;
     }
@@ -22,6 +22,7 @@
 
 #include <QString>
 #include <QList>
+#include <QSharedDataPointer>
 
 #include "devicetype.h"
 #include "property.h"
@@ -33,6 +34,8 @@ class DeviceProfilePrivate;
 
 /**
   * This class implements the profile of a single device (stylus/eraser/cursor/pad/touch)
+  *
+  * The profile data is implicitly shared, copies are cheap until one of them is modified.
   */
 class DeviceProfile : public PropertyAdaptor {
 public:
@@ -51,6 +54,11 @@ public:
      */
     DeviceProfile( const DeviceProfile& profile );
 
+    /**
+     * Move constructor. The moved-from profile is left as a valid empty profile.
+     */
+    DeviceProfile( DeviceProfile&& profile ) noexcept;
+
     /**
       * Default destructor
       */
@@ -65,6 +73,15 @@ public:
      */
     DeviceProfile& operator=(const DeviceProfile& that);
 
+    /**
+     * Move operator. The moved-from profile gets the values of this instance.
+     *
+     * @param that The instance to move from.
+     *
+     * @return A reference to this instance.
+     */
+    DeviceProfile& operator=(DeviceProfile&& that) noexcept;
+
     /**
      * @return X11 event to which the given button should be mapped.
      */
@@ -123,9 +140,7 @@ public:
 
 
 private:
-    Q_DECLARE_PRIVATE( DeviceProfile )
-
-    DeviceProfilePrivate *const d_ptr; /**< d-pointer for this class */
+    QSharedDataPointer<DeviceProfilePrivate> d; /**< shared d-pointer for this class */
 
 }; // CLASS
 }  // NAMESPACE
@@ -56,6 +56,7 @@ const DeviceProperty DeviceProperty::CursorAccelVelocityScaling       ( Property
 const DeviceProperty DeviceProperty::CursorProximity  ( Property::CursorProximity,  QLatin1String("CursorProximity") );
 const DeviceProperty DeviceProperty::Gesture          ( Property::Gesture,          QLatin1String("Gesture") );
 const DeviceProperty DeviceProperty::InvertScroll     ( Property::InvertScroll,     QLatin1String("InvertScroll") );
+const DeviceProperty DeviceProperty::KeepAspectRatio  ( Property::KeepAspectRatio,  QLatin1String("KeepAspectRatio") );
 const DeviceProperty DeviceProperty::MapToOutput      ( Property::MapToOutput,      QLatin1String("MapToOutput") );
 const DeviceProperty DeviceProperty::Mode             ( Property::Mode,             QLatin1String("Mode") );
 const DeviceProperty DeviceProperty::PressureCurve    ( Property::PressureCurve,    QLatin1String("PressureCurve") );
@@ -69,6 +69,7 @@ public:
     static const DeviceProperty CursorProximity;
     static const DeviceProperty Gesture;
     static const DeviceProperty InvertScroll;
+    static const DeviceProperty KeepAspectRatio;
     static const DeviceProperty MapToOutput;
     static const DeviceProperty Mode;
     static const DeviceProperty PressureCurve;
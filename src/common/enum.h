@@ -21,9 +21,29 @@
 #define ENUM_H
 
 #include <QList>
+#include <QMultiHash>
+#include <QString>
 
 namespace Wacom {
 
+/**
+ * Returns the key under which an enum instance is stored in the lookup index
+ * of the Enum template. Keys which are considered equal by an Enum's equality
+ * functor have to map to the same index key. The generic version uses the key
+ * as it is, string keys are case folded as all our enums compare them case
+ * insensitive.
+ */
+template<class K>
+inline const K& enumIndexKey(const K& key)
+{
+    return key;
+}
+
+inline QString enumIndexKey(const QString& key)
+{
+    return key.toCaseFolded();
+}
+
 /**
  * A typesafe enumeration template class. It can be used as a comfortable replacement
  * for C++ enums and supports the following features:
@@ -31,8 +51,8 @@ namespace Wacom {
  *   - enumerators can be listed and iterated over
  *   - enumerator lists are sorted by a given comparator
  *   - enumerators can have a key assigned
- *   - enumerator keys can be listed and searched for
- * 
+ *   - enumerator keys can be listed and searched for in constant time
+ *
  * NOTICE
  * This class uses template specialization to store a static set of all instances.
  * Thereofore a specialization of the private instances member  'instances' has
@@ -49,6 +69,7 @@ class Enum {
 private:
     typedef QList<const D*>                    Container;
     typedef typename Container::const_iterator ContainerConstIterator;
+    typedef QMultiHash<K, const D*>            KeyIndex;
 
 public:
     typedef typename Container::size_type size_type;
@@ -127,13 +148,20 @@ public:
      */
     static const D* find(const K& key)
     {
-        E comp;
-        for (const_iterator i = begin() ; i != end() ; ++i) {
-            if (comp(i->key(), key)) {
-                return &(*i);
+        // the index only narrows down the candidates, the equality functor
+        // still has the last word and the first instance in sort order wins
+        E               comp;
+        const D*        found    = nullptr;
+        const KeyIndex& index    = keyIndex();
+        const K         indexKey = enumIndexKey(key);
+
+        for (typename KeyIndex::const_iterator i = index.constFind(indexKey) ; i != index.constEnd() && i.key() == indexKey ; ++i) {
+            if (comp(i.value()->key(), key) && (!found || instances.indexOf(i.value()) < instances.indexOf(found))) {
+                found = i.value();
             }
         }
-        return nullptr;
+
+        return found;
     }
 
 
@@ -150,6 +178,21 @@ public:
     }
 
 
+    /**
+     * Returns the registration serial of this instance. Serials are assigned
+     * in the order the class-static instances are constructed, starting at 0,
+     * and are independent of the sort order. Copies share the serial of the
+     * instance they were copied from, which makes it usable as an index into
+     * direct lookup tables.
+     *
+     * @return The registration serial of this enum instance.
+     */
+    int serial() const
+    {
+        return m_serial;
+    }
+
+
     /**
      * @return The key of this enum instance.
      */
@@ -197,6 +240,7 @@ protected:
     explicit Enum( const D* derived, const K& key ) : m_key(key)
     {
         m_derived = derived;
+        m_serial  = static_cast<int>(instances.size());
         insert(derived);
     }
 
@@ -223,6 +267,8 @@ private:
         L comp;
         typename Enum<D,K,L,E>::Container::iterator i = this->instances.begin();
 
+        keyIndex().insert(enumIndexKey(m_key), derived);
+
         for (; i != this->instances.end() ; ++i) {
             if (comp(derived, *i)) {
                 this->instances.insert(i, derived);
@@ -233,8 +279,19 @@ private:
         this->instances.push_back(derived);
     }
 
+    /**
+     * The lookup index of all class-static instances by key. It is filled
+     * while the instances are constructed and only read afterwards.
+     */
+    static KeyIndex& keyIndex()
+    {
+        static KeyIndex index;
+        return index;
+    }
+
     K        m_key;     /**< The key of this instance */
     const D* m_derived; /**< Pointer to derived class for fast comparison */
+    int      m_serial;  /**< Registration serial of this instance */
 
     /**
      * A static container with all the class-static Enum instances.
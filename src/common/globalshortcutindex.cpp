@@ -0,0 +1,235 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "globalshortcutindex.h"
+
+#include "logging.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KGlobalShortcutInfo>
+
+using namespace Wacom;
+
+namespace Wacom
+{
+    static const QString KGLOBALACCEL_SERVICE             = QLatin1String("org.kde.kglobalaccel");
+    static const QString KGLOBALACCEL_PATH                = QLatin1String("/kglobalaccel");
+    static const QString KGLOBALACCEL_INTERFACE           = QLatin1String("org.kde.KGlobalAccel");
+    static const QString KGLOBALACCEL_COMPONENT_INTERFACE = QLatin1String("org.kde.kglobalaccel.Component");
+
+    class GlobalShortcutIndexPrivate
+    {
+        public:
+            QHash<QKeySequence, QString> shortcuts;          //!< Key sequence to unique shortcut name.
+            QHash<QKeySequence, QString> loadingShortcuts;   //!< The index which is currently being built.
+            int                          pendingComponents = 0;
+            bool                         isLoaded          = false;
+            bool                         isLoading         = false;
+            bool                         reloadRequested   = false;
+    };
+}
+
+
+GlobalShortcutIndex& GlobalShortcutIndex::instance()
+{
+    // never deleted, the index lives as long as the process
+    static GlobalShortcutIndex* index = nullptr;
+    static QMutex               mutex;
+
+    QMutexLocker locker(&mutex);
+
+    if (!index) {
+        index = new GlobalShortcutIndex();
+        index->reload();
+    }
+
+    return *index;
+}
+
+
+GlobalShortcutIndex::GlobalShortcutIndex()
+        : QObject(), d_ptr(new GlobalShortcutIndexPrivate)
+{
+    qDBusRegisterMetaType<KGlobalShortcutInfo>();
+    qDBusRegisterMetaType< QList<KGlobalShortcutInfo> >();
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+
+    // kglobalaccel broadcasts this signal to all clients whenever a shortcut changes
+    bus.connect(KGLOBALACCEL_SERVICE, KGLOBALACCEL_PATH, KGLOBALACCEL_INTERFACE,
+                QLatin1String("yourShortcutsChanged"), this, SLOT(reload()));
+
+    QDBusServiceWatcher* serviceWatcher = new QDBusServiceWatcher(KGLOBALACCEL_SERVICE, bus,
+                                                                  QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration,
+                                                                  this);
+
+    connect(serviceWatcher, &QDBusServiceWatcher::serviceRegistered,   this, &GlobalShortcutIndex::onServiceRegistered);
+    connect(serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &GlobalShortcutIndex::onServiceUnregistered);
+}
+
+
+GlobalShortcutIndex::~GlobalShortcutIndex()
+{
+    delete this->d_ptr;
+}
+
+
+const QString GlobalShortcutIndex::findShortcutName(const QKeySequence& sequence) const
+{
+    Q_D (const GlobalShortcutIndex);
+
+    return d->shortcuts.value(sequence);
+}
+
+
+bool GlobalShortcutIndex::isLoaded() const
+{
+    Q_D (const GlobalShortcutIndex);
+
+    return d->isLoaded;
+}
+
+
+void GlobalShortcutIndex::reload()
+{
+    Q_D (GlobalShortcutIndex);
+
+    if (d->isLoading) {
+        d->reloadRequested = true;
+        return;
+    }
+
+    d->isLoading       = true;
+    d->reloadRequested = false;
+    d->loadingShortcuts.clear();
+
+    QDBusMessage message = QDBusMessage::createMethodCall(KGLOBALACCEL_SERVICE, KGLOBALACCEL_PATH,
+                                                          KGLOBALACCEL_INTERFACE, QLatin1String("allComponents"));
+
+    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &GlobalShortcutIndex::onComponentsReceived);
+}
+
+
+void GlobalShortcutIndex::onComponentsReceived(QDBusPendingCallWatcher* call)
+{
+    Q_D (GlobalShortcutIndex);
+
+    QDBusPendingReply< QList<QDBusObjectPath> > reply = *call;
+    call->deleteLater();
+
+    if (reply.isError()) {
+        qCWarning(COMMON) << QString::fromLatin1("Failed to load global shortcuts: %1").arg(reply.error().message());
+        finishReload();
+        return;
+    }
+
+    const QList<QDBusObjectPath> components = reply.value();
+
+    foreach (const QDBusObjectPath& component, components) {
+        QDBusMessage message = QDBusMessage::createMethodCall(KGLOBALACCEL_SERVICE, component.path(),
+                                                              KGLOBALACCEL_COMPONENT_INTERFACE, QLatin1String("allShortcutInfos"));
+
+        QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, &GlobalShortcutIndex::onShortcutInfosReceived);
+
+        ++d->pendingComponents;
+    }
+
+    if (d->pendingComponents == 0) {
+        finishReload();
+    }
+}
+
+
+void GlobalShortcutIndex::onShortcutInfosReceived(QDBusPendingCallWatcher* call)
+{
+    Q_D (GlobalShortcutIndex);
+
+    QDBusPendingReply< QList<KGlobalShortcutInfo> > reply = *call;
+    call->deleteLater();
+
+    if (reply.isError()) {
+        qCWarning(COMMON) << QString::fromLatin1("Failed to load global shortcuts of a component: %1").arg(reply.error().message());
+
+    } else {
+        const QList<KGlobalShortcutInfo> shortcutInfos = reply.value();
+
+        foreach (const KGlobalShortcutInfo& shortcutInfo, shortcutInfos) {
+            foreach (const QKeySequence& key, shortcutInfo.keys()) {
+                // like KGlobalAccel::globalShortcutsByKey() the first match wins
+                if (!key.isEmpty() && !d->loadingShortcuts.contains(key)) {
+                    d->loadingShortcuts.insert(key, shortcutInfo.uniqueName());
+                }
+            }
+        }
+    }
+
+    if (--d->pendingComponents == 0) {
+        finishReload();
+    }
+}
+
+
+void GlobalShortcutIndex::onServiceRegistered()
+{
+    reload();
+}
+
+
+void GlobalShortcutIndex::onServiceUnregistered()
+{
+    Q_D (GlobalShortcutIndex);
+
+    if (d->shortcuts.isEmpty()) {
+        return;
+    }
+
+    d->shortcuts.clear();
+    emit indexChanged();
+}
+
+
+void GlobalShortcutIndex::finishReload()
+{
+    Q_D (GlobalShortcutIndex);
+
+    d->shortcuts.swap(d->loadingShortcuts);
+    d->loadingShortcuts.clear();
+    d->isLoading = false;
+    d->isLoaded  = true;
+
+    emit indexChanged();
+
+    if (d->reloadRequested) {
+        reload();
+    }
+}
+
+#include "moc_globalshortcutindex.cpp"
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLOBALSHORTCUTINDEX_H
+#define GLOBALSHORTCUTINDEX_H
+
+#include <QKeySequence>
+#include <QObject>
+#include <QString>
+
+class QDBusPendingCallWatcher;
+
+namespace Wacom
+{
+
+class GlobalShortcutIndexPrivate;
+
+/**
+ * A process-wide index of all global shortcuts known to kglobalaccel.
+ *
+ * Looking up a global shortcut with KGlobalAccel is a synchronous D-Bus call.
+ * This index loads all shortcuts once asynchronously and keeps them up to date
+ * when kglobalaccel reports changes, so lookups never block. Until the index is
+ * loaded, lookups return an empty string and indexChanged() is emitted as soon
+ * as the result is available.
+ */
+class GlobalShortcutIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Returns the only instance of this class. The index starts loading
+     * when this method is called for the first time.
+     */
+    static GlobalShortcutIndex& instance();
+
+    /**
+     * Looks up the global shortcut assigned to the given key sequence.
+     *
+     * @param sequence The key sequence to look up.
+     *
+     * @return The unique name of the global shortcut or an empty string if none was found.
+     */
+    const QString findShortcutName(const QKeySequence& sequence) const;
+
+    /**
+     * @return True if the index was loaded at least once.
+     */
+    bool isLoaded() const;
+
+
+public slots:
+
+    /**
+     * Reloads the index from kglobalaccel. If a reload is already running,
+     * another one is started once it finished.
+     */
+    void reload();
+
+
+signals:
+
+    /**
+     * Emitted whenever the index was (re)loaded or cleared.
+     */
+    void indexChanged();
+
+
+private slots:
+
+    void onComponentsReceived(QDBusPendingCallWatcher* call);
+
+    void onShortcutInfosReceived(QDBusPendingCallWatcher* call);
+
+    void onServiceRegistered();
+
+    void onServiceUnregistered();
+
+
+private:
+
+    GlobalShortcutIndex();
+    ~GlobalShortcutIndex() override;
+
+    void finishReload();
+
+    Q_DECLARE_PRIVATE(GlobalShortcutIndex)
+    GlobalShortcutIndexPrivate *const d_ptr; //!< The D-Pointer of this class.
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
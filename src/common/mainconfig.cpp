@@ -81,6 +81,20 @@ QString MainConfig::getLastProfile(const QString &deviceName)
 }
 
 
+bool MainConfig::isPropertyCacheVerified()
+{
+    Q_D( MainConfig );
+    bool isVerified = false;
+
+    if (d->config) {
+        d->config->reparseConfiguration();
+        isVerified = KConfigGroup(d->config, QStringLiteral("General")).readEntry(QStringLiteral("VerifyPropertyCache"), false);
+    }
+
+    return isVerified;
+}
+
+
 void MainConfig::setLastProfile(const QString &deviceName, const QString& profile)
 {
     Q_D( MainConfig );
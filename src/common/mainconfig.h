@@ -36,6 +36,12 @@ public:
 
     QString getLastProfile(const QString &deviceName);
 
+    /**
+     * Checks if cached tablet properties should be read back from the devices
+     * and compared. This is a debugging aid which is disabled by default.
+     */
+    bool isPropertyCacheVerified();
+
     void open (const QString& fileName);
 
     void setLastProfile(const QString &deviceName, const QString& profile);
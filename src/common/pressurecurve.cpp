@@ -0,0 +1,311 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pressurecurve.h"
+
+#include "stringutils.h"
+
+#include <QPointF>
+#include <QSharedData>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Wacom;
+
+namespace Wacom
+{
+    class PressureCurvePrivate : public QSharedData
+    {
+        public:
+            int   points[4] = {0, 0, 100, 100}; // x1, y1, x2, y2 in the range [0,100]
+            float lut[PressureCurve::LUT_SIZE]; // output values for evenly spaced input values
+
+            void updateLookupTable();
+    };
+
+    /**
+     * Checks if point (a,b) is on the line from (x0,y0) to (x1,y1).
+     * This uses the same tolerance as the wacom driver.
+     */
+    static bool isOnLine(double x0, double y0, double x1, double y1, double a, double b)
+    {
+        const double c = (b - y0) * (x1 - x0) - (a - x0) * (y1 - y0);
+        return (c > -0.05) && (c < 0.05);
+    }
+
+    /**
+     * Writes a line from (x0,y0) to (x1,y1) into the lookup table.
+     * Entries between the end points are linearly interpolated.
+     */
+    static void fillLine(float* lut, double x0, double y0, double x1, double y1)
+    {
+        if (x1 < x0) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+
+        const double scale = PressureCurve::LUT_SIZE - 1;
+        const int    first = qBound(0, static_cast<int>(std::ceil(x0 * scale)),  PressureCurve::LUT_SIZE - 1);
+        const int    last  = qBound(0, static_cast<int>(std::floor(x1 * scale)), PressureCurve::LUT_SIZE - 1);
+
+        for (int i = first ; i <= last ; ++i) {
+            const double x = i / scale;
+            const double y = (x1 > x0) ? y0 + (x - x0) * (y1 - y0) / (x1 - x0) : y1;
+
+            lut[i] = static_cast<float>(qBound(0.0, y, 1.0));
+        }
+    }
+
+    /**
+     * Flattens the Bezier curve into lines the same way the wacom driver does:
+     * the curve is split in half until both control points are on the line
+     * between the end points.
+     */
+    static void fillCurve(float* lut, int depth,
+                          double x0, double y0, double x1, double y1,
+                          double x2, double y2, double x3, double y3)
+    {
+        if (depth <= 0 || (isOnLine(x0, y0, x3, y3, x1, y1) && isOnLine(x0, y0, x3, y3, x2, y2))) {
+            fillLine(lut, x0, y0, x3, y3);
+            return;
+        }
+
+        // de Casteljau subdivision at t = 0.5
+        const double x01 = (x0 + x1) / 2,   y01 = (y0 + y1) / 2;
+        const double x12 = (x1 + x2) / 2,   y12 = (y1 + y2) / 2;
+        const double x23 = (x2 + x3) / 2,   y23 = (y2 + y3) / 2;
+        const double xa  = (x01 + x12) / 2, ya  = (y01 + y12) / 2;
+        const double xb  = (x12 + x23) / 2, yb  = (y12 + y23) / 2;
+        const double xm  = (xa + xb) / 2,   ym  = (ya + yb) / 2;
+
+        fillCurve(lut, depth - 1, x0, y0, x01, y01, xa, ya, xm, ym);
+        fillCurve(lut, depth - 1, xm, ym, xb, yb, x23, y23, x3, y3);
+    }
+
+    void PressureCurvePrivate::updateLookupTable()
+    {
+        static const int MAX_DEPTH = 16;
+
+        fillCurve(lut, MAX_DEPTH, 0.0, 0.0,
+                  points[0] / 100.0, points[1] / 100.0,
+                  points[2] / 100.0, points[3] / 100.0,
+                  1.0, 1.0);
+    }
+
+    /**
+     * Parses the four values of a curve. Returns false if the curve is not valid.
+     */
+    static bool parseCurve(QStringView curve, int* points)
+    {
+        QStringView values[4];
+
+        if (StringUtils::tokenize(curve, QLatin1Char(' '), values, 4, true) != 4) {
+            return false;
+        }
+
+        for (int i = 0 ; i < 4 ; ++i) {
+            bool isOk;
+            points[i] = values[i].toInt(&isOk);
+
+            if (!isOk || points[i] < 0 || points[i] > 100) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+
+PressureCurve::PressureCurve()
+        : d(new PressureCurvePrivate)
+{
+    d->updateLookupTable();
+}
+
+
+PressureCurve::PressureCurve(int x1, int y1, int x2, int y2)
+        : d(new PressureCurvePrivate)
+{
+    d->points[0] = qBound(0, x1, 100);
+    d->points[1] = qBound(0, y1, 100);
+    d->points[2] = qBound(0, x2, 100);
+    d->points[3] = qBound(0, y2, 100);
+    d->updateLookupTable();
+}
+
+
+PressureCurve::PressureCurve(const QString& curve)
+        : d(new PressureCurvePrivate)
+{
+    fromString(curve);
+}
+
+
+PressureCurve::PressureCurve(const PressureCurve& curve) = default;
+
+
+PressureCurve::PressureCurve(PressureCurve&& curve) noexcept = default;
+
+
+PressureCurve::~PressureCurve() = default;
+
+
+PressureCurve& PressureCurve::operator=(const PressureCurve& curve) = default;
+
+
+PressureCurve& PressureCurve::operator=(PressureCurve&& curve) noexcept = default;
+
+
+bool PressureCurve::operator==(const PressureCurve& curve) const
+{
+    return std::equal(d->points, d->points + 4, curve.d->points);
+}
+
+
+bool PressureCurve::operator!=(const PressureCurve& curve) const
+{
+    return !operator==(curve);
+}
+
+
+const PressureCurve PressureCurve::fromControlPoint(int x, int y)
+{
+    return PressureCurve(x, y, 100 - y, 100 - x);
+}
+
+
+bool PressureCurve::fromString(const QString& curve)
+{
+    return fromString(QStringView(curve));
+}
+
+
+bool PressureCurve::fromString(QStringView curve)
+{
+    int        points[4];
+    const bool isOk = parseCurve(curve, points);
+
+    if (!isOk) {
+        // the linear curve
+        points[0] = points[1] = 0;
+        points[2] = points[3] = 100;
+    }
+
+    std::copy(points, points + 4, d->points);
+    d->updateLookupTable();
+
+    return isOk;
+}
+
+
+bool PressureCurve::isValid(QStringView curve)
+{
+    int points[4];
+    return parseCurve(curve, points);
+}
+
+
+int PressureCurve::x1() const
+{
+    return d->points[0];
+}
+
+
+int PressureCurve::y1() const
+{
+    return d->points[1];
+}
+
+
+int PressureCurve::x2() const
+{
+    return d->points[2];
+}
+
+
+int PressureCurve::y2() const
+{
+    return d->points[3];
+}
+
+
+bool PressureCurve::isLinear() const
+{
+    return d->points[0] == d->points[1] && d->points[2] == d->points[3];
+}
+
+
+float PressureCurve::evaluate(float pressure) const
+{
+    float result;
+    evaluate(&pressure, &result, 1);
+
+    return result;
+}
+
+
+void PressureCurve::evaluate(const float* pressures, float* results, qsizetype count) const
+{
+    const float* lut   = d->lut;
+    const float  scale = LUT_SIZE - 1;
+
+    for (qsizetype i = 0 ; i < count ; ++i) {
+        const float position = qBound(0.f, pressures[i], 1.f) * scale;
+        const int   index    = qMin(static_cast<int>(position), LUT_SIZE - 2);
+        const float fraction = position - index;
+
+        results[i] = lut[index] + fraction * (lut[index + 1] - lut[index]);
+    }
+}
+
+
+const float* PressureCurve::lookupTable() const
+{
+    return d->lut;
+}
+
+
+const QPolygonF PressureCurve::toPolyline(int segments) const
+{
+    const QPointF p1(d->points[0] / 100.0, d->points[1] / 100.0);
+    const QPointF p2(d->points[2] / 100.0, d->points[3] / 100.0);
+    const QPointF p3(1.0, 1.0);
+
+    segments = qMax(1, segments);
+
+    QPolygonF polyline(segments + 1);
+
+    for (int i = 0 ; i <= segments ; ++i) {
+        const qreal t  = static_cast<qreal>(i) / segments;
+        const qreal mt = 1.0 - t;
+
+        // the start point is (0,0) and does not contribute
+        polyline[i] = 3 * mt * mt * t * p1 + 3 * mt * t * t * p2 + t * t * t * p3;
+    }
+
+    return polyline;
+}
+
+
+const QString PressureCurve::toString() const
+{
+    return StringUtils::joinNumbers({d->points[0], d->points[1], d->points[2], d->points[3]}, ' ');
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRESSURECURVE_H
+#define PRESSURECURVE_H
+
+#include <QPolygonF>
+#include <QSharedDataPointer>
+#include <QString>
+#include <QStringView>
+
+namespace Wacom
+{
+
+class PressureCurvePrivate;
+
+/**
+ * @brief A pressure curve as used by the wacom driver.
+ *
+ * The curve is a cubic Bezier curve from (0,0) to (100,100) with two control
+ * points in between. It is stored in the xsetwacom format "x1 y1 x2 y2" where
+ * every value has to be in the range [0,100]. The x axis is the pressure
+ * reported by the pen and the y axis is the pressure the driver reports
+ * to applications.
+ *
+ * The curve is evaluated the same way the driver does it, by flattening it
+ * into line segments and sampling these into a lookup table. The lookup
+ * table is built once per curve and is implicitly shared between copies.
+ */
+class PressureCurve
+{
+public:
+
+    /**
+     * The number of entries of the lookup table.
+     */
+    static const int LUT_SIZE = 1024;
+
+    /**
+     * Creates the linear default curve "0 0 100 100".
+     */
+    PressureCurve();
+
+    /**
+     * Creates a curve from the given control points. Values out of range are clamped.
+     */
+    PressureCurve(int x1, int y1, int x2, int y2);
+
+    /**
+     * Parses the given curve. If it is invalid, the default curve is used.
+     *
+     * @param curve The curve in xsetwacom format "x1 y1 x2 y2".
+     */
+    explicit PressureCurve(const QString& curve);
+
+    PressureCurve(const PressureCurve& curve);
+    PressureCurve(PressureCurve&& curve) noexcept;
+
+    ~PressureCurve();
+
+    PressureCurve& operator= (const PressureCurve& curve);
+    PressureCurve& operator= (PressureCurve&& curve) noexcept;
+
+    bool operator== (const PressureCurve& curve) const;
+    bool operator!= (const PressureCurve& curve) const;
+
+    /**
+     * Creates a curve from its first control point. The wacom driver expects
+     * the second control point to be the first one mirrored at the diagonal
+     * from (0,100) to (100,0), so the curve is fully defined by one point.
+     *
+     * @param x The x value of the first control point.
+     * @param y The y value of the first control point.
+     *
+     * @return The curve "x y 100-y 100-x".
+     */
+    static const PressureCurve fromControlPoint(int x, int y);
+
+    /**
+     * Parses a curve in xsetwacom format "x1 y1 x2 y2". If the curve can not
+     * be parsed or one of the values is out of range, the default curve is set.
+     *
+     * @param curve The curve to parse.
+     *
+     * @return True if the curve was valid, false if the default curve was set.
+     */
+    bool fromString(const QString& curve);
+
+    /**
+     * @see fromString(const QString&)
+     */
+    bool fromString(QStringView curve);
+
+    /**
+     * Checks if the given string is a valid curve in xsetwacom format.
+     *
+     * @param curve The curve to check.
+     *
+     * @return True if the curve can be set on the driver, else false.
+     */
+    static bool isValid(QStringView curve);
+
+    /**
+     * @return The control point values in the order x1, y1, x2, y2.
+     */
+    int x1() const;
+    int y1() const;
+    int x2() const;
+    int y2() const;
+
+    /**
+     * @return True if this is the linear curve which does not change the pressure.
+     */
+    bool isLinear() const;
+
+    /**
+     * Evaluates the curve like the driver does.
+     *
+     * @param pressure The pressure reported by the pen in the range [0,1].
+     *
+     * @return The pressure reported to applications in the range [0,1].
+     */
+    float evaluate(float pressure) const;
+
+    /**
+     * Evaluates the curve for a batch of pressure values. The loop does not
+     * branch and does not call any functions, so compilers can vectorize it.
+     * The input and output buffers must not overlap.
+     *
+     * @param pressures The pressure values reported by the pen in the range [0,1].
+     * @param results   Receives the pressure values reported to applications.
+     * @param count     The number of values to evaluate.
+     */
+    void evaluate(const float* pressures, float* results, qsizetype count) const;
+
+    /**
+     * @return The lookup table with LUT_SIZE output values for evenly spaced input values from 0 to 1.
+     */
+    const float* lookupTable() const;
+
+    /**
+     * Samples the Bezier curve into a polyline with coordinates in the range [0,1].
+     *
+     * @param segments The number of line segments.
+     *
+     * @return The polyline from (0,0) to (1,1).
+     */
+    const QPolygonF toPolyline(int segments) const;
+
+    /**
+     * @return The curve in xsetwacom format "x1 y1 x2 y2".
+     */
+    const QString toString() const;
+
+private:
+
+    QSharedDataPointer<PressureCurvePrivate> d;
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
@@ -186,31 +186,33 @@ QString ProfileManagement::profileName() const
 
 void ProfileManagement::reload()
 {
-    auto vendorId = DBusTabletInterface::instance().getInformation(m_tabletId, TabletInfo::CompanyId.key());
-    vendorId.waitForFinished();
-    if (vendorId.isValid()) {
-        m_vendorId = vendorId;
-    } else {
+    QDBusReply<QVariantMap> snapshot = DBusTabletInterface::instance().getTabletSnapshot(m_tabletId);
+
+    if (!snapshot.isValid()) {
+        qCWarning(COMMON) << "Couldn't get tablet snapshot for" << m_tabletId;
+    }
+
+    reload(TabletSnapshot(snapshot.value()));
+}
+
+
+void ProfileManagement::reload(const TabletSnapshot &snapshot)
+{
+    m_vendorId = snapshot.getInformation(TabletInfo::CompanyId);
+    if (!snapshot.isValid()) {
         qCWarning(COMMON) << "Couldn't get vendor id for" << m_tabletId;
         m_vendorId = QString::fromLatin1("unknown");
     }
 
     m_deviceName = QString::fromLatin1("%1:%2").arg(m_vendorId).arg(m_tabletId);
 
-    auto touchSensorId = DBusTabletInterface::instance().getTouchSensorId(m_tabletId);
-    m_sensorId = touchSensorId.value();
-    if (touchSensorId.isValid() && !m_sensorId.isEmpty()) {
+    m_sensorId = snapshot.getInformation(TabletInfo::TouchSensorId);
+    if (!m_sensorId.isEmpty()) {
         m_sensorId = QString::fromLatin1("%1:%2").arg(m_vendorId).arg(m_sensorId);
         qCInfo(COMMON) << "Multi-device touch" << m_sensorId;
     }
 
-    auto touchName = DBusTabletInterface::instance().getDeviceName(m_tabletId, DeviceType::Touch.key());
-    touchName.waitForFinished();
-    if (touchName.isValid()) {
-        qCDebug(COMMON) << "touchName for" << m_tabletId << "is" << touchName.value();
-        m_hasTouch = !QString(touchName.value()).isEmpty();
-    }
-    else {
-        m_hasTouch = false;
-    }
+    const QString touchName = snapshot.getDeviceName(DeviceType::Touch);
+    qCDebug(COMMON) << "touchName for" << m_tabletId << "is" << touchName;
+    m_hasTouch = !touchName.isEmpty();
 }
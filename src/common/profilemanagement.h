@@ -24,6 +24,7 @@
 
 #include "profilemanager.h"
 #include "deviceprofile.h"
+#include "tabletsnapshot.h"
 
 //Qt includes
 #include <QString>
@@ -127,6 +128,15 @@ class ProfileManagement : public ProfileManagementInterface
           */
         void reload() override;
 
+        /**
+          * Reloads the profiles from an already fetched tablet snapshot
+          *
+          * Same as reload() but does not ask DBus for the tablet information.
+          *
+          * @param snapshot The snapshot of the tablet set by setTabletId().
+          */
+        void reload(const TabletSnapshot &snapshot);
+
     private:
         /**
           * Default constructor.
@@ -64,6 +64,7 @@ const Property Property::CursorAccelVelocityScaling      ( QLatin1String("Cursor
 const Property Property::CursorProximity  ( QLatin1String("CursorProximity") );
 const Property Property::Gesture          ( QLatin1String("Gesture") );
 const Property Property::InvertScroll     ( QLatin1String("InvertScroll") );
+const Property Property::KeepAspectRatio  ( QLatin1String("KeepAspectRatio") );
 const Property Property::MapToOutput      ( QLatin1String("MapToOutput") );
 const Property Property::Mode             ( QLatin1String("Mode") );
 const Property Property::PressureCurve    ( QLatin1String("PressureCurve") );
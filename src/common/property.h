@@ -160,6 +160,13 @@ public:
      */
     static const Property InvertScroll;
 
+    /**
+     * Preserves the aspect ratio of the tablet area when it is mapped to a
+     * screen space. The screen space is letterboxed instead of stretching
+     * the tablet over it. Valid values are "true" or "false".
+     */
+    static const Property KeepAspectRatio;
+
     /**
      * @deprecated Use Property::ScreenSpace instead.
      *
@@ -83,6 +83,12 @@ bool PropertyAdaptor::getPropertyAsBool(const Property& property) const
 }
 
 
+const QString PropertyAdaptor::getPropertyState(const Property& property) const
+{
+    return getProperty(property);
+}
+
+
 bool PropertyAdaptor::setProperty ( const Property& property, const QString& value )
 {
     Q_D( PropertyAdaptor );
@@ -77,6 +77,19 @@ public:
     virtual bool getPropertyAsBool(const Property& property) const;
 
 
+    /**
+     * Gets the state a property left on the adapted object. Properties which
+     * are converted before they are set can not be read back as a value, but
+     * the converted state tells if they are still set. The default
+     * implementation returns the property value.
+     *
+     * @param property The property to get the state of.
+     *
+     * @return The property state which can be compared to an earlier state.
+     */
+    virtual const QString getPropertyState(const Property& property) const;
+
+
     /**
      * Sets a property value. The default implementation passes the value to the
      * adapted object as-is or does nothing if no object is set.
@@ -81,15 +81,10 @@ public:
      */
     static const D* map (const Property& property)
     {
-        typename PropertySetTemplateSpecialization::const_iterator i = PropertySetTemplateSpecialization::begin();
+        static const QList<const D*> table = buildIdTable();
+        const int                    index = property.serial();
 
-        for ( ; i != PropertySetTemplateSpecialization::end() ; ++i) {
-            if (i->id() == property) {
-                return &(*i);
-            }
-        }
-
-        return nullptr;
+        return (index >= 0 && index < table.size()) ? table.at(index) : nullptr;
     }
 
     /**
@@ -133,6 +128,34 @@ protected:
 
 private:
 
+    /**
+     * Builds a direct mapping table from Property::serial() to the instance
+     * of this set which maps the property, or nullptr if the property is not
+     * supported. If more than one instance maps the same property, the first
+     * one in iteration order is used.
+     *
+     * The table is built on first use as the property instances live in other
+     * translation units and may not be constructed yet while our instances are.
+     */
+    static QList<const D*> buildIdTable()
+    {
+        QList<const D*> table;
+
+        for (typename PropertySetTemplateSpecialization::const_iterator i = PropertySetTemplateSpecialization::begin() ; i != PropertySetTemplateSpecialization::end() ; ++i) {
+            const int index = i->id().serial();
+
+            if (index >= table.size()) {
+                table.resize(index + 1, nullptr);
+            }
+
+            if (table.at(index) == nullptr) {
+                table[index] = &(*i);
+            }
+        }
+
+        return table;
+    }
+
     const Property *m_id = nullptr;       /**< The property identifier used to map between different property sets */
 
 };     // CLASS
@@ -22,13 +22,16 @@
 #include "stringutils.h"
 
 #include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedData>
 #include <QStringList>
 
 using namespace Wacom;
 
 namespace Wacom
 {
-    class ScreenMapPrivate
+    class ScreenMapPrivate : public QSharedData
     {
         public:
             static const QString SCREENAREA_SEPERATOR;
@@ -40,71 +43,117 @@ namespace Wacom
 
     const QString ScreenMapPrivate::SCREENAREA_SEPERATOR = QLatin1String(":");
     const QString ScreenMapPrivate::SCREEN_SEPERATOR     = QLatin1String("|");
+
+    /**
+     * Parses a mapping string. Empty or invalid areas are returned as empty
+     * areas as their value depends on the tablet geometry of the screen map.
+     */
+    static QHash<QString, TabletArea> parseMappings(QStringView mappings)
+    {
+        QHash<QString, TabletArea> result;
+        QStringView                mapping[2];
+
+        qsizetype start = 0;
+
+        while (start < mappings.size()) {
+            qsizetype end = mappings.indexOf(ScreenMapPrivate::SCREEN_SEPERATOR, start);
+
+            if (end < 0) {
+                end = mappings.size();
+            }
+
+            QStringView screenMapping = mappings.mid(start, end - start);
+            start = end + 1;
+
+            if (StringUtils::tokenize(screenMapping, ScreenMapPrivate::SCREENAREA_SEPERATOR.at(0), mapping, 2, true) != 2) {
+                continue;
+            }
+
+            ScreenSpace screen(mapping[0].trimmed());
+            TabletArea  tabletArea;
+            tabletArea.fromString(mapping[1].trimmed());
+
+            result.insert(screen.toString(), tabletArea);
+        }
+
+        return result;
+    }
+
+    /**
+     * Parses a mapping string or returns the cached result if the same string
+     * was parsed before. The same few mappings are parsed over and over again
+     * whenever a screen changes, so the cache does not need to be large.
+     */
+    static QHash<QString, TabletArea> parseMappingsCached(const QString& mappings)
+    {
+        static const int                                   MAX_CACHE_SIZE = 32;
+        static QHash<QString, QHash<QString, TabletArea> > cache;
+        static QMutex                                      mutex;
+
+        QMutexLocker locker(&mutex);
+
+        auto cached = cache.constFind(mappings);
+
+        if (cached != cache.constEnd()) {
+            return cached.value();
+        }
+
+        if (cache.size() >= MAX_CACHE_SIZE) {
+            cache.clear();
+        }
+
+        return *cache.insert(mappings, parseMappings(mappings));
+    }
 }
 
 ScreenMap::ScreenMap(const TabletArea &tabletGeometry)
-        : d_ptr(new ScreenMapPrivate)
+        : d(new ScreenMapPrivate)
 {
-    Q_D(ScreenMap);
-
     d->tabletGeometry = tabletGeometry;
 }
 
 
 ScreenMap::ScreenMap(const QString& mapping)
-        : d_ptr(new ScreenMapPrivate)
+        : d(new ScreenMapPrivate)
 {
     fromString(mapping);
 }
 
 
 
-ScreenMap::ScreenMap(const ScreenMap& screenMap)
-        : d_ptr(new ScreenMapPrivate)
-{
-    operator=(screenMap);
-}
+ScreenMap::ScreenMap(const ScreenMap& screenMap) = default;
 
 
 
-ScreenMap::~ScreenMap()
-{
-    delete this->d_ptr;
-}
+ScreenMap::ScreenMap(ScreenMap&& screenMap) noexcept = default;
 
 
-ScreenMap& ScreenMap::operator=(const ScreenMap& screenMap)
-{
-    *(this->d_ptr) = *(screenMap.d_ptr);
 
-    return (*this);
-}
+ScreenMap::~ScreenMap() = default;
 
 
-void ScreenMap::fromString(const QString& mappings)
-{
-    Q_D(ScreenMap);
+ScreenMap& ScreenMap::operator=(const ScreenMap& screenMap) = default;
 
-    QStringList screenMappings = mappings.split(QLatin1String("|"), Qt::SkipEmptyParts);
-    QString     separator(QLatin1String(":"));
-    QStringList mapping;
-    ScreenSpace screen;
-    TabletArea  tabletArea;
 
-    d->mappings.clear();
+ScreenMap& ScreenMap::operator=(ScreenMap&& screenMap) noexcept = default;
 
-    foreach(QString screenMapping, screenMappings) {
 
-        mapping = screenMapping.split(separator, Qt::SkipEmptyParts);
+void ScreenMap::fromString(const QString& mappings)
+{
+    // the parsed mappings are shared with the cache until we modify them
+    d->mappings = parseMappingsCached(mappings);
 
-        if (mapping.count() != 2) {
-            continue;
-        }
+    // empty areas are mapped to the whole tablet
+    QStringList emptyMappings;
 
-        screen     = ScreenSpace(mapping.at(0).trimmed());
-        tabletArea = TabletArea(mapping.at(1).trimmed());
+    for (auto iter = d->mappings.constBegin() ; iter != d->mappings.constEnd() ; ++iter) {
+        if (iter.value().isEmpty()) {
+            emptyMappings.append(iter.key());
+        }
+    }
 
-        setMapping(screen, tabletArea);
+    foreach (const QString& screen, emptyMappings) {
+        d->mappings.insert(screen, d->tabletGeometry);
     }
 }
 
@@ -112,8 +161,6 @@ void ScreenMap::fromString(const QString& mappings)
 
 const TabletArea ScreenMap::getMapping(const ScreenSpace& screen) const
 {
-    Q_D(const ScreenMap);
-
     // try to find selection for the current screen
     auto citer = d->mappings.constFind(screen.toString());
 
@@ -138,8 +185,6 @@ const QString ScreenMap::getMappingAsString(const ScreenSpace& screen) const
 
 void ScreenMap::setMapping(const ScreenSpace& screen, const TabletArea &mapping)
 {
-    Q_D(ScreenMap);
-
     if (mapping.isEmpty()) {
         d->mappings.insert(screen.toString(), d->tabletGeometry);
     } else {
@@ -151,24 +196,17 @@ void ScreenMap::setMapping(const ScreenSpace& screen, const TabletArea &mapping)
 
 const QString ScreenMap::toString() const
 {
-    Q_D(const ScreenMap);
-
     // create mapping string
-    auto mapping = d->mappings.constBegin();
-
-    QString     mappings;
-    TabletArea  area;
-
-    for ( ; mapping != d->mappings.constEnd() ; ++mapping) {
-        area = mapping.value();
+    QString mappings;
 
+    for (auto mapping = d->mappings.constBegin() ; mapping != d->mappings.constEnd() ; ++mapping) {
         if (!mappings.isEmpty()) {
             mappings.append(ScreenMapPrivate::SCREEN_SEPERATOR);
         }
 
-        mappings.append(QString::fromLatin1("%1%2%3").arg(mapping.key())
-                                                     .arg(ScreenMapPrivate::SCREENAREA_SEPERATOR)
-                                                     .arg(area.toString()));
+        mappings.append(mapping.key());
+        mappings.append(ScreenMapPrivate::SCREENAREA_SEPERATOR);
+        mappings.append(mapping.value().toString());
     }
 
     return mappings;
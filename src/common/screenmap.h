@@ -24,6 +24,7 @@
 #include "screenrotation.h"
 #include "tabletarea.h"
 
+#include <QSharedDataPointer>
 #include <QString>
 
 namespace Wacom
@@ -34,7 +35,8 @@ class ScreenMapPrivate;
 /**
  * @brief Contains device mappings for each screen
  *
- * Can be (de)serialized to be stored in the configuration file
+ * Can be (de)serialized to be stored in the configuration file.
+ * The mappings are implicitly shared, copies are cheap until one of them is modified.
  */
 class ScreenMap
 {
@@ -43,10 +45,12 @@ public:
     explicit ScreenMap(const TabletArea& tabletGeometry = TabletArea());
     explicit ScreenMap(const QString& mapping);
     explicit ScreenMap(const ScreenMap& screenMap);
+    ScreenMap(ScreenMap&& screenMap) noexcept;
 
     virtual ~ScreenMap();
 
     ScreenMap& operator= (const ScreenMap& screenMap);
+    ScreenMap& operator= (ScreenMap&& screenMap) noexcept;
 
     void fromString(const QString& mappings);
 
@@ -60,8 +64,7 @@ public:
 
 private:
 
-    Q_DECLARE_PRIVATE(ScreenMap)
-    ScreenMapPrivate *const d_ptr = nullptr;
+    QSharedDataPointer<ScreenMapPrivate> d;
 
 }; // CLASS
 }  // NAMESPACE
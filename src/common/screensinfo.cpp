@@ -18,9 +18,7 @@
  */
 
 #include "screensinfo.h"
-
-#include <QApplication>
-#include <QScreen>
+#include "screentopology.h"
 
 namespace Wacom {
 
@@ -28,21 +26,16 @@ namespace ScreensInfo {
 
 const QRect getUnifiedDisplayGeometry()
 {
-    QRect unitedScreen(0, 0, 0, 0);
-    for (const auto &screen : getScreenGeometries()) {
-        unitedScreen = unitedScreen.united(screen);
-    }
-
-    return unitedScreen;
+    return ScreenTopology::current().desktopGeometry();
 }
 
 const QMap<QString, QRect> getScreenGeometries()
 {
+    const ScreenTopology topology = ScreenTopology::current();
+
     QMap<QString, QRect> screenGeometries;
-    for (auto screen : QGuiApplication::screens()) {
-        QRect geometry = screen->geometry();
-        screenGeometries[screen->name()] =
-                QRect(geometry.topLeft(), geometry.size() * screen->devicePixelRatio());
+    foreach (const QString& output, topology.outputNames()) {
+        screenGeometries.insert(output, topology.outputGeometry(output));
     }
 
     return screenGeometries;
@@ -50,36 +43,23 @@ const QMap<QString, QRect> getScreenGeometries()
 
 const ScreenRotation getScreenRotation(QString output)
 {
-    for (const auto &screen : QGuiApplication::screens()) {
-        if (screen->name() == output) {
-            switch (screen->orientation()) {
-            case Qt::PrimaryOrientation:
-            case Qt::LandscapeOrientation:
-                return ScreenRotation::NONE;
-            case Qt::PortraitOrientation:
-                return ScreenRotation::CW;
-            case Qt::InvertedLandscapeOrientation:
-                return ScreenRotation::HALF;
-            case Qt::InvertedPortraitOrientation:
-                return ScreenRotation::CCW;
-            }
-        }
-    }
-
-    return ScreenRotation::NONE;
+    return ScreenTopology::current().outputRotation(output);
 }
 
 const QString getPrimaryScreenName()
 {
-    return QGuiApplication::primaryScreen()->name();
+    return ScreenTopology::current().primaryOutput();
 }
 
 const QString getNextScreenName(QString output)
 {
-    const auto screenNames = getScreenGeometries().keys();
-    const auto index = screenNames.indexOf(output);
+    const ScreenTopology topology = ScreenTopology::current();
+    const QStringList&   screenNames = topology.outputNames();
+    const auto           index = screenNames.indexOf(output);
 
-    if (index >= screenNames.size() - 1) {
+    if (screenNames.isEmpty()) {
+        return QString();
+    } else if (index >= screenNames.size() - 1) {
         return screenNames.at(0);
     } else {
         return screenNames.at(index + 1);
@@ -30,6 +30,8 @@ namespace Wacom
 
 /**
  * @brief Various display info helper functions
+ *
+ * All functions read the current ScreenTopology snapshot.
  */
 namespace ScreensInfo
 {
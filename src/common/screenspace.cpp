@@ -21,13 +21,14 @@
 
 #include "logging.h"
 #include "screensinfo.h"
+#include "stringutils.h"
 
 using namespace Wacom;
 
 namespace Wacom
 {
     static const QString DESKTOP_STRING = QLatin1String("desktop");
-    static const QString AREA_STRING    = QLatin1String("area");
+    static const QLatin1String AREA_STRING("area");
     static const QString SPEED_STRING   = QLatin1String("speed");
 }
 
@@ -38,36 +39,53 @@ ScreenSpace::ScreenSpace()
 }
 
 ScreenSpace::ScreenSpace(const QString &screenSpaceString)
+{
+    if (!parse(screenSpaceString)) {
+        // share the string instead of copying the view
+        _type = ScreenSpaceType::Output;
+        _output = screenSpaceString;
+    }
+}
+
+ScreenSpace::ScreenSpace(QStringView screenSpaceString)
+{
+    if (!parse(screenSpaceString)) {
+        _type = ScreenSpaceType::Output;
+        _output = screenSpaceString.toString();
+    }
+}
+
+bool ScreenSpace::parse(QStringView screenSpaceString)
 {
     if (screenSpaceString == DESKTOP_STRING) {
         _type = ScreenSpaceType::Desktop;
-        return;
+        return true;
     }
 
-    QStringList tokens = screenSpaceString.split(QChar::fromLatin1('x'));
+    QStringView tokens[5];
+    const int   count = StringUtils::tokenize(screenSpaceString, QLatin1Char('x'), tokens, 5);
 
-    if (tokens.size() == 5 && tokens.at(0) == AREA_STRING) {
+    if (count == 5 && tokens[0] == AREA_STRING) {
         _type = ScreenSpaceType::Area;
         _area = QRect(
-                    tokens.at(1).toInt(),
-                    tokens.at(2).toInt(),
-                    tokens.at(3).toInt(),
-                    tokens.at(4).toInt()
+                    tokens[1].toInt(),
+                    tokens[2].toInt(),
+                    tokens[3].toInt(),
+                    tokens[4].toInt()
                     );
-        return;
+        return true;
     }
 
-    if (tokens.size() == 3 && tokens.at(0) == SPEED_STRING) {
+    if (count == 3 && tokens[0] == SPEED_STRING) {
         _type = ScreenSpaceType::ArbitraryTranslationMatrix;
         _speed = QPointF(
-                    tokens.at(1).toDouble(),
-                    tokens.at(2).toDouble()
+                    tokens[1].toDouble(),
+                    tokens[2].toDouble()
                     );
-        return;
+        return true;
     }
 
-    _type = ScreenSpaceType::Output;
-    _output = screenSpaceString;
+    return false;
 }
 
 ScreenSpace::~ScreenSpace()
@@ -122,8 +140,11 @@ const ScreenSpace ScreenSpace::matrix(qreal x, qreal y)
 
 const ScreenSpace ScreenSpace::area(QRect area)
 {
-    return ScreenSpace(QString::fromLatin1("%1x%2x%3x%4x%5")
-                       .arg(AREA_STRING).arg(area.left()).arg(area.top()).arg(area.width()).arg(area.height()));
+    ScreenSpace screenSpace;
+    screenSpace._type = ScreenSpaceType::Area;
+    screenSpace._area = area;
+
+    return screenSpace;
 }
 
 
@@ -135,8 +156,7 @@ const QString ScreenSpace::toString() const
     case ScreenSpaceType::Output:
         return _output;
     case ScreenSpaceType::Area:
-        return QString::fromLatin1("%1x%2x%3x%4x%5")
-                .arg(AREA_STRING).arg(_area.left()).arg(_area.top()).arg(_area.width()).arg(_area.height());
+        return StringUtils::joinNumbers({_area.left(), _area.top(), _area.width(), _area.height()}, 'x', AREA_STRING);
     case ScreenSpaceType::ArbitraryTranslationMatrix:
         return QString::fromLatin1("%1x%2x%3")
                 .arg(SPEED_STRING).arg(_speed.x()).arg(_speed.y());
@@ -21,6 +21,7 @@
 #define SCREENSPACE_H
 
 #include <QString>
+#include <QStringView>
 #include <QRect>
 
 namespace Wacom
@@ -47,6 +48,7 @@ public:
 
     ScreenSpace();
     ScreenSpace(const QString& screenSpaceString);
+    explicit ScreenSpace(QStringView screenSpaceString);
     virtual ~ScreenSpace();
 
     bool operator== (const ScreenSpace& screenSpace) const;
@@ -89,6 +91,12 @@ public:
     QRect getArea() const;
 
 private:
+    /**
+     * Parses the given string in a single pass. Returns false if the
+     * string is no desktop, area or speed string, so it names an output.
+     */
+    bool parse(QStringView screenSpaceString);
+
     ScreenSpaceType _type = ScreenSpaceType::Desktop;
 
     QString _output;
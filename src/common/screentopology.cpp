@@ -0,0 +1,312 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "screentopology.h"
+#include "tabletmapping.h"
+
+#include <QGuiApplication>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScreen>
+#include <QSharedData>
+
+using namespace Wacom;
+
+namespace Wacom
+{
+    class ScreenTopologyPrivate : public QSharedData
+    {
+        public:
+            struct OutputEntry
+            {
+                ScreenTopology::Output output;
+                QTransform             matrix;
+            };
+
+            quint64                     generation = 0;
+            QStringList                 outputNames;
+            QString                     primaryOutput;
+            QRect                       desktopGeometry;
+            QTransform                  desktopMatrix;
+            QHash<QString, OutputEntry> outputs;
+    };
+
+    /**
+     * The snapshot returned by ScreenTopology::current() and the state
+     * required to keep it up to date.
+     */
+    struct CurrentScreenTopology
+    {
+        QMutex         mutex;
+        ScreenTopology snapshot;
+        quint64        generation = 0;
+        bool           isWatching = false;
+    };
+
+    static CurrentScreenTopology& currentScreenTopology()
+    {
+        static CurrentScreenTopology current;
+        return current;
+    }
+
+    static ScreenRotation toScreenRotation(Qt::ScreenOrientation orientation)
+    {
+        switch (orientation) {
+        case Qt::PrimaryOrientation:
+        case Qt::LandscapeOrientation:
+            return ScreenRotation::NONE;
+        case Qt::PortraitOrientation:
+            return ScreenRotation::CW;
+        case Qt::InvertedLandscapeOrientation:
+            return ScreenRotation::HALF;
+        case Qt::InvertedPortraitOrientation:
+            return ScreenRotation::CCW;
+        }
+
+        return ScreenRotation::NONE;
+    }
+
+    /**
+     * Builds a snapshot of the screens of this application. A screen which
+     * is about to be removed can be excluded from the snapshot.
+     */
+    static ScreenTopology buildScreenTopology(quint64 generation, const QScreen* removedScreen = nullptr)
+    {
+        QList<ScreenTopology::Output> outputs;
+
+        foreach (QScreen* screen, QGuiApplication::screens()) {
+            if (screen == removedScreen) {
+                continue;
+            }
+
+            ScreenTopology::Output output;
+            QRect                  geometry = screen->geometry();
+
+            output.name     = screen->name();
+            output.geometry = QRect(geometry.topLeft(), geometry.size() * screen->devicePixelRatio());
+            output.rotation = toScreenRotation(screen->orientation());
+
+            outputs.append(output);
+        }
+
+        QScreen* primaryScreen = QGuiApplication::primaryScreen();
+        QString  primaryOutput = (primaryScreen != nullptr && primaryScreen != removedScreen) ? primaryScreen->name() : QString();
+
+        return ScreenTopology(outputs, primaryOutput, generation);
+    }
+
+    static void updateScreenTopology(const QScreen* removedScreen = nullptr)
+    {
+        CurrentScreenTopology& current = currentScreenTopology();
+        QMutexLocker           locker(&current.mutex);
+
+        current.snapshot = buildScreenTopology(++current.generation, removedScreen);
+    }
+
+    static void watchScreen(QScreen* screen)
+    {
+        QObject::connect(screen, &QScreen::geometryChanged, screen, []() { updateScreenTopology(); });
+        QObject::connect(screen, &QScreen::orientationChanged, screen, []() { updateScreenTopology(); });
+    }
+}
+
+
+
+ScreenTopology::ScreenTopology()
+        : d(new ScreenTopologyPrivate)
+{
+}
+
+
+
+ScreenTopology::ScreenTopology(const QList<Output>& outputs, const QString& primaryOutput, quint64 generation)
+        : d(new ScreenTopologyPrivate)
+{
+    d->generation    = generation;
+    d->primaryOutput = primaryOutput;
+
+    foreach (const Output& output, outputs) {
+        d->desktopGeometry = d->desktopGeometry.united(output.geometry);
+        d->outputNames.append(output.name);
+    }
+
+    d->outputNames.sort();
+
+    // the matrices depend on the whole desktop, so they are calculated last
+    d->desktopMatrix = TabletMapping::calculateMatrix(d->desktopGeometry, d->desktopGeometry);
+
+    foreach (const Output& output, outputs) {
+        d->outputs.insert(output.name, { output, TabletMapping::calculateMatrix(d->desktopGeometry, output.geometry) });
+    }
+}
+
+
+
+ScreenTopology::ScreenTopology(const ScreenTopology& topology) = default;
+
+
+
+ScreenTopology::ScreenTopology(ScreenTopology&& topology) noexcept = default;
+
+
+
+ScreenTopology::~ScreenTopology() = default;
+
+
+ScreenTopology& ScreenTopology::operator=(const ScreenTopology& topology) = default;
+
+
+ScreenTopology& ScreenTopology::operator=(ScreenTopology&& topology) noexcept = default;
+
+
+
+ScreenTopology ScreenTopology::current()
+{
+    watchScreens();
+
+    CurrentScreenTopology& current = currentScreenTopology();
+    QMutexLocker           locker(&current.mutex);
+
+    return current.snapshot;
+}
+
+
+
+void ScreenTopology::watchScreens()
+{
+    CurrentScreenTopology& current = currentScreenTopology();
+
+    {
+        QMutexLocker locker(&current.mutex);
+
+        if (current.isWatching || qobject_cast<QGuiApplication*>(QCoreApplication::instance()) == nullptr) {
+            return;
+        }
+
+        current.isWatching = true;
+        current.snapshot   = buildScreenTopology(++current.generation);
+    }
+
+    QGuiApplication* application = qobject_cast<QGuiApplication*>(QCoreApplication::instance());
+
+    foreach (QScreen* screen, QGuiApplication::screens()) {
+        watchScreen(screen);
+    }
+
+    QObject::connect(application, &QGuiApplication::screenAdded, application, [](QScreen* screen) {
+        watchScreen(screen);
+        updateScreenTopology();
+    });
+
+    QObject::connect(application, &QGuiApplication::screenRemoved, application, [](QScreen* screen) {
+        updateScreenTopology(screen);
+    });
+
+    QObject::connect(application, &QGuiApplication::primaryScreenChanged, application, []() {
+        updateScreenTopology();
+    });
+}
+
+
+
+quint64 ScreenTopology::generation() const
+{
+    return d->generation;
+}
+
+
+
+const QStringList& ScreenTopology::outputNames() const
+{
+    return d->outputNames;
+}
+
+
+
+int ScreenTopology::outputCount() const
+{
+    return d->outputNames.size();
+}
+
+
+
+bool ScreenTopology::hasOutput(const QString& output) const
+{
+    return d->outputs.contains(output);
+}
+
+
+
+const QString& ScreenTopology::primaryOutput() const
+{
+    return d->primaryOutput;
+}
+
+
+
+const QRect& ScreenTopology::desktopGeometry() const
+{
+    return d->desktopGeometry;
+}
+
+
+
+QRect ScreenTopology::outputGeometry(const QString& output) const
+{
+    auto entry = d->outputs.constFind(output);
+
+    return (entry != d->outputs.constEnd()) ? entry->output.geometry : QRect();
+}
+
+
+
+ScreenRotation ScreenTopology::outputRotation(const QString& output) const
+{
+    auto entry = d->outputs.constFind(output);
+
+    return (entry != d->outputs.constEnd()) ? entry->output.rotation : ScreenRotation::NONE;
+}
+
+
+
+const QTransform& ScreenTopology::desktopMatrix() const
+{
+    return d->desktopMatrix;
+}
+
+
+
+QTransform ScreenTopology::outputMatrix(const QString& output, bool* found) const
+{
+    auto entry = d->outputs.constFind(output);
+
+    if (found != nullptr) {
+        *found = (entry != d->outputs.constEnd());
+    }
+
+    return (entry != d->outputs.constEnd()) ? entry->matrix : d->desktopMatrix;
+}
+
+
+
+QTransform ScreenTopology::areaMatrix(const QRect& area) const
+{
+    return TabletMapping::calculateMatrix(d->desktopGeometry, area);
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCREENTOPOLOGY_H
+#define SCREENTOPOLOGY_H
+
+#include "screenrotation.h"
+
+#include <QList>
+#include <QRect>
+#include <QSharedDataPointer>
+#include <QString>
+#include <QStringList>
+#include <QTransform>
+
+namespace Wacom
+{
+
+class ScreenTopologyPrivate;
+
+/**
+ * @brief An immutable snapshot of the screen layout.
+ *
+ * Mapping a tablet to a screen needs the geometry of the output and of the
+ * whole desktop. Instead of walking QGuiApplication::screens() on every call,
+ * the current topology is rebuilt only when a screen signals a change. Each
+ * rebuild increases the generation of the snapshot, so users can detect that
+ * the layout has changed since they last looked at it.
+ *
+ * For each output and for the whole desktop the snapshot holds the coordinate
+ * transformation matrix which maps a tablet to it:
+ *
+ *  | width  0       offsetX |
+ *  | 0      height  offsetY |
+ *  | 0      0          1    |
+ *
+ * Snapshots are implicitly shared and may be read from any thread.
+ */
+class ScreenTopology
+{
+public:
+
+    /**
+     * A single output as seen by the snapshot.
+     */
+    struct Output
+    {
+        QString        name;
+        QRect          geometry;                          //!< The geometry in device pixels.
+        ScreenRotation rotation = ScreenRotation::NONE;   //!< The rotation as seen by the monitor.
+    };
+
+    /**
+     * Creates an empty topology without any outputs.
+     */
+    ScreenTopology();
+
+    /**
+     * Creates a topology from the given outputs.
+     *
+     * @param outputs       The outputs of the topology.
+     * @param primaryOutput The name of the primary output.
+     * @param generation    The generation of the snapshot.
+     */
+    ScreenTopology(const QList<Output>& outputs, const QString& primaryOutput, quint64 generation = 0);
+
+    ScreenTopology(const ScreenTopology& topology);
+    ScreenTopology(ScreenTopology&& topology) noexcept;
+
+    virtual ~ScreenTopology();
+
+    ScreenTopology& operator= (const ScreenTopology& topology);
+    ScreenTopology& operator= (ScreenTopology&& topology) noexcept;
+
+    /**
+     * Returns the latest snapshot of the screens of this application.
+     * The snapshot is built on first use and afterwards only when the
+     * screens change.
+     */
+    static ScreenTopology current();
+
+    /**
+     * Starts watching the screens for changes. This is done on first use
+     * of current() anyway, but the daemon calls it before it connects its
+     * own screen handlers, so those always see an updated snapshot.
+     */
+    static void watchScreens();
+
+    /**
+     * @return The generation of this snapshot.
+     */
+    quint64 generation() const;
+
+    /**
+     * @return The names of all outputs, sorted by name.
+     */
+    const QStringList& outputNames() const;
+
+    int outputCount() const;
+
+    bool hasOutput(const QString& output) const;
+
+    const QString& primaryOutput() const;
+
+    /**
+     * @return All outputs united as one rectangle.
+     */
+    const QRect& desktopGeometry() const;
+
+    /**
+     * @return The geometry of the output or an empty rectangle if there is no such output.
+     */
+    QRect outputGeometry(const QString& output) const;
+
+    /**
+     * @return The rotation of the output or ScreenRotation::NONE if there is no such output.
+     */
+    ScreenRotation outputRotation(const QString& output) const;
+
+    /**
+     * @return The matrix which maps a tablet to the whole desktop.
+     */
+    const QTransform& desktopMatrix() const;
+
+    /**
+     * @param output The name of the output.
+     * @param found  Set to true if the output exists, false if the desktop matrix was returned.
+     *
+     * @return The matrix which maps a tablet to the output or the desktop matrix if there is no such output.
+     */
+    QTransform outputMatrix(const QString& output, bool* found = nullptr) const;
+
+    /**
+     * Calculates the matrix which maps a tablet to an arbitrary area of the desktop.
+     */
+    QTransform areaMatrix(const QRect& area) const;
+
+private:
+
+    QSharedDataPointer<ScreenTopologyPrivate> d;
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
@@ -22,6 +22,9 @@
 #include <QRect>
 #include <QStringList>
 
+#include <algorithm>
+#include <charconv>
+
 using namespace Wacom;
 
 bool StringUtils::asBool (const QString& value)
@@ -118,3 +121,62 @@ const QRect StringUtils::toQRectByCoordinates(const QString& value, bool allowOn
 
     return rect;
 }
+
+
+
+int StringUtils::tokenize(QStringView value, QChar separator, QStringView* tokens, int maxTokens, bool skipEmptyParts)
+{
+    int count = 0;
+    qsizetype start = 0;
+
+    while (start <= value.size()) {
+        qsizetype end = value.indexOf(separator, start);
+
+        if (end < 0) {
+            end = value.size();
+        }
+
+        if (!skipEmptyParts || end > start) {
+            if (count < maxTokens) {
+                tokens[count] = value.mid(start, end - start);
+            }
+            ++count;
+        }
+
+        start = end + 1;
+    }
+
+    return count;
+}
+
+
+
+QString StringUtils::joinNumbers(std::initializer_list<int> values, char separator, QLatin1String prefix)
+{
+    // enough for the prefix and an int with sign and separator per value
+    char  buffer[256];
+    char* pos = buffer;
+    char* end = buffer + sizeof(buffer);
+
+    if (prefix.size() + qsizetype(values.size()) * 12 > qsizetype(sizeof(buffer))) {
+        return QString(); // never happens for the small lists we format
+    }
+
+    if (prefix.size() > 0) {
+        pos = std::copy(prefix.data(), prefix.data() + prefix.size(), pos);
+        *pos++ = separator;
+    }
+
+    bool first = true;
+
+    for (int value : values) {
+        if (!first) {
+            *pos++ = separator;
+        }
+
+        pos   = std::to_chars(pos, end, value).ptr;
+        first = false;
+    }
+
+    return QString::fromLatin1(buffer, pos - buffer);
+}
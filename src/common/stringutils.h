@@ -21,6 +21,9 @@
 #define STRINGUTILS_H
 
 #include <QString>
+#include <QStringView>
+
+#include <initializer_list>
 
 class QRect;
 
@@ -74,6 +77,34 @@ public:
      */
     static const QRect toQRectByCoordinates(const QString& value, bool allowOnlyPositiveValues = false);
 
+
+    /**
+     * Splits a string in a single pass without allocating any memory. The
+     * tokens are views into the given string, so it has to outlive them.
+     *
+     * @param value     The string to split.
+     * @param separator The character which separates the tokens.
+     * @param tokens    An array which receives the first \a maxTokens tokens.
+     * @param maxTokens The size of the token array.
+     * @param skipEmptyParts If set, empty tokens are not counted.
+     *
+     * @return The number of tokens in the string, which can be larger than \a maxTokens.
+     */
+    static int tokenize(QStringView value, QChar separator, QStringView* tokens, int maxTokens, bool skipEmptyParts = false);
+
+
+    /**
+     * Formats a list of integers separated by the given character with a
+     * single allocation, e.g. "10 20 30 40" or "areax10x20x30x40".
+     *
+     * @param values    The values to format.
+     * @param separator The character to put between the values.
+     * @param prefix    An optional prefix which is separated from the values by the separator.
+     *
+     * @return The formatted string.
+     */
+    static QString joinNumbers(std::initializer_list<int> values, char separator, QLatin1String prefix = QLatin1String());
+
 }; // CLASS
 }  // NAMESPACE
 #endif // HEADER PROTECTION
@@ -19,7 +19,7 @@
 
 #include "tabletarea.h"
 
-#include <QStringList>
+#include "stringutils.h"
 
 using namespace Wacom;
 
@@ -59,23 +59,29 @@ TabletArea& TabletArea::operator=(const QRect& rect)
 
 
 bool TabletArea::fromString(const QString &area, const QRect& defaultValue)
+{
+    return fromString(QStringView(area), defaultValue);
+}
+
+
+bool TabletArea::fromString(QStringView area, const QRect& defaultValue)
 {
     // set given default value
     *this = defaultValue;
 
     // expected format "x1 y1 x2 y2"
-    QStringList areaValues = area.split(QLatin1String(" "), Qt::SkipEmptyParts);
+    QStringView areaValues[4];
 
-    if (areaValues.count() != 4) {
+    if (StringUtils::tokenize(area, QLatin1Char(' '), areaValues, 4, true) != 4) {
         return false;
     }
 
     // convert to integers
     bool x1Ok, y1Ok, x2Ok, y2Ok;
-    int x1 = areaValues.at(0).toInt(&x1Ok);
-    int y1 = areaValues.at(1).toInt(&y1Ok);
-    int x2 = areaValues.at(2).toInt(&x2Ok);
-    int y2 = areaValues.at(3).toInt(&y2Ok);
+    int x1 = areaValues[0].toInt(&x1Ok);
+    int y1 = areaValues[1].toInt(&y1Ok);
+    int x2 = areaValues[2].toInt(&x2Ok);
+    int y2 = areaValues[3].toInt(&y2Ok);
 
     if ( !x1Ok || !y1Ok || !x2Ok || !y2Ok ) {
         return false;
@@ -98,8 +104,5 @@ bool TabletArea::fromString(const QString &area, const QRect& defaultValue)
 
 const QString TabletArea::toString() const
 {
-    return QString::fromLatin1("%1 %2 %3 %4").arg(x())
-                                             .arg(y())
-                                             .arg(x() + width())
-                                             .arg(y() + height());
+    return StringUtils::joinNumbers({x(), y(), x() + width(), y() + height()}, ' ');
 }
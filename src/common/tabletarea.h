@@ -22,6 +22,7 @@
 
 #include <QRect>
 #include <QString>
+#include <QStringView>
 
 namespace Wacom
 {
@@ -77,6 +78,11 @@ public:
      */
     bool fromString(const QString& area, const QRect& defaultValue = QRect(0, 0, 0, 0));
 
+    /**
+     * @see fromString(const QString&, const QRect&)
+     */
+    bool fromString(QStringView area, const QRect& defaultValue = QRect(0, 0, 0, 0));
+
     /**
      * Converts the current area to a string. The format is "x1 y1 x2 y2".
      *
@@ -21,9 +21,11 @@
 
 #include "stringutils.h"
 
+#include <QSharedData>
+
 namespace Wacom
 {
-    class TabletInformationPrivate
+    class TabletInformationPrivate : public QSharedData
     {
         public:
             /*
@@ -43,17 +45,6 @@ namespace Wacom
             bool                  isAvailable = false;
             bool                  hasButtons = false;
 
-            TabletInformationPrivate& operator= (const TabletInformationPrivate& that)
-            {
-                buttonMap    = that.buttonMap;
-                deviceMap    = that.deviceMap;
-                infoMap      = that.infoMap;
-                isAvailable  = that.isAvailable;
-                hasButtons   = that.hasButtons;
-
-                return *this;
-            }
-
             bool operator== (const TabletInformationPrivate& that) const
             {
                 // we don't care if the device is available or not
@@ -109,40 +100,34 @@ namespace Wacom
 
 using namespace Wacom;
 
-TabletInformation::TabletInformation() : d_ptr(new TabletInformationPrivate)
+TabletInformation::TabletInformation() : d(new TabletInformationPrivate)
 {
-    d_ptr->unknown.clear();
+    d->unknown.clear();
 }
 
 
-TabletInformation::TabletInformation(long tabletSerial) : d_ptr(new TabletInformationPrivate)
+TabletInformation::TabletInformation(long tabletSerial) : d(new TabletInformationPrivate)
 {
     set(TabletInfo::TabletSerial, QString::number(tabletSerial));
-    d_ptr->unknown.clear();
+    d->unknown.clear();
 }
 
 
-TabletInformation::TabletInformation(const TabletInformation& that) : d_ptr(new TabletInformationPrivate)
-{
-    operator=(that);
-}
+TabletInformation::TabletInformation(const TabletInformation& that) = default;
 
 
-TabletInformation::~TabletInformation()
-{
-    delete d_ptr;
-}
+TabletInformation::TabletInformation(TabletInformation&& that) noexcept = default;
 
 
+TabletInformation::~TabletInformation() = default;
 
-TabletInformation& TabletInformation::operator=(const TabletInformation& that)
-{
-    Q_D(TabletInformation);
 
-    d->operator= (*(that.d_ptr));
 
-    return *this;
-}
+TabletInformation& TabletInformation::operator=(const TabletInformation& that) = default;
+
+
+
+TabletInformation& TabletInformation::operator=(TabletInformation&& that) noexcept = default;
 
 
 
@@ -155,16 +140,17 @@ bool TabletInformation::operator!= (const TabletInformation& other) const
 
 bool TabletInformation::operator== (const TabletInformation& other) const
 {
-    Q_D (const TabletInformation);
-    return other.d_ptr != nullptr && d->operator== (*(other.d_ptr));
+    if (d == other.d) {
+        return true; // shared copies are always equal
+    }
+
+    return other.d != nullptr && d->operator== (*(other.d));
 }
 
 
 
 const QString& TabletInformation::get (const TabletInfo& info) const
 {
-    Q_D (const TabletInformation);
-
     TabletInformationPrivate::TabletInfoMap::const_iterator iter = d->infoMap.constFind(info.key());
 
     if (iter == d->infoMap.constEnd()) {
@@ -190,7 +176,6 @@ int TabletInformation::getInt(const TabletInfo& info) const
 
 const QMap< QString, QString >& TabletInformation::getButtonMap() const
 {
-    Q_D (const TabletInformation);
     return d->buttonMap;
 }
 
@@ -198,8 +183,6 @@ const QMap< QString, QString >& TabletInformation::getButtonMap() const
 
 const DeviceInformation* TabletInformation::getDevice (const DeviceType& deviceType) const
 {
-    Q_D (const TabletInformation);
-
     TabletInformationPrivate::DeviceInformationMap::ConstIterator iter = d->deviceMap.constFind(deviceType.key());
 
     if (iter == d->deviceMap.constEnd()) {
@@ -231,8 +214,6 @@ const QStringList TabletInformation::getDeviceList() const
 
 const QString& TabletInformation::getDeviceName (const DeviceType& device) const
 {
-    Q_D(const TabletInformation);
-
     TabletInformationPrivate::DeviceInformationMap::ConstIterator iter = d->deviceMap.find(device.key());
 
     if (iter == d->deviceMap.constEnd()) {
@@ -269,7 +250,6 @@ bool TabletInformation::hasButtons() const
 
 bool TabletInformation::hasButtonMap() const
 {
-    Q_D (const TabletInformation);
     return (d->buttonMap.size() > 0);
 }
 
@@ -292,7 +272,6 @@ bool TabletInformation::hasDevice(int deviceId) const
 
 bool TabletInformation::hasDevice (const DeviceType& device) const
 {
-    Q_D(const TabletInformation);
     return d->deviceMap.contains(device.key());
 }
 
@@ -303,7 +282,6 @@ int TabletInformation::statusLEDs() const
 
 bool TabletInformation::isAvailable() const
 {
-    Q_D(const TabletInformation);
     return d->isAvailable;
 }
 
@@ -311,8 +289,6 @@ bool TabletInformation::isAvailable() const
 
 void TabletInformation::set (const TabletInfo& info, const QString& value)
 {
-    Q_D (TabletInformation);
-
     // setting the tablet serial requires updating the id for now
     if (info == TabletInfo::TabletSerial) {
         long serial = value.toLong();
@@ -356,7 +332,6 @@ void TabletInformation::set(const TabletInfo &info, int value)
 
 void TabletInformation::setAvailable(bool value)
 {
-    Q_D(TabletInformation);
     d->isAvailable = value;
 }
 
@@ -378,7 +353,6 @@ void TabletInformation::setBool(const TabletInfo& info, const QString& value)
 
 void TabletInformation::setButtonMap(const QMap< QString, QString >& buttonMap)
 {
-    Q_D(TabletInformation);
     d->buttonMap = buttonMap;
 }
 
@@ -386,7 +360,6 @@ void TabletInformation::setButtonMap(const QMap< QString, QString >& buttonMap)
 
 void TabletInformation::setDevice (const DeviceInformation& device)
 {
-    Q_D(TabletInformation);
     d->deviceMap.insert (device.getType().key(), device);
 }
 
@@ -25,6 +25,7 @@
 #include "deviceinformation.h"
 
 #include <QMap>
+#include <QSharedDataPointer>
 #include <QString>
 #include <QStringList>
 
@@ -43,6 +44,8 @@ class TabletInformationPrivate;
  * public because D-Bus needs access to them (for now).
  *
  * When extending this class, don't forget to update the DBusTabletInterface class as well!
+ *
+ * The data is implicitly shared, copies are cheap until one of them is modified.
  */
 class TabletInformation
 {
@@ -57,9 +60,11 @@ public:
 
     TabletInformation(long tabletSerial);
     TabletInformation(const TabletInformation& that);
+    TabletInformation(TabletInformation&& that) noexcept;
     virtual ~TabletInformation();
 
     TabletInformation& operator= (const TabletInformation& that);
+    TabletInformation& operator= (TabletInformation&& that) noexcept;
 
     /**
      * Equals operator.
@@ -270,8 +275,7 @@ public:
 
 private:
 
-    Q_DECLARE_PRIVATE (TabletInformation)
-    TabletInformationPrivate *const d_ptr = nullptr;
+    QSharedDataPointer<TabletInformationPrivate> d;
 
 }; // CLASS
 }  // NAMESPACE
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tabletmapping.h"
+
+namespace Wacom {
+
+namespace TabletMapping {
+
+const QTransform calculateMatrix(const QRect& desktop, const QRect& target, const ScreenRotation& rotation, qreal aspectRatio)
+{
+    if (desktop.width() <= 0 || desktop.height() <= 0) {
+        return QTransform();
+    }
+
+    // rotate the normalized device coordinates around the center of the tablet
+    QTransform rotationMatrix;
+
+    if (rotation == ScreenRotation::CW) {
+        rotationMatrix = QTransform(0, 1, -1, 0, 1, 0);
+    } else if (rotation == ScreenRotation::CCW) {
+        rotationMatrix = QTransform(0, -1, 1, 0, 0, 1);
+    } else if (rotation == ScreenRotation::HALF) {
+        rotationMatrix = QTransform(-1, 0, 0, -1, 1, 1);
+    }
+
+    // scale the tablet to the target area, relative to the whole desktop
+    QRectF area   = letterbox(QRectF(target), aspectRatio);
+    qreal  width  = static_cast<qreal>(desktop.width());
+    qreal  height = static_cast<qreal>(desktop.height());
+
+    QTransform targetMatrix(area.width() / width, 0,
+                            0, area.height() / height,
+                            area.x() / width, area.y() / height);
+
+    return rotationMatrix * targetMatrix;
+}
+
+
+
+const QRectF letterbox(const QRectF& target, qreal aspectRatio)
+{
+    if (aspectRatio <= 0 || target.width() <= 0 || target.height() <= 0) {
+        return target;
+    }
+
+    QRectF area(target);
+
+    if (target.width() / target.height() > aspectRatio) {
+        // the target is wider than the tablet
+        area.setWidth(target.height() * aspectRatio);
+    } else {
+        // the target is higher than the tablet
+        area.setHeight(target.width() / aspectRatio);
+    }
+
+    area.moveCenter(target.center());
+
+    return area;
+}
+
+
+
+const QList<float> toPropertyValues(const QTransform& matrix)
+{
+    /*
+     *  | m11  m21  dx |
+     *  | m12  m22  dy |
+     *  | 0    0    1  |
+     */
+    return QList<float>({ static_cast<float>(matrix.m11()), static_cast<float>(matrix.m21()), static_cast<float>(matrix.dx()),
+                          static_cast<float>(matrix.m12()), static_cast<float>(matrix.m22()), static_cast<float>(matrix.dy()),
+                          0, 0, 1 });
+}
+
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TABLETMAPPING_H
+#define TABLETMAPPING_H
+
+#include "screenrotation.h"
+
+#include <QList>
+#include <QRect>
+#include <QTransform>
+
+namespace Wacom
+{
+
+/**
+ * @brief Calculates the coordinate transformation matrix of a tablet.
+ *
+ * The X server applies the "Coordinate Transformation Matrix" to normalized
+ * device coordinates in the range [0,1]. A single matrix can therefore map a
+ * tablet to any part of the desktop, rotate it and preserve its aspect ratio,
+ * which saves separate property writes whenever the driver leaves these
+ * operations to the matrix.
+ */
+namespace TabletMapping
+{
+    /**
+     * Calculates the matrix which maps a tablet to the target area of the desktop.
+     *
+     * @param desktop     The geometry of the whole desktop.
+     * @param target      The part of the desktop the tablet is mapped to.
+     * @param rotation    The rotation applied to the tablet before it is mapped.
+     *                    Only real rotations are supported, auto modes are ignored.
+     * @param aspectRatio The aspect ratio (width/height) of the tablet area after
+     *                    its rotation or 0 to stretch the tablet over the whole target.
+     *
+     * @return The transformation matrix or the identity matrix if the desktop is empty.
+     */
+    const QTransform calculateMatrix(const QRect& desktop,
+                                     const QRect& target,
+                                     const ScreenRotation& rotation = ScreenRotation::NONE,
+                                     qreal aspectRatio = 0);
+
+    /**
+     * Shrinks the target area to the given aspect ratio and centers the result
+     * inside the target area.
+     *
+     * @return The letterboxed target or the target itself if the aspect ratio is not positive.
+     */
+    const QRectF letterbox(const QRectF& target, qreal aspectRatio);
+
+    /**
+     * Converts a matrix to the row-major list of nine values expected by the
+     * "Coordinate Transformation Matrix" XInput property.
+     */
+    const QList<float> toPropertyValues(const QTransform& matrix);
+
+}; // NAMESPACE
+}  // NAMESPACE
+#endif // HEADER PROTECTION
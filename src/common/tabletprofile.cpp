@@ -22,6 +22,7 @@
 #include "logging.h"
 
 #include <QHash>
+#include <QSharedData>
 
 using namespace Wacom;
 
@@ -30,55 +31,42 @@ namespace Wacom {
   * Private class of the TabletProfile for the d-pointer
   *
   */
-class TabletProfilePrivate {
+class TabletProfilePrivate : public QSharedData {
 public:
     QHash<QString, DeviceProfile> devices;
     QString                       name;
 };
 }
 
-TabletProfile::TabletProfile() : d_ptr(new TabletProfilePrivate) {}
+TabletProfile::TabletProfile() : d(new TabletProfilePrivate) {}
 
 TabletProfile::TabletProfile(const QString& name)
-    : d_ptr(new TabletProfilePrivate)
+    : d(new TabletProfilePrivate)
 {
-    Q_D( TabletProfile );
     d->name = name;
 }
 
-TabletProfile::TabletProfile(const TabletProfile& profile)
-    : d_ptr(new TabletProfilePrivate)
-{
-    operator=(profile);
-}
+TabletProfile::TabletProfile(const TabletProfile& profile) = default;
 
-TabletProfile::~TabletProfile()
-{
-    delete this->d_ptr;
-}
+TabletProfile::TabletProfile(TabletProfile&& profile) noexcept = default;
 
+TabletProfile::~TabletProfile() = default;
+
+
+TabletProfile& TabletProfile::operator=(const TabletProfile& that) = default;
 
-TabletProfile& TabletProfile::operator=(const TabletProfile& that)
-{
-    Q_D( TabletProfile );
-    d->devices = that.d_ptr->devices;
-    d->name    = that.d_ptr->name;
-    
-    return *this;
-}
+
+TabletProfile& TabletProfile::operator=(TabletProfile&& that) noexcept = default;
 
 
 void TabletProfile::clearDevices()
 {
-    Q_D( TabletProfile );
     d->devices.clear();
 }
 
 
 const DeviceProfile TabletProfile::getDevice ( const DeviceType& device ) const
 {
-    Q_D( const TabletProfile );
-
     if (!hasDevice(device)) {
         return DeviceProfile(device);
     }
@@ -89,16 +77,12 @@ const DeviceProfile TabletProfile::getDevice ( const DeviceType& device ) const
 
 QString TabletProfile::getName() const 
 {
-    Q_D( const TabletProfile );
-
     return d->name;
 }
 
 
 bool TabletProfile::hasDevice(const DeviceType& device) const
 {
-    Q_D( const TabletProfile );
-
     return d->devices.contains(device.key());
 }
 
@@ -117,8 +101,6 @@ bool TabletProfile::hasDevice(const QString& device) const
 
 QStringList TabletProfile::listDevices() const 
 {
-    Q_D( const TabletProfile );
-
     QStringList result;
 
     // keys are all lower case, but we want to list the names as-is
@@ -137,8 +119,6 @@ QStringList TabletProfile::listDevices() const
 
 bool TabletProfile::setDevice ( const DeviceProfile& profile )
 {
-    Q_D( TabletProfile );
-
     if (profile.getName().isEmpty()) {
         return false;
     }
@@ -151,8 +131,6 @@ bool TabletProfile::setDevice ( const DeviceProfile& profile )
 
 void TabletProfile::setName(const QString& name)
 {
-    Q_D( TabletProfile );
-
     d->name = name;
 }
 
@@ -21,6 +21,7 @@
 #define TABLETPROFILE_H
 
 #include <KConfigGroup>
+#include <QSharedDataPointer>
 #include <QString>
 
 #include "deviceprofile.h"
@@ -31,6 +32,8 @@ class TabletProfilePrivate;
 
 /**
   * This class implements the profile of a single device (stylus/eraser/cursor/pad/touch)
+  *
+  * The profile data is implicitly shared, copies are cheap until one of them is modified.
   */
 class TabletProfile {
 public:
@@ -53,6 +56,13 @@ public:
      */
     TabletProfile(const TabletProfile& profile);
 
+    /**
+     * Move Constructor
+     *
+     * @param profile The profile to move from.
+     */
+    TabletProfile(TabletProfile&& profile) noexcept;
+
     /**
       * Default destructor
       */
@@ -64,6 +74,13 @@ public:
      * @param that The instance to copy.
      */
     TabletProfile& operator=(const TabletProfile& that);
+
+    /**
+     * Move operator.
+     *
+     * @param that The instance to move from.
+     */
+    TabletProfile& operator=(TabletProfile&& that) noexcept;
     
     /**
      * Clears all devices from the current profile.
@@ -130,9 +147,7 @@ public:
     void setName(const QString& name);
 
 private:
-    Q_DECLARE_PRIVATE( TabletProfile )
-
-    TabletProfilePrivate *const d_ptr; /**< d-pointer for this class */
+    QSharedDataPointer<TabletProfilePrivate> d; /**< shared d-pointer for this class */
 };
 
 }      // NAMESPACE
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tabletsnapshot.h"
+
+using namespace Wacom;
+
+namespace Wacom
+{
+    static const QString INFORMATION_PREFIX    = QLatin1String("Information/");
+    static const QString DEVICENAME_PREFIX     = QLatin1String("DeviceName/");
+    static const QString PROPERTY_PREFIX       = QLatin1String("Property/");
+    static const QString DEVICELIST_KEY        = QLatin1String("DeviceList");
+    static const QString PADBUTTONS_KEY        = QLatin1String("HasPadButtons");
+    static const QString PROFILE_KEY           = QLatin1String("Profile");
+    static const QString PROFILELIST_KEY       = QLatin1String("ProfileList");
+    static const QString ROTATIONLIST_KEY      = QLatin1String("ProfileRotationList");
+    static const QString STATEVERSION_KEY      = QLatin1String("StateVersion");
+
+    static QString propertyKey(const DeviceType& device, const Property& property)
+    {
+        return PROPERTY_PREFIX + device.key() + QLatin1Char('/') + property.key();
+    }
+}
+
+
+TabletSnapshot::TabletSnapshot()
+{
+
+}
+
+TabletSnapshot::TabletSnapshot(const QVariantMap& map) : _map(map)
+{
+
+}
+
+bool TabletSnapshot::isValid() const
+{
+    return !getInformation(TabletInfo::TabletId).isEmpty();
+}
+
+const QVariantMap& TabletSnapshot::toVariantMap() const
+{
+    return _map;
+}
+
+void TabletSnapshot::merge(const TabletSnapshot& delta)
+{
+    for (QVariantMap::const_iterator iter = delta._map.constBegin() ; iter != delta._map.constEnd() ; ++iter) {
+        _map.insert(iter.key(), iter.value());
+    }
+}
+
+uint TabletSnapshot::getStateVersion() const
+{
+    return _map.value(STATEVERSION_KEY).toUInt();
+}
+
+void TabletSnapshot::setStateVersion(uint version)
+{
+    _map.insert(STATEVERSION_KEY, version);
+}
+
+QString TabletSnapshot::getInformation(const TabletInfo& info) const
+{
+    return _map.value(INFORMATION_PREFIX + info.key()).toString();
+}
+
+void TabletSnapshot::setInformation(const TabletInfo& info, const QString& value)
+{
+    _map.insert(INFORMATION_PREFIX + info.key(), value);
+}
+
+QStringList TabletSnapshot::getDeviceList() const
+{
+    return _map.value(DEVICELIST_KEY).toStringList();
+}
+
+void TabletSnapshot::setDeviceList(const QStringList& deviceList)
+{
+    _map.insert(DEVICELIST_KEY, deviceList);
+}
+
+QString TabletSnapshot::getDeviceName(const DeviceType& device) const
+{
+    return _map.value(DEVICENAME_PREFIX + device.key()).toString();
+}
+
+void TabletSnapshot::setDeviceName(const DeviceType& device, const QString& name)
+{
+    _map.insert(DEVICENAME_PREFIX + device.key(), name);
+}
+
+bool TabletSnapshot::hasPadButtons() const
+{
+    return _map.value(PADBUTTONS_KEY).toBool();
+}
+
+void TabletSnapshot::setPadButtons(bool hasPadButtons)
+{
+    _map.insert(PADBUTTONS_KEY, hasPadButtons);
+}
+
+bool TabletSnapshot::hasProfile() const
+{
+    return _map.contains(PROFILE_KEY);
+}
+
+QString TabletSnapshot::getProfile() const
+{
+    return _map.value(PROFILE_KEY).toString();
+}
+
+void TabletSnapshot::setProfile(const QString& profile)
+{
+    _map.insert(PROFILE_KEY, profile);
+}
+
+QStringList TabletSnapshot::getProfileList() const
+{
+    return _map.value(PROFILELIST_KEY).toStringList();
+}
+
+void TabletSnapshot::setProfileList(const QStringList& profiles)
+{
+    _map.insert(PROFILELIST_KEY, profiles);
+}
+
+QStringList TabletSnapshot::getProfileRotationList() const
+{
+    return _map.value(ROTATIONLIST_KEY).toStringList();
+}
+
+void TabletSnapshot::setProfileRotationList(const QStringList& rotationList)
+{
+    _map.insert(ROTATIONLIST_KEY, rotationList);
+}
+
+bool TabletSnapshot::hasProperty(const DeviceType& device, const Property& property) const
+{
+    return _map.contains(propertyKey(device, property));
+}
+
+QString TabletSnapshot::getProperty(const DeviceType& device, const Property& property) const
+{
+    return _map.value(propertyKey(device, property)).toString();
+}
+
+void TabletSnapshot::setProperty(const DeviceType& device, const Property& property, const QString& value)
+{
+    _map.insert(propertyKey(device, property), value);
+}
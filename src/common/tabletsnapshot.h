@@ -0,0 +1,114 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TABLETSNAPSHOT_H
+#define TABLETSNAPSHOT_H
+
+#include "devicetype.h"
+#include "property.h"
+#include "tabletinfo.h"
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+namespace Wacom
+{
+
+/**
+ * @brief A typed view on the tablet snapshot transferred over D-Bus.
+ *
+ * The tablet daemon collects everything a client needs to display a tablet
+ * into one flat a{sv} map, so the kcmodule and the data engine can fetch it
+ * with a single D-Bus call instead of one call per value. This class hides the
+ * key layout of that map from both sides.
+ *
+ * All values are stored as strings, string lists or booleans, so the map can
+ * be sent over D-Bus without any custom marshalling.
+ */
+class TabletSnapshot
+{
+
+public:
+    TabletSnapshot();
+    explicit TabletSnapshot(const QVariantMap& map);
+
+    /**
+     * @return True if the snapshot contains a tablet, false if it is empty.
+     */
+    bool isValid() const;
+
+    /**
+     * @return The snapshot as a map which can be sent over D-Bus.
+     */
+    const QVariantMap& toVariantMap() const;
+
+    /**
+     * Applies a delta to this snapshot. Every value contained in the delta
+     * replaces the value of this snapshot, including the state version.
+     *
+     * @param delta A partial snapshot as sent by the stateChanged D-Bus signal.
+     */
+    void merge(const TabletSnapshot& delta);
+
+    /**
+     * The daemon increases the state version of a tablet whenever it publishes
+     * a delta, so clients can detect missed deltas and fetch a new snapshot.
+     *
+     * @return The state version or 0 if the snapshot does not contain one.
+     */
+    uint getStateVersion() const;
+    void setStateVersion(uint version);
+
+    QString getInformation(const TabletInfo& info) const;
+    void setInformation(const TabletInfo& info, const QString& value);
+
+    QStringList getDeviceList() const;
+    void setDeviceList(const QStringList& deviceList);
+
+    QString getDeviceName(const DeviceType& device) const;
+    void setDeviceName(const DeviceType& device, const QString& name);
+
+    bool hasPadButtons() const;
+    void setPadButtons(bool hasPadButtons);
+
+    bool hasProfile() const;
+    QString getProfile() const;
+    void setProfile(const QString& profile);
+
+    QStringList getProfileList() const;
+    void setProfileList(const QStringList& profiles);
+
+    QStringList getProfileRotationList() const;
+    void setProfileRotationList(const QStringList& rotationList);
+
+    /**
+     * Checks if the snapshot contains a live value of the given property.
+     * Only a selected set of properties is part of a snapshot.
+     */
+    bool hasProperty(const DeviceType& device, const Property& property) const;
+
+    QString getProperty(const DeviceType& device, const Property& property) const;
+    void setProperty(const DeviceType& device, const Property& property, const QString& value);
+
+private:
+    QVariantMap _map;
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
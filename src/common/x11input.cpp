@@ -20,16 +20,42 @@
 #include "x11input.h"
 
 
+#include <QHash>
 #include <QList>
+#include <QMutex>
+#include <QMutexLocker>
 
 #include "private/qtx11extras_p.h"
 
 #include <xorg/wacom-properties.h>
 
 #include <X11/extensions/XInput.h>
+#include <xcb/xcb.h>
 
 using namespace Wacom;
 
+namespace Wacom
+{
+    /**
+     * Atoms by name and names by atom. Devices are configured from the
+     * reconfiguration threads of different tablets, so the cache is
+     * protected by a mutex.
+     */
+    class X11AtomCache
+    {
+        public:
+            static X11AtomCache& instance()
+            {
+                static X11AtomCache cache;
+                return cache;
+            }
+
+            QMutex                                mutex;
+            QHash<QString, X11InputDevice::Atom>  atoms;
+            QHash<X11InputDevice::Atom, QString>  names;
+    };
+}
+
 const QString X11Input::PROPERTY_DEVICE_PRODUCT_ID = QLatin1String ("Device Product ID");
 const QString X11Input::PROPERTY_DEVICE_NODE       = QLatin1String ("Device Node");
 const QString X11Input::PROPERTY_TRANSFORM_MATRIX  = QLatin1String ("Coordinate Transformation Matrix");
@@ -65,6 +91,78 @@ bool X11Input::findDevice(const QString& deviceName, X11InputDevice& device)
 }
 
 
+X11InputDevice::Atom X11Input::lookupAtom(const QString& name)
+{
+    if (name.isEmpty()) {
+        return XCB_ATOM_NONE;
+    }
+
+    X11AtomCache& cache = X11AtomCache::instance();
+    QMutexLocker  locker(&cache.mutex);
+
+    auto cached = cache.atoms.constFind(name);
+
+    if (cached != cache.atoms.constEnd()) {
+        return cached.value();
+    }
+
+    const QByteArray         latinName = name.toLatin1();
+    xcb_intern_atom_cookie_t cookie    = xcb_intern_atom(QX11Info::connection(), false, latinName.length(), latinName.constData());
+    xcb_intern_atom_reply_t* reply     = xcb_intern_atom_reply(QX11Info::connection(), cookie, nullptr);
+
+    X11InputDevice::Atom atom = XCB_ATOM_NONE;
+
+    if (reply) {
+        atom = reply->atom;
+        free(reply);
+    }
+
+    // failed lookups are not cached, the connection might just be gone for now
+    if (atom != XCB_ATOM_NONE) {
+        cache.atoms.insert(name, atom);
+        cache.names.insert(atom, name);
+    }
+
+    return atom;
+}
+
+
+
+QString X11Input::getAtomName(X11InputDevice::Atom atom)
+{
+    if (atom == XCB_ATOM_NONE) {
+        return QString();
+    }
+
+    X11AtomCache& cache = X11AtomCache::instance();
+    QMutexLocker  locker(&cache.mutex);
+
+    auto cached = cache.names.constFind(atom);
+
+    if (cached != cache.names.constEnd()) {
+        return cached.value();
+    }
+
+    xcb_get_atom_name_cookie_t cookie = xcb_get_atom_name(QX11Info::connection(), atom);
+    xcb_get_atom_name_reply_t* reply  = xcb_get_atom_name_reply(QX11Info::connection(), cookie, nullptr);
+
+    QString name;
+
+    if (reply) {
+        name = QString::fromLatin1(xcb_get_atom_name_name(reply), xcb_get_atom_name_name_length(reply));
+        free(reply);
+    }
+
+    if (!name.isEmpty()) {
+        cache.atoms.insert(name, atom);
+        cache.names.insert(atom, name);
+    }
+
+    return name;
+}
+
+
+
 void X11Input::scanDevices(X11InputVisitor& visitor)
 {
     int      ndevices = 0;
@@ -56,6 +56,26 @@ public:
      */
     static bool findDevice (const QString& deviceName, X11InputDevice& device);
 
+    /**
+     * Looks up the atom of a name. Atoms never change while the X server is
+     * running, so all lookups are cached and only the first one of a name
+     * has to ask the X server.
+     *
+     * @param name The name of the atom.
+     *
+     * @return The atom or XCB_ATOM_NONE if it could not be looked up.
+     */
+    static X11InputDevice::Atom lookupAtom (const QString& name);
+
+    /**
+     * Gets the name of an atom. The result is cached like the result of lookupAtom().
+     *
+     * @param atom The atom to get the name of.
+     *
+     * @return The name of the atom or an empty string if the atom is unknown.
+     */
+    static QString getAtomName (X11InputDevice::Atom atom);
+
     /**
      * Iterates over all X11 input devices and passes each device to the
      * visitor object. The visitor can then decide either to continue
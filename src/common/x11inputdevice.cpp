@@ -18,9 +18,15 @@
  */
 
 #include "logging.h"
+#include "x11input.h"
 #include "x11inputdevice.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
 #include <QStringList>
+#include <QWeakPointer>
 
 #include "private/qtx11extras_p.h"
 
@@ -32,26 +38,71 @@ using namespace Wacom;
  * Class for private members.
  */
 namespace Wacom {
+    /**
+     * An opened XInput device. All X11InputDevice instances which use the
+     * same device id share one handle, the device is closed when the last
+     * one releases it. Devices are opened and closed from the reconfiguration
+     * threads of different tablets, so the registry is protected by a mutex.
+     */
+    class X11InputDeviceHandle
+    {
+        public:
+            explicit X11InputDeviceHandle(uint8_t id) : deviceid(id) {}
+
+            ~X11InputDeviceHandle()
+            {
+                QMutexLocker locker(&openHandlesMutex());
+
+                auto handle = openHandles().find(deviceid);
+
+                if (handle != openHandles().end()) {
+                    if (!handle.value().isNull()) {
+                        return; // the device was opened again in the meantime
+                    }
+
+                    openHandles().erase(handle);
+                }
+
+                xcb_input_close_device(QX11Info::connection(), deviceid);
+            }
+
+            //! All handles which are currently open, by device id.
+            static QHash<uint8_t, QWeakPointer<X11InputDeviceHandle> >& openHandles()
+            {
+                static QHash<uint8_t, QWeakPointer<X11InputDeviceHandle> > handles;
+                return handles;
+            }
+
+            //! The mutex which protects the open handles.
+            static QMutex& openHandlesMutex()
+            {
+                static QMutex mutex;
+                return mutex;
+            }
+
+            const uint8_t deviceid;
+    };
+
     class X11InputDevicePrivate
     {
         public:
             QString name;
-            uint8_t deviceid;
+            QSharedPointer<X11InputDeviceHandle> handle;
+
+            uint8_t deviceid() const
+            {
+                return handle ? handle->deviceid : 0;
+            }
     };
 }
 
 
 X11InputDevice::X11InputDevice() : d_ptr(new X11InputDevicePrivate)
 {
-    Q_D(X11InputDevice);
-    d->deviceid = 0;
 }
 
 X11InputDevice::X11InputDevice(X11InputDevice::XID id, const QString& name) : d_ptr(new X11InputDevicePrivate)
 {
-    Q_D(X11InputDevice);
-    d->deviceid = 0;
-
     open(id, name);
 }
 
@@ -59,16 +110,20 @@ X11InputDevice::X11InputDevice(X11InputDevice::XID id, const QString& name) : d_
 
 X11InputDevice::X11InputDevice(const X11InputDevice& device) : d_ptr(new X11InputDevicePrivate)
 {
-    Q_D(X11InputDevice);
-    d->deviceid = 0;
-
     operator=(device);
 }
 
 
+
+X11InputDevice::X11InputDevice(X11InputDevice&& device) : d_ptr(new X11InputDevicePrivate)
+{
+    operator=(std::move(device));
+}
+
+
 X11InputDevice::~X11InputDevice()
 {
-    close();
+    // releasing the handle closes the device if we are the last user
     delete d_ptr;
 }
 
@@ -76,13 +131,26 @@ X11InputDevice::~X11InputDevice()
 
 X11InputDevice& X11InputDevice::operator= (const X11InputDevice& that)
 {
-    // close current device
-    close();
+    Q_D(X11InputDevice);
 
-    // connect new device
-    if (that.d_ptr->deviceid) {
-        open(that.d_ptr->deviceid, that.d_ptr->name);
-    }
+    // share the handle of the other device, no need to open it again
+    d->handle = that.d_ptr->handle;
+    d->name   = that.d_ptr->name;
+
+    return *this;
+}
+
+
+
+X11InputDevice& X11InputDevice::operator= (X11InputDevice&& that) noexcept
+{
+    Q_D(X11InputDevice);
+
+    d->handle = std::move(that.d_ptr->handle);
+    d->name   = std::move(that.d_ptr->name);
+
+    that.d_ptr->handle.reset();
+    that.d_ptr->name.clear();
 
     return *this;
 }
@@ -93,14 +161,12 @@ bool X11InputDevice::close()
 {
     Q_D(X11InputDevice);
 
-    if (d->deviceid == 0) {
+    if (!d->handle) {
         qCWarning(COMMON) << "d->name.isEmpty?" << d->name.isEmpty();
         return false;
     }
 
-    xcb_input_close_device(QX11Info::connection(), d->deviceid);
-
-    d->deviceid  = 0;
+    d->handle.reset();
     d->name.clear();
 
     return true;
@@ -126,7 +192,7 @@ const QVector<uint8_t> X11InputDevice::getDeviceButtonMapping() const
 
     int buttonCount = 0;
 
-    xcb_input_get_device_button_mapping_cookie_t cookie = xcb_input_get_device_button_mapping(QX11Info::connection(), d->deviceid);
+    xcb_input_get_device_button_mapping_cookie_t cookie = xcb_input_get_device_button_mapping(QX11Info::connection(), d->deviceid());
     xcb_input_get_device_button_mapping_reply_t* reply = xcb_input_get_device_button_mapping_reply(QX11Info::connection(), cookie, nullptr);
 
     if (!reply) {
@@ -155,7 +221,7 @@ long X11InputDevice::getDeviceId() const
         return 0;
     }
 
-    return d->deviceid;
+    return d->deviceid();
 }
 
 
@@ -166,15 +232,7 @@ bool X11InputDevice::getFloatProperty(const QString& property, QList< float >& v
         return false;
     }
 
-    xcb_intern_atom_cookie_t cookie = xcb_intern_atom(QX11Info::connection(), false, strlen("FLOAT"), "FLOAT");
-    xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(QX11Info::connection(), cookie, nullptr);
-
-    xcb_atom_t expectedType = XCB_ATOM_NONE;
-
-    if (reply) {
-        expectedType = reply->atom;
-        free(reply);
-    }
+    xcb_atom_t expectedType = X11Input::lookupAtom(QLatin1String("FLOAT"));
 
     if (expectedType == XCB_ATOM_NONE) {
         qCWarning(COMMON) << QLatin1String("Float values are unsupported by this XInput implementation!");
@@ -248,7 +306,7 @@ bool X11InputDevice::hasProperty(const QString& property) const
 
     bool  found  = false;
 
-    xcb_input_list_device_properties_cookie_t cookie = xcb_input_list_device_properties(QX11Info::connection(), d->deviceid);
+    xcb_input_list_device_properties_cookie_t cookie = xcb_input_list_device_properties(QX11Info::connection(), d->deviceid());
     xcb_input_list_device_properties_reply_t* reply = xcb_input_list_device_properties_reply(QX11Info::connection(), cookie, nullptr);
 
     if (reply) {
@@ -271,7 +329,7 @@ bool X11InputDevice::hasProperty(const QString& property) const
 bool X11InputDevice::isOpen() const
 {
     Q_D(const X11InputDevice);
-    return (d->deviceid != 0);
+    return (d->deviceid() != 0);
 }
 
 
@@ -295,17 +353,28 @@ bool X11InputDevice::open(X11InputDevice::XID id, const QString& name)
         return false;
     }
 
-    xcb_input_open_device_cookie_t cookie = xcb_input_open_device(QX11Info::connection(), id);
-    xcb_input_open_device_reply_t* reply = xcb_input_open_device_reply(QX11Info::connection(), cookie, nullptr);
+    // reuse the handle if the device is already open somewhere else in this process
+    QMutexLocker                         locker(&X11InputDeviceHandle::openHandlesMutex());
+    QSharedPointer<X11InputDeviceHandle> handle = X11InputDeviceHandle::openHandles().value(id).toStrongRef();
 
-    if (reply == nullptr) {
-        // some virtual devices can not be opened
-        qCDebug(COMMON) << QString::fromLatin1("XOpenDevice failed on device id '%1'!").arg(id);
-        return false;
+    if (!handle) {
+        xcb_input_open_device_cookie_t cookie = xcb_input_open_device(QX11Info::connection(), id);
+        xcb_input_open_device_reply_t* reply = xcb_input_open_device_reply(QX11Info::connection(), cookie, nullptr);
+
+        if (reply == nullptr) {
+            // some virtual devices can not be opened
+            qCDebug(COMMON) << QString::fromLatin1("XOpenDevice failed on device id '%1'!").arg(id);
+            return false;
+        }
+        free(reply);
+
+        handle = QSharedPointer<X11InputDeviceHandle>::create(id);
+        X11InputDeviceHandle::openHandles().insert(id, handle);
     }
-    free(reply);
 
-    d->deviceid  = id;
+    locker.unlock();
+
+    d->handle  = handle;
     d->name    = name;
 
     return true;
@@ -322,7 +391,7 @@ bool X11InputDevice::setDeviceButtonMapping(const QVector<uint8_t> &buttonMap) c
     }
 
     xcb_input_set_device_button_mapping_cookie_t cookie =
-            xcb_input_set_device_button_mapping(QX11Info::connection(), d->deviceid, static_cast<uint8_t>(buttonMap.size()), buttonMap.data());
+            xcb_input_set_device_button_mapping(QX11Info::connection(), d->deviceid(), static_cast<uint8_t>(buttonMap.size()), buttonMap.data());
     xcb_input_set_device_button_mapping_reply_t* reply = xcb_input_set_device_button_mapping_reply(QX11Info::connection(), cookie, nullptr);
 
     uint8_t result = 1;
@@ -374,15 +443,7 @@ bool X11InputDevice::setFloatProperty(const QString& property, const QList< floa
         return false;
     }
 
-    xcb_intern_atom_cookie_t cookie = xcb_intern_atom(QX11Info::connection(), false, strlen("FLOAT"), "FLOAT");
-    xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(QX11Info::connection(), cookie, nullptr);
-
-    xcb_atom_t expectedType = XCB_ATOM_NONE;
-
-    if (reply) {
-        expectedType = reply->atom;
-        free(reply);
-    }
+    xcb_atom_t expectedType = X11Input::lookupAtom(QLatin1String("FLOAT"));
 
     if (expectedType == XCB_ATOM_NONE) {
         qCWarning(COMMON) << QLatin1String("Float values are unsupported by this XInput implementation!");
@@ -490,7 +551,7 @@ xcb_input_get_device_property_reply_t* X11InputDevice::getPropertyData (const QS
     Atom           actualType   = XCB_ATOM_NONE;
     int            actualFormat = 0;
 
-    xcb_input_get_device_property_cookie_t cookie = xcb_input_get_device_property(QX11Info::connection(), propertyAtom, XCB_ATOM_ANY, 0, nelements, d->deviceid, false);
+    xcb_input_get_device_property_cookie_t cookie = xcb_input_get_device_property(QX11Info::connection(), propertyAtom, XCB_ATOM_ANY, 0, nelements, d->deviceid(), false);
     xcb_input_get_device_property_reply_t* reply = xcb_input_get_device_property_reply(QX11Info::connection(), cookie, nullptr);
 
     if (reply) {
@@ -518,15 +579,7 @@ bool X11InputDevice::lookupProperty(const QString& property, X11InputDevice::Ato
         return false;
     }
 
-    xcb_intern_atom_cookie_t cookie = xcb_intern_atom(QX11Info::connection(), false, property.toLatin1().length(), property.toLatin1().constData());
-    xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(QX11Info::connection(), cookie, nullptr);
-
-    if (reply) {
-        atom = reply->atom;
-        free(reply);
-    } else {
-        atom = XCB_ATOM_NONE;
-    }
+    atom = X11Input::lookupAtom(property);
 
     if (atom == XCB_ATOM_NONE) {
         qCWarning(COMMON) << QString::fromLatin1("The X server does not support XInput property '%1'!").arg(property);
@@ -568,7 +621,7 @@ bool X11InputDevice::setProperty(const QString& property, X11InputDevice::Atom e
     Atom           actualType;
     int            actualFormat;
 
-    xcb_input_get_device_property_cookie_t cookie = xcb_input_get_device_property(QX11Info::connection(), propertyAtom, XCB_ATOM_ANY, 0, values.size(), d->deviceid, false);
+    xcb_input_get_device_property_cookie_t cookie = xcb_input_get_device_property(QX11Info::connection(), propertyAtom, XCB_ATOM_ANY, 0, values.size(), d->deviceid(), false);
     xcb_input_get_device_property_reply_t* reply = xcb_input_get_device_property_reply(QX11Info::connection(), cookie, nullptr);
 
     if (reply) {
@@ -593,7 +646,7 @@ bool X11InputDevice::setProperty(const QString& property, X11InputDevice::Atom e
         memcpy(data + i, &value, sizeof(uint32_t));
     }
 
-    xcb_input_change_device_property(QX11Info::connection(), propertyAtom, expectedType, d->deviceid, 32, XCB_PROP_MODE_REPLACE, values.size(), data);
+    xcb_input_change_device_property(QX11Info::connection(), propertyAtom, expectedType, d->deviceid(), 32, XCB_PROP_MODE_REPLACE, values.size(), data);
 
     // cleanup
     delete[] data;
@@ -34,6 +34,9 @@ class X11InputDevicePrivate;
 /**
  * XInput device implementation. It offers access to all X11 input
  * properties and some helper methods for tablet detection.
+ *
+ * Copies share the opened device. A device is opened once per process
+ * and closed when the last instance using it is closed or destroyed.
  */
 class X11InputDevice
 {
@@ -55,22 +58,33 @@ public:
     X11InputDevice (XID id, const QString& name);
 
     /**
-     * Copy Constructor
+     * Copy Constructor, shares the opened device.
      */
     X11InputDevice (const X11InputDevice& device);
 
+    /**
+     * Move Constructor, takes over the opened device.
+     */
+    X11InputDevice (X11InputDevice&& device);
+
     /**
      * Default Destructor
      */
     virtual ~X11InputDevice();
 
     /**
-     * Copy Operator
+     * Copy Operator, shares the opened device.
      */
     X11InputDevice& operator= (const X11InputDevice& that);
 
     /**
-     * Closes this device.
+     * Move Operator, takes over the opened device.
+     */
+    X11InputDevice& operator= (X11InputDevice&& that) noexcept;
+
+    /**
+     * Closes this device. The X11 device itself is only closed if no
+     * other instance uses it anymore.
      *
      * @return True if the device was successfully closed, else false.
      */
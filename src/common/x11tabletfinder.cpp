@@ -0,0 +1,278 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "x11tabletfinder.h"
+
+#include "logging.h"
+#include "deviceinformation.h"
+#include "x11input.h"
+
+#include <xcb/xcb.h>
+#include <xcb/xinput.h>
+
+#include <QByteArray>
+#include <QString>
+#include <QMap>
+
+#include "private/qtx11extras_p.h"
+
+using namespace Wacom;
+
+/**
+ * Class for private members.
+ */
+namespace Wacom {
+    class X11TabletFinderPrivate
+    {
+        public:
+            typedef QMap<long,TabletInformation> TabletMap;
+
+            TabletMap                tabletMap;   //!< A map which is used while visiting devices.
+            QList<TabletInformation> scannedList; //!< A list which is build after scanning all devices.
+    };
+}
+
+
+struct X11TabletFinder::DeviceProperties
+{
+    long    deviceId  = 0;
+    QString toolType;       //!< The name of the wacom tool type atom.
+    long    serial    = 0;  //!< The tablet id, the first value of the wacom serial ids.
+    long    vendorId  = 0;
+    long    productId = 0;
+    QString deviceNode;     //!< The full path to the input device.
+};
+
+
+X11TabletFinder::X11TabletFinder() : d_ptr(new X11TabletFinderPrivate)
+{
+}
+
+
+X11TabletFinder::~X11TabletFinder()
+{
+    delete d_ptr;
+}
+
+
+
+const QList< TabletInformation >& X11TabletFinder::getTablets() const
+{
+    Q_D (const X11TabletFinder);
+
+    return d->scannedList;
+}
+
+
+
+
+bool X11TabletFinder::scanDevices()
+{
+    Q_D (X11TabletFinder);
+
+    d->tabletMap.clear();
+    d->scannedList.clear();
+
+    X11Input::scanDevices(*this);
+
+    X11TabletFinderPrivate::TabletMap::ConstIterator iter;
+
+    for (iter = d->tabletMap.constBegin() ; iter != d->tabletMap.constEnd() ; ++iter) {
+        d->scannedList.append(iter.value());
+    }
+
+    return (d->tabletMap.size() > 0);
+}
+
+
+
+bool X11TabletFinder::visit (X11InputDevice& x11device)
+{
+    if (!x11device.isTabletDevice()) {
+        return false;
+    }
+
+    // gather basic device information which we need to create a device information structure
+    DeviceProperties properties;
+    readDeviceProperties(x11device, properties);
+
+    QString           deviceName = x11device.getName();
+    const DeviceType* deviceType = getDeviceType (properties.toolType);
+
+    if (deviceName.isEmpty() || deviceType == nullptr) {
+        qCWarning(COMMON) << QString::fromLatin1("Unsupported device '%1' detected!").arg(deviceName);
+        return false;
+    }
+
+    // create device information and gather all information we can
+    DeviceInformation deviceInfo (*deviceType, x11device.getName());
+
+    gatherDeviceInformation(properties, deviceInfo);
+
+    // add device information to tablet map
+    addDeviceInformation(deviceInfo);
+
+    // true is only returned if device visiting should be aborted by X11Input
+    return false;
+}
+
+
+
+void X11TabletFinder::addDeviceInformation (DeviceInformation& deviceInformation)
+{
+    Q_D(X11TabletFinder);
+
+    long serial = deviceInformation.getTabletSerial();
+
+    if (serial < 1) {
+        qCDebug(COMMON) << QString::fromLatin1("Device '%1' has an invalid serial number '%2'!").arg(deviceInformation.getName()).arg(serial);
+    }
+
+    X11TabletFinderPrivate::TabletMap::iterator mapIter = d->tabletMap.find (serial);
+
+    if (mapIter == d->tabletMap.end()) {
+        auto newTabletInformation = TabletInformation(serial);
+        // LibWacom needs CompanyId so set it too
+        newTabletInformation.set(TabletInfo::CompanyId, QString::fromLatin1("%1").arg(deviceInformation.getVendorId(), 4, 16, QLatin1Char('0')).toUpper());
+        mapIter = d->tabletMap.insert(serial, newTabletInformation);
+    }
+
+    mapIter.value().setDevice(deviceInformation);
+}
+
+
+
+void X11TabletFinder::gatherDeviceInformation(const DeviceProperties& properties, DeviceInformation& deviceInformation) const
+{
+    deviceInformation.setDeviceId(properties.deviceId);
+    deviceInformation.setTabletSerial(properties.serial);
+
+    // product and vendor id are optional
+    if (properties.vendorId > 0) {
+        deviceInformation.setVendorId(properties.vendorId);
+    }
+
+    if (properties.productId > 0) {
+        deviceInformation.setProductId(properties.productId);
+    }
+
+    deviceInformation.setDeviceNode(properties.deviceNode);
+}
+
+
+
+const DeviceType* X11TabletFinder::getDeviceType (const QString& toolType) const
+{
+    if (toolType.contains (QLatin1String ("pad"), Qt::CaseInsensitive)) {
+        return &(DeviceType::Pad);
+
+    } else if (toolType.contains(QLatin1String ("eraser"), Qt::CaseInsensitive)) {
+        return &(DeviceType::Eraser);
+
+    } else if (toolType.contains(QLatin1String ("cursor"), Qt::CaseInsensitive)) {
+        return &(DeviceType::Cursor);
+
+    } else if (toolType.contains(QLatin1String ("touch"),  Qt::CaseInsensitive)) {
+        return &(DeviceType::Touch);
+
+    } else if (toolType.contains(QLatin1String ("stylus"), Qt::CaseInsensitive)) {
+        return &(DeviceType::Stylus);
+    }
+
+    return nullptr;
+}
+
+
+
+void X11TabletFinder::readDeviceProperties(X11InputDevice& device, DeviceProperties& properties) const
+{
+    enum { ToolType, SerialIds, ProductId, DeviceNode, PropertyCount };
+
+    // the properties and the number of values we need from each of them
+    static const QString names[PropertyCount]     = { X11Input::PROPERTY_WACOM_TOOL_TYPE, X11Input::PROPERTY_WACOM_SERIAL_IDS,
+                                                      X11Input::PROPERTY_DEVICE_PRODUCT_ID, X11Input::PROPERTY_DEVICE_NODE };
+    static const long    nelements[PropertyCount] = { 1, 1, 2, 1000 };
+
+    xcb_connection_t*  connection = QX11Info::connection();
+    const uint8_t      deviceId   = static_cast<uint8_t>(device.getDeviceId());
+
+    properties.deviceId = device.getDeviceId();
+
+    if (!connection || deviceId == 0) {
+        return;
+    }
+
+    // send all requests first, the X server answers them in order
+    xcb_input_get_device_property_cookie_t cookies[PropertyCount];
+    bool                                   isRequested[PropertyCount];
+
+    for (int i = 0 ; i < PropertyCount ; ++i) {
+        const xcb_atom_t atom = X11Input::lookupAtom(names[i]);
+
+        isRequested[i] = (atom != XCB_ATOM_NONE);
+
+        if (isRequested[i]) {
+            cookies[i] = xcb_input_get_device_property(connection, atom, XCB_ATOM_ANY, 0, nelements[i], deviceId, false);
+        }
+    }
+
+    // collect the replies
+    for (int i = 0 ; i < PropertyCount ; ++i) {
+        if (!isRequested[i]) {
+            continue;
+        }
+
+        xcb_input_get_device_property_reply_t* reply = xcb_input_get_device_property_reply(connection, cookies[i], nullptr);
+
+        if (!reply) {
+            continue;
+        }
+
+        const void* items  = xcb_input_get_device_property_items(reply);
+        const long  nitems = reply->num_items;
+
+        if (reply->format == 32 && nitems > 0) {
+            const uint32_t* values = static_cast<const uint32_t*>(items);
+
+            if (i == ToolType && reply->type == XCB_ATOM_ATOM) {
+                properties.toolType = X11Input::getAtomName(values[0]);
+
+            } else if (i == SerialIds && reply->type == XCB_ATOM_INTEGER) {
+                // the offset for the tablet id is 0 see wacom-properties.h in the xf86-input-wacom driver for more information on this
+                properties.serial = values[0];
+
+            } else if (i == ProductId && reply->type == XCB_ATOM_INTEGER && nitems == 2) {
+                properties.vendorId  = values[0];
+                properties.productId = values[1];
+            }
+
+        } else if (i == DeviceNode && reply->format == 8 && reply->type == XCB_ATOM_STRING && nitems > 0) {
+            // the value is terminated by '\0' or the end of the data
+            const char* data = static_cast<const char*>(items);
+            properties.deviceNode = QString::fromLatin1(data, qstrnlen(data, nitems));
+        }
+
+        free(reply);
+    }
+
+    if (properties.deviceNode.isEmpty()) {
+        qCDebug(COMMON) << QString::fromLatin1("Could not get device node from device '%1'!").arg(device.getName());
+    }
+}
@@ -76,20 +76,18 @@ private:
     void addDeviceInformation (Wacom::DeviceInformation& deviceInformation);
 
     /**
-     * Gather all information about the given x11 device and write the data
-     * into the device information structure.
-     *
-     * @param device The device to gather information about.
-     * @param deviceInformation The device information structure which will contain all data.
+     * The properties of an XInput device we need to create a device information structure.
      */
-    void gatherDeviceInformation (X11InputDevice& device, DeviceInformation& deviceInformation) const;
+    struct DeviceProperties;
 
     /**
-     * Gets the device node of the given device.
+     * Gather all information about the given x11 device and write the data
+     * into the device information structure.
      *
-     * @return The device node or an empty string if not set.
+     * @param properties The properties read from the device.
+     * @param deviceInformation The device information structure which will contain all data.
      */
-    const QString getDeviceNode (Wacom::X11InputDevice& device) const;
+    void gatherDeviceInformation (const DeviceProperties& properties, DeviceInformation& deviceInformation) const;
 
     /**
      * Determines the device type base on the given toolTyple.
@@ -99,31 +97,15 @@ private:
     const DeviceType* getDeviceType (const QString& toolType) const;
 
     /**
-     * Gets the product and vendor id if set. These are usually the company and
-     * product id of the USB device. However the information is optional and might
-     * not be set.
-     *
-     * @param device The device to get the information from.
-     * @param vendorId A reference to a long value which will contain the vendor id.
-     * @param productId A reference to a long value which will contain the product id.
-     *
-     * @return True if it least one value was set, else false.
-     */
-    bool getProductId (X11InputDevice& device, long& vendorId, long& productId) const;
-
-    /**
-     * Gets the tablet id of this device.
-     *
-     * @return The tablet id or 0 on error.
-     */
-    long getTabletSerial (X11InputDevice& device) const;
-
-    /**
-     * Gets the tool type name from the wacom tool type property.
+     * Reads all properties we are interested in from the given device. All
+     * properties are requested before the first reply is read, so this takes
+     * a single round trip to the X server instead of one per property.
+     * Properties which are not set on the device keep their default values.
      *
-     * @return The tool type name on success, an empty string on error.
+     * @param device The device to read the properties from.
+     * @param properties A reference to the structure which receives the values.
      */
-    const QString getToolType (X11InputDevice& device) const;
+    void readDeviceProperties (X11InputDevice& device, DeviceProperties& properties) const;
 
 
 private:
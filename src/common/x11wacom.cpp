@@ -20,6 +20,7 @@
 #include "x11wacom.h"
 
 #include "logging.h"
+#include "tabletmapping.h"
 #include "x11input.h"
 #include "x11inputdevice.h"
 
@@ -103,7 +104,7 @@ bool X11Wacom::isScrollDirectionInverted(const QString& deviceName)
 }
 
 
-bool X11Wacom::setCoordinateTransformationMatrix(const QString& deviceName, qreal offsetX, qreal offsetY, qreal width, qreal height)
+bool X11Wacom::setCoordinateTransformationMatrix(const QString& deviceName, const QTransform& matrix)
 {
     X11InputDevice device;
 
@@ -111,23 +112,7 @@ bool X11Wacom::setCoordinateTransformationMatrix(const QString& deviceName, qrea
         return false;
     }
 
-    /*
-     *  | width  0       offsetX |
-     *  | 0      height  offsetY |
-     *  | 0      0          1    |
-     */
-    QList<float> matrix;
-    matrix.append(width);
-    matrix.append(0);
-    matrix.append(offsetX);
-    matrix.append(0);
-    matrix.append(height);
-    matrix.append(offsetY);
-    matrix.append(0);
-    matrix.append(0);
-    matrix.append(1);
-
-    return device.setFloatProperty(X11Input::PROPERTY_TRANSFORM_MATRIX, matrix);
+    return device.setFloatProperty(X11Input::PROPERTY_TRANSFORM_MATRIX, TabletMapping::toPropertyValues(matrix));
 }
 
 
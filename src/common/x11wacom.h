@@ -25,6 +25,7 @@
 
 #include <QRectF>
 #include <QString>
+#include <QTransform>
 
 namespace Wacom
 {
@@ -56,11 +57,11 @@ public:
     static bool isScrollDirectionInverted(const QString& deviceName);
 
     /**
-     * Sets the coordinate transformation property on the given device.
+     * Sets a full 3x3 coordinate transformation matrix on the given device.
      *
      * @return True on success, false on error.
      */
-    static bool setCoordinateTransformationMatrix(const QString& deviceName, qreal offsetX, qreal offsetY, qreal width, qreal height);
+    static bool setCoordinateTransformationMatrix(const QString& deviceName, const QTransform& matrix);
 
     /**
      * Sets the scroll direction on a device.
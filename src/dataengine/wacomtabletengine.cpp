@@ -17,7 +17,10 @@
  */
 #include "wacomtabletengine.h"
 #include "wacomtabletservice.h"
-#include "multidbuspendingcallwatcher.h"
+#include "stringutils.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 
 using namespace Wacom;
 
@@ -55,14 +58,19 @@ void WacomTabletEngine::onDBusConnected()
 
     connect( &DBusTabletInterface::instance(), SIGNAL(tabletAdded(QString)),    this, SLOT(onTabletAdded(QString)) );
     connect( &DBusTabletInterface::instance(), SIGNAL(tabletRemoved(QString)),  this, SLOT(onTabletRemoved(QString)) );
-    connect( &DBusTabletInterface::instance(), SIGNAL(profileChanged(QString,QString)), this, SLOT(setProfile(QString,QString)) );
+    connect( &DBusTabletInterface::instance(), SIGNAL(stateChanged(QString,uint,QVariantMap)), this, SLOT(onStateChanged(QString,uint,QVariantMap)) );
 
     // get list of connected tablets
-    QDBusReply<QStringList> connectedTablets = DBusTabletInterface::instance().getTabletList();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusTabletInterface::instance().getTabletList(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, [this](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
 
-    foreach(const QString &tabletId, connectedTablets.value()) {
-        onTabletAdded(tabletId);
-    }
+        QDBusPendingReply<QStringList> connectedTablets = *call;
+
+        foreach(const QString &tabletId, connectedTablets.value()) {
+            onTabletAdded(tabletId);
+        }
+    });
 }
 
 void WacomTabletEngine::onDBusDisconnected()
@@ -81,72 +89,102 @@ void WacomTabletEngine::onTabletAdded(const QString& tabletId)
         return;
     }
 
-    QDBusReply<bool> isTouchSensor = DBusTabletInterface::instance().isTouchSensor(tabletId);
-    if (isTouchSensor.isValid() && isTouchSensor.value()) {
-        return;
-    }
+    requestSnapshot(tabletId);
+}
+
+void WacomTabletEngine::requestSnapshot(const QString& tabletId)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusTabletInterface::instance().getTabletSnapshot(tabletId), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, [this, tabletId](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<QVariantMap> reply = *call;
 
-    QList<QDBusPendingCall> callList;
-
-    callList << DBusTabletInterface::instance().getInformation(tabletId, TabletInfo::TabletName.key())
-             << DBusTabletInterface::instance().listProfiles(tabletId)
-             << DBusTabletInterface::instance().getProfile(tabletId)
-             << DBusTabletInterface::instance().getProperty(tabletId, DeviceType::Stylus.key(), Property::Mode.key())
-             << DBusTabletInterface::instance().getDeviceName(tabletId, DeviceType::Touch.key())
-             << DBusTabletInterface::instance().getProperty(tabletId, DeviceType::Touch.key(), Property::Touch.key());
-
-    MultiDBusPendingCallWatcher *watcher = new MultiDBusPendingCallWatcher(callList, this);
-    connect(watcher, &MultiDBusPendingCallWatcher::finished, [this, watcher, tabletId](const QList<QDBusPendingCallWatcher*>& watchers) {
-        watcher->deleteLater();
-        Q_FOREACH(auto watcher, watchers) {
-            if (watcher->isError()) {
-                return;
-            }
+        if (reply.isError()) {
+            return;
         }
 
-        QDBusPendingReply<QString> deviceName = *watchers[0];
-        QDBusPendingReply<QStringList> profileListReply = *watchers[1];
-        QDBusPendingReply<QString> profileName = *watchers[2];
-        QDBusPendingReply<QString> stylusMode = *watchers[3];
-        QDBusPendingReply<QString> hasTouch = *watchers[4];
-        QDBusPendingReply<QString> touchMode = *watchers[5];
+        const TabletSnapshot snapshot(reply.value());
 
-        const QString sourceName = QString(QLatin1String("Tablet%1")).arg(tabletId);
+        // the tablet was removed in the meantime or is part of another tablet
+        if (!snapshot.isValid() || StringUtils::asBool(snapshot.getInformation(TabletInfo::IsTouchSensor))) {
+            return;
+        }
+
+        // a fresh snapshot replaces the mirror, including its version
         auto& tabletData = m_tablets[tabletId];
-        tabletData.name = deviceName.value();
-        const auto profileList = profileListReply.value();
-        tabletData.profiles = profileList;
-        int item = profileList.indexOf(profileName.value());
-        tabletData.currentProfile = item;
-        tabletData.hasTouch = (hasTouch.isValid() && !hasTouch.value().isEmpty());
-        tabletData.touch = tabletData.hasTouch ? QString( touchMode ).contains( QLatin1String( "on" )) : false;
-        tabletData.stylusMode = ( QString( stylusMode ).contains( QLatin1String( "absolute" )) || QString( stylusMode ).contains( QLatin1String( "Absolute" )) );
+        tabletData.name = snapshot.getInformation(TabletInfo::TabletName);
+        tabletData.profiles = snapshot.getProfileList();
+        tabletData.hasTouch = !snapshot.getDeviceName(DeviceType::Touch).isEmpty();
+        tabletData.touch = false;
+        tabletData.stylusMode = false;
+        tabletData.rotation.clear();
 
-        setData(sourceName, QLatin1String("currentProfile"), tabletData.currentProfile);
+        const QString sourceName = QString(QLatin1String("Tablet%1")).arg(tabletId);
         setData(sourceName, QLatin1String("hasTouch"), tabletData.hasTouch);
         setData(sourceName, QLatin1String("touch"), tabletData.touch);
         setData(sourceName, QLatin1String("profiles"), tabletData.profiles);
-        setData(sourceName, QLatin1String("stylusMode"), tabletData.stylusMode);
         setData(sourceName, QLatin1String("name"), tabletData.name);
         setData(sourceName, QLatin1String("id"), tabletId);
+
+        applySnapshot(tabletId, snapshot);
     });
 }
 
-void WacomTabletEngine::onTabletRemoved(const QString& tabletId)
+void WacomTabletEngine::applySnapshot(const QString& tabletId, const TabletSnapshot& snapshot)
 {
     const QString sourceName = QString(QLatin1String("Tablet%1")).arg(tabletId);
-    m_tablets.remove(tabletId);
-    removeSource(sourceName);
+    auto& tabletData = m_tablets[tabletId];
+
+    tabletData.version = snapshot.getStateVersion();
+
+    if (snapshot.hasProfile()) {
+        tabletData.currentProfile = tabletData.profiles.indexOf(snapshot.getProfile());
+        setData(sourceName, QLatin1String("currentProfile"), tabletData.currentProfile);
+    }
+
+    if (snapshot.hasProperty(DeviceType::Stylus, Property::Mode)) {
+        const QString stylusMode = snapshot.getProperty(DeviceType::Stylus, Property::Mode);
+        tabletData.stylusMode = stylusMode.contains(QLatin1String("absolute"), Qt::CaseInsensitive);
+        setData(sourceName, QLatin1String("stylusMode"), tabletData.stylusMode);
+    }
+
+    if (snapshot.hasProperty(DeviceType::Stylus, Property::Rotate)) {
+        tabletData.rotation = snapshot.getProperty(DeviceType::Stylus, Property::Rotate);
+        setData(sourceName, QLatin1String("rotation"), tabletData.rotation);
+    }
+
+    if (tabletData.hasTouch && snapshot.hasProperty(DeviceType::Touch, Property::Touch)) {
+        tabletData.touch = snapshot.getProperty(DeviceType::Touch, Property::Touch).contains(QLatin1String("on"));
+        setData(sourceName, QLatin1String("touch"), tabletData.touch);
+    }
 }
 
-void WacomTabletEngine::setProfile(const QString& tabletId, const QString& profile)
+void WacomTabletEngine::onStateChanged(const QString& tabletId, uint version, const QVariantMap& delta)
 {
-    if (!m_tablets.contains(tabletId)) {
+    // unknown tablets are still waiting for their snapshot, which is newer than this delta
+    if (!m_tablets.contains(tabletId) || version <= m_tablets[tabletId].version) {
         return;
     }
-    int item = m_tablets[tabletId].currentProfile = m_tablets[tabletId].profiles.indexOf(profile);
+
+    const TabletSnapshot snapshot(delta);
+    const auto& tabletData = m_tablets[tabletId];
+
+    // a delta was missed or the profile list changed, get a new snapshot
+    if (version != tabletData.version + 1 ||
+        (snapshot.hasProfile() && !tabletData.profiles.contains(snapshot.getProfile()))) {
+        requestSnapshot(tabletId);
+        return;
+    }
+
+    applySnapshot(tabletId, snapshot);
+}
+
+void WacomTabletEngine::onTabletRemoved(const QString& tabletId)
+{
     const QString sourceName = QString(QLatin1String("Tablet%1")).arg(tabletId);
-    setData(sourceName, QLatin1String("currentProfile"), item);
+    m_tablets.remove(tabletId);
+    removeSource(sourceName);
 }
 
 Plasma::Service* WacomTabletEngine::serviceForSource(const QString& source)
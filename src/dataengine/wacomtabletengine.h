@@ -19,6 +19,7 @@
 #define WACOMTABLETENGINE_H
 
 #include "dbustabletinterface.h"
+#include "tabletsnapshot.h"
 #include <Plasma5Support/DataEngine>
 namespace Plasma = Plasma5Support;
 
@@ -30,6 +31,8 @@ struct TabletData
     bool stylusMode;
     bool hasTouch;
     bool touch;
+    QString rotation;
+    uint version;       //!< State version of the daemon this data is based on.
 };
 
 class WacomTabletEngine : public Plasma::DataEngine
@@ -46,9 +49,21 @@ private slots:
     void onDBusDisconnected();
     void onTabletAdded(const QString& tabletId);
     void onTabletRemoved(const QString& tabletId);
-    void setProfile(const QString& tabletId, const QString& profile);
+    void onStateChanged(const QString& tabletId, uint version, const QVariantMap& delta);
 
 private:
+    /**
+     * Asynchronously fetches a new snapshot of the tablet and replaces the
+     * local mirror with it.
+     */
+    void requestSnapshot(const QString& tabletId);
+
+    /**
+     * Updates the local mirror and the data of the tablet source from a full
+     * snapshot or from a delta. Only values contained in the snapshot are set.
+     */
+    void applySnapshot(const QString& tabletId, const Wacom::TabletSnapshot& snapshot);
+
     QMap<QString, TabletData> m_tablets;
     QString m_source;
 };
@@ -29,6 +29,7 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPen>
+#include <QRegion>
 
 using namespace Wacom;
 
@@ -106,6 +107,11 @@ namespace Wacom
             QRect                rectDragHandleBottom;    //!< The rectangle which holds the size and position of the bottom drag handle.
             QRect                rectDragHandleLeft;      //!< The rectangle which holds the size and position of the top drag handle.
 
+            QList<QPointF>       displayAreaCaptionPositions; //!< The text positions of the display area captions.
+            QString              selectedAreaCaption;         //!< The caption of the selected area.
+            QPointF              selectedAreaCaptionPosition; //!< The text position of the selected area caption.
+            QRect                rectSelectedAreaCaption;     //!< The rectangle the selected area caption is painted in.
+
             qreal                proportions = 1;
             bool                 proportionsLocked = false;
     }; // PRIVATE CLASS
@@ -186,6 +192,7 @@ void AreaSelectionWidget::setDrawAreaCaptions(bool value)
     Q_D(AreaSelectionWidget);
 
     d->drawAreaCaption = value;
+    updateSelectedAreaCaption();
 }
 
 
@@ -202,6 +209,8 @@ void AreaSelectionWidget::setFont(const QFont& font)
     Q_D(AreaSelectionWidget);
 
     d->fontCaptions = font;
+    updateDisplayAreaCaptions();
+    updateSelectedAreaCaption();
 }
 
 
@@ -243,6 +252,7 @@ void AreaSelectionWidget::setSelection(const QRect& selection, bool emitUpdate)
 
     updateSelectedAreaSize();
     updateDragHandles();
+    updateSelectedAreaCaption();
 
     QWidget::update();
 
@@ -300,10 +310,22 @@ void AreaSelectionWidget::mouseMoveEvent(QMouseEvent* event)
     }
 
     updateMouseCursor(event->pos());
+
+    // mouse tracking is on, but only a drag changes what we paint
+    if (!isUserDragging()) {
+        return;
+    }
+
+    const QRegion oldRegion = getSelectionRegion();
+
     updateSelectedAreaOnDrag(event->pos());
     updateDragHandles();
+    updateSelectedAreaCaption();
 
-    QWidget::update();
+    // repaint where the selection was and where it is now
+    QWidget::update(oldRegion.united(getSelectionRegion()));
+
+    emit selectionDragged();
 }
 
 
@@ -508,6 +530,23 @@ qreal AreaSelectionWidget::getTotalDisplayAreaMargin() const
 }
 
 
+const QRegion AreaSelectionWidget::getSelectionRegion() const
+{
+    Q_D(const AreaSelectionWidget);
+
+    // the drag handles stick out of the selection and the pen is antialiased
+    const qreal margin = d->DRAG_HANDLE_SIZE / 2. + 2.;
+
+    QRegion region(d->rectSelectedArea.adjusted(-margin, -margin, margin, margin).toAlignedRect());
+
+    if (d->drawSelectionCaption) {
+        region += d->rectSelectedAreaCaption;
+    }
+
+    return region;
+}
+
+
 bool AreaSelectionWidget::isUserDragging() const
 {
     Q_D(const AreaSelectionWidget);
@@ -520,25 +559,16 @@ void AreaSelectionWidget::paintDisplayAreaCaptions(QPainter& painter)
 {
     Q_D(AreaSelectionWidget);
 
-    QRectF       area;
-    QString      caption;
-    qreal        captionX;
-    qreal        captionY;
-    QFontMetrics fontMetrics(d->fontCaptions);
-
     painter.setPen( d->colorDisplayAreaText );
     painter.setBrush( d->colorDisplayAreaText );
     painter.setFont(d->fontCaptions);
 
-    for (int i = 0 ; i < d->rectDisplayAreas.size() ; ++i) {
-        area    = d->rectDisplayAreas.at(i);
-        caption = (d->areaCaptionsList.size() > i) ? d->areaCaptionsList.at(i) : QString();
+    // captions without a position are empty or belong to invalid areas
+    for (int i = 0 ; i < d->displayAreaCaptionPositions.size() ; ++i) {
+        const QPointF& position = d->displayAreaCaptionPositions.at(i);
 
-        if (!caption.isEmpty() && area.isValid()) {
-            captionX = area.x() + (float)area.width() / 2 - (float)fontMetrics.horizontalAdvance(caption) / 2;
-            captionY = area.y() + (float)area.height() / 2 + (float)fontMetrics.height() / 2;
-
-            painter.drawText(captionX, captionY, caption);
+        if (!position.isNull()) {
+            painter.drawText(position, d->areaCaptionsList.at(i));
         }
     }
 }
@@ -599,40 +629,11 @@ void AreaSelectionWidget::paintSelectedAreaCaption(QPainter& painter)
 {
     Q_D(AreaSelectionWidget);
 
-    QFontMetrics fontMetrics(d->fontCaptions);
-
     painter.setPen(d->colorSelectedAreaText);
     painter.setBrush(d->colorSelectedAreaText);
     painter.setFont(d->fontCaptions);
 
-    QRect selectedArea = getSelection();
-
-    QString text = QString::fromLatin1("%1x%2+%3+%4")
-                            .arg(selectedArea.width())
-                            .arg(selectedArea.height())
-                            .arg(selectedArea.x())
-                            .arg(selectedArea.y());
-
-    qreal textX = d->rectDisplayArea.x() + (qreal)d->rectDisplayArea.width() / 2 - (qreal)fontMetrics.horizontalAdvance(text) / 2;
-    qreal textY;
-
-    if (paintBelow) {
-        // Draw text below the display area
-        textY = d->rectDisplayArea.y() + d->rectDisplayArea.height() + ((qreal)fontMetrics.height());
-    } else {
-        // Draw in the middle of the display area
-        textY = d->rectDisplayArea.y() + d->rectDisplayArea.height() / 2 + (qreal)fontMetrics.height() / 2;
-
-        // If we are also showing area captions, then the vertical center will
-        // already be occupied. We move our text a bit further down then.
-        if (d->drawAreaCaption) {
-            textY = textY + fontMetrics.height();
-        }
-    }
-
-
-
-    painter.drawText(qRound(textX), qRound(textY), text);
+    painter.drawText(d->selectedAreaCaptionPosition, d->selectedAreaCaption);
 }
 
 
@@ -669,8 +670,82 @@ void AreaSelectionWidget::setupWidget()
     // set selected area to the full display area
     d->rectSelectedArea = d->rectDisplayArea;
 
-    // recalculate drag handles positions
+    // recalculate drag handles positions and captions
     updateDragHandles();
+    updateDisplayAreaCaptions();
+    updateSelectedAreaCaption();
+
+    QWidget::update();
+}
+
+
+void AreaSelectionWidget::updateDisplayAreaCaptions()
+{
+    Q_D(AreaSelectionWidget);
+
+    QRectF       area;
+    QString      caption;
+    qreal        captionX;
+    qreal        captionY;
+    QFontMetrics fontMetrics(d->fontCaptions);
+
+    d->displayAreaCaptionPositions.clear();
+
+    for (int i = 0 ; i < d->rectDisplayAreas.size() && i < d->areaCaptionsList.size() ; ++i) {
+        area    = d->rectDisplayAreas.at(i);
+        caption = d->areaCaptionsList.at(i);
+
+        if (!caption.isEmpty() && area.isValid()) {
+            captionX = area.x() + (float)area.width() / 2 - (float)fontMetrics.horizontalAdvance(caption) / 2;
+            captionY = area.y() + (float)area.height() / 2 + (float)fontMetrics.height() / 2;
+
+            d->displayAreaCaptionPositions.append(QPointF(captionX, captionY));
+        } else {
+            d->displayAreaCaptionPositions.append(QPointF());
+        }
+    }
+}
+
+
+void AreaSelectionWidget::updateSelectedAreaCaption()
+{
+    Q_D(AreaSelectionWidget);
+
+    QFontMetrics fontMetrics(d->fontCaptions);
+
+    QRect selectedArea = getSelection();
+
+    QString text = QString::fromLatin1("%1x%2+%3+%4")
+                            .arg(selectedArea.width())
+                            .arg(selectedArea.height())
+                            .arg(selectedArea.x())
+                            .arg(selectedArea.y());
+
+    const int textWidth = fontMetrics.horizontalAdvance(text);
+
+    qreal textX = d->rectDisplayArea.x() + (qreal)d->rectDisplayArea.width() / 2 - (qreal)textWidth / 2;
+    qreal textY;
+
+    if (paintBelow) {
+        // Draw text below the display area
+        textY = d->rectDisplayArea.y() + d->rectDisplayArea.height() + ((qreal)fontMetrics.height());
+    } else {
+        // Draw in the middle of the display area
+        textY = d->rectDisplayArea.y() + d->rectDisplayArea.height() / 2 + (qreal)fontMetrics.height() / 2;
+
+        // If we are also showing area captions, then the vertical center will
+        // already be occupied. We move our text a bit further down then.
+        if (d->drawAreaCaption) {
+            textY = textY + fontMetrics.height();
+        }
+    }
+
+    d->selectedAreaCaption         = text;
+    d->selectedAreaCaptionPosition = QPointF(qRound(textX), qRound(textY));
+
+    // the caption is part of the dirty region of a drag, so be generous
+    d->rectSelectedAreaCaption     = QRect(qRound(textX) - 2, qRound(textY) - fontMetrics.ascent() - 2,
+                                           textWidth + 4, fontMetrics.height() + 4);
 }
 
 
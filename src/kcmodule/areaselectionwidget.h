@@ -28,6 +28,7 @@
 
 class QBrush;
 class QPainter;
+class QRegion;
 
 namespace Wacom
 {
@@ -168,6 +169,12 @@ signals:
      */
     void selectionChanged();
 
+    /**
+     * Emitted while the user drags the selection or one of its handles.
+     * Once the user releases the mouse button selectionChanged() is emitted.
+     */
+    void selectionDragged();
+
 
 protected:
     /**
@@ -298,6 +305,16 @@ private:
     qreal getTotalDisplayAreaMargin() const;
 
 
+    /**
+     * Returns the region which has to be repainted when the selected area
+     * changes. This is the selected area including its drag handles and
+     * the selected area caption.
+     *
+     * @return The region covered by the selected area.
+     */
+    const QRegion getSelectionRegion() const;
+
+
     /**
      * Determines if the user is currently dragging a handle or
      * the selected area with the mouse.
@@ -354,12 +371,24 @@ private:
     void setupWidget();
 
 
+    /**
+     * Recalculates the positions of the display area captions.
+     */
+    void updateDisplayAreaCaptions();
+
+
     /**
      * Recalculates the positions of the drag handles.
      */
     void updateDragHandles();
 
 
+    /**
+     * Recalculates the text and the position of the selected area caption.
+     */
+    void updateSelectedAreaCaption();
+
+
     /**
      * Updates the mouse cursor according to the mouse's position.
      *
@@ -21,6 +21,7 @@
 #include "ui_buttonactionselectorwidget.h"
 
 #include "buttonactionselectiondialog.h"
+#include "globalshortcutindex.h"
 
 #include <QIcon>
 
@@ -87,6 +88,15 @@ void ButtonActionSelectorWidget::onButtonActionSelectorClicked()
 }
 
 
+void ButtonActionSelectorWidget::onGlobalShortcutsChanged()
+{
+    Q_D (ButtonActionSelectorWidget);
+
+    // global shortcut names are loaded asynchronously
+    updateActionName(d->shortcut);
+}
+
+
 void ButtonActionSelectorWidget::onLineEditSelectionChanged()
 {
     Q_D (ButtonActionSelectorWidget);
@@ -103,6 +113,7 @@ void ButtonActionSelectorWidget::setupUi()
     connect ( d->ui->actionSelectionButton,   SIGNAL (clicked(bool)),      this, SLOT (onButtonActionSelectorClicked()) );
     connect ( d->ui->actionNameDisplayWidget, SIGNAL (selectionChanged()), this, SLOT (onLineEditSelectionChanged()) );
     connect ( d->ui->actionNameDisplayWidget, SIGNAL (mousePressed()),     this, SLOT (onButtonActionSelectorClicked()) );
+    connect ( &GlobalShortcutIndex::instance(), SIGNAL (indexChanged()),   this, SLOT (onGlobalShortcutsChanged()) );
 
     setShortcut(ButtonShortcut());
 }
@@ -53,6 +53,8 @@ private slots:
 
     void onButtonActionSelectorClicked();
 
+    void onGlobalShortcutsChanged();
+
     void onLineEditSelectionChanged();
 
 
@@ -28,7 +28,7 @@
 #include "property.h"
 #include "tabletinfo.h"
 #include "deviceprofile.h"
-#include "dbustabletinterface.h"
+#include "tabletsnapshot.h"
 #include "buttonshortcut.h"
 #include "stringutils.h"
 
@@ -44,8 +44,6 @@
 #include <QLabel>
 #include <QKeySequence>
 #include <QPointer>
-#include <QDBusInterface>
-#include <QDBusReply>
 #include <QList>
 #include <QFile>
 
@@ -70,7 +68,7 @@ ButtonPageWidget::ButtonPageWidget(QWidget* parent)
         , ui(new Ui::ButtonPageWidget)
 {
     setupUi();
-    reloadWidget();
+    reloadWidget(TabletSnapshot());
 }
 
 
@@ -194,9 +192,9 @@ void ButtonPageWidget::loadFromProfile(ProfileManagementInterface &profileManage
 }
 
 
-void ButtonPageWidget::reloadWidget()
+void ButtonPageWidget::reloadWidget(const TabletSnapshot &snapshot)
 {
-    const int padButtons = DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::NumPadButtons.key()).value().toInt();
+    const int padButtons = snapshot.getInformation(TabletInfo::NumPadButtons).toInt();
 
     QLabel *buttonLabel = nullptr;
     ButtonActionSelectorWidget *buttonSelector = nullptr;
@@ -222,7 +220,7 @@ void ButtonPageWidget::reloadWidget()
         }
     }
 
-    const QString padLayoutProperty = DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::ButtonLayout.key());
+    const QString padLayoutProperty = snapshot.getInformation(TabletInfo::ButtonLayout);
     const QString layoutFile = findLayoutFile(padLayoutProperty);
     if (!layoutFile.isEmpty()) {
         // FIXME: libwacom svg's are large in size and have small labels
@@ -233,8 +231,8 @@ void ButtonPageWidget::reloadWidget()
     const bool anyButtonsOrLayout = padButtons > 0 || (!layoutFile.isEmpty());
     ui->buttonGroupBox->setVisible(anyButtonsOrLayout);
 
-    bool hasLeftTouchStrip  = StringUtils::asBool(DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::HasLeftTouchStrip.key()));
-    bool hasRightTouchStrip = StringUtils::asBool(DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::HasRightTouchStrip.key()));
+    bool hasLeftTouchStrip  = StringUtils::asBool(snapshot.getInformation(TabletInfo::HasLeftTouchStrip));
+    bool hasRightTouchStrip = StringUtils::asBool(snapshot.getInformation(TabletInfo::HasRightTouchStrip));
 
     if (!hasLeftTouchStrip && !hasRightTouchStrip) {
         ui->touchStripGroupBox->setEnabled(false);
@@ -278,7 +276,7 @@ void ButtonPageWidget::reloadWidget()
         }
     }
 
-    if (!StringUtils::asBool(DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::HasTouchRing.key()))) {
+    if (!StringUtils::asBool(snapshot.getInformation(TabletInfo::HasTouchRing))) {
         ui->touchRingGroupBox->setEnabled(false);
         ui->touchRingGroupBox->setVisible(false);
     } else {
@@ -286,7 +284,7 @@ void ButtonPageWidget::reloadWidget()
         ui->touchRingGroupBox->setVisible(true);
     }
 
-    if (!StringUtils::asBool(DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::HasWheel.key()))) {
+    if (!StringUtils::asBool(snapshot.getInformation(TabletInfo::HasWheel))) {
         ui->wheelGroupBox->setEnabled(false);
         ui->wheelGroupBox->setVisible(false);
     } else {
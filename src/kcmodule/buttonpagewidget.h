@@ -36,6 +36,7 @@ namespace Wacom
 
 class ButtonShortcut;
 class ProfileManagementInterface;
+class TabletSnapshot;
 
 /**
   * The PadButton widget contains all settings to assign the buttons on the tablet pad
@@ -70,8 +71,9 @@ public:
     /**
       * Reloads the widget when the status of the tablet device changes (connects/disconnects)
       *
+      * @param snapshot The current snapshot of the tablet set by setTabletId().
       */
-    void reloadWidget();
+    void reloadWidget(const TabletSnapshot &snapshot);
 
 public slots:
     /**
@@ -26,6 +26,7 @@
 #include "tabletinfo.h"
 #include "dbustabletinterface.h"
 #include "globalactions.h"
+#include "tabletsnapshot.h"
 
 // stdlib
 #include <memory>
@@ -35,8 +36,8 @@
 
 //Qt includes
 #include <QStringList>
-#include <QDBusInterface>
-#include <QDBusReply>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QListWidget>
 #include <QListWidgetItem>
 #include <QInputDialog>
@@ -106,11 +107,29 @@ void GeneralPageWidget::profileChanged()
 
 void GeneralPageWidget::reloadWidget()
 {
-    //get information via DBus
-    QDBusReply<QString> deviceName       = DBusTabletInterface::instance().getInformation(_tabletId, TabletInfo::TabletName.key());
+    //load rotation profile list based on current tablet without blocking the ui
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusTabletInterface::instance().getProfileRotationList(_tabletId), this);
+    const QString tabletId = _tabletId;
 
-    //load rotation profile list based on current tablet
-    QDBusReply<QStringList> rotationList = DBusTabletInterface::instance().getProfileRotationList(_tabletId);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, tabletId](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        QDBusPendingReply<QStringList> rotationList = *call;
+        if (rotationList.isError() || tabletId != _tabletId) {
+            return;
+        }
+
+        setRotationList(rotationList.value());
+    });
+}
+
+void GeneralPageWidget::reloadWidget(const TabletSnapshot &snapshot)
+{
+    setRotationList(snapshot.getProfileRotationList());
+}
+
+void GeneralPageWidget::setRotationList(const QStringList &rotationList)
+{
     ui->lwRotationList->clear();
     ui->lwRotationList->addItems(rotationList);
 }
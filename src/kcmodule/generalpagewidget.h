@@ -34,6 +34,7 @@ namespace Wacom
 {
     class ProfileManagement;
     class GlobalActions;
+    class TabletSnapshot;
 
 /**
   * This class shows some general information about the detected tablet device.
@@ -69,9 +70,18 @@ public:
 public slots:
     /**
       * When called the widget information will be refreshed
+      *
+      * The data is requested asynchronously and filled in when the reply arrives.
       */
     void reloadWidget();
 
+    /**
+      * Refreshes the widget information from an already fetched tablet snapshot
+      *
+      * @param snapshot The current snapshot of the tablet set by setTabletId().
+      */
+    void reloadWidget(const Wacom::TabletSnapshot &snapshot);
+
     /**
       * Called whenever the profile is switched or the widget needs to be reinitialized.
       *
@@ -98,6 +108,11 @@ private slots:
     void profileRemove();
 
 private:
+    /**
+      * Replaces the content of the profile rotation list widget.
+      */
+    void setRotationList(const QStringList &rotationList);
+
     Ui::GeneralPageWidget *ui = nullptr;
     GlobalActions *_actionCollection = nullptr;
     KShortcutsEditor *_shortcutEditor = nullptr;
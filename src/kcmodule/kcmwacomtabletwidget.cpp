@@ -34,11 +34,15 @@
 // common
 #include "dbustabletinterface.h"
 #include "devicetype.h"
+#include "stringutils.h"
+#include "tabletsnapshot.h"
 
 #include <KMessageBox>
 
 //Qt includes
-#include <QDBusReply>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QHash>
 #include <QPointer>
 #include <QStringList>
 #include <QPixmap>
@@ -67,6 +71,11 @@ class KCMWacomTabletWidgetPrivate {
         QWidget           deviceErrorWidget;  //!< Device error widget.
         Ui::ErrorWidget   deviceErrorUi;      //!< Device error widget ui.
         bool              profileChanged;     //!< True if the profile was changed and not saved yet.
+
+        QHash<QString, TabletSnapshot> tabletSnapshots;   //!< Last received snapshot of every connected tablet.
+        bool              tabletListReceived = false;     //!< True once the daemon answered the tablet list request.
+        bool              serviceAvailable   = false;     //!< True if the daemon answered the tablet list request successfully.
+        int               pendingSnapshots   = 0;         //!< Number of snapshot requests still waiting for a reply.
 }; // CLASS
 }  // NAMESPACE
 
@@ -138,59 +147,154 @@ void KCMWacomTabletWidget::setupUi()
     // connect DBus signals
     connect( dbusTabletInterface, SIGNAL(tabletAdded(QString)),   SLOT(onTabletAdded(QString)) );
     connect( dbusTabletInterface, SIGNAL(tabletRemoved(QString)), SLOT(onTabletRemoved(QString)) );
+
+    // keep the cached snapshots up to date
+    connect( dbusTabletInterface, &DBusTabletInterface::profileChanged, this, [d](const QString &tabletId, const QString &profile) {
+        if (d->tabletSnapshots.contains(tabletId)) {
+            d->tabletSnapshots[tabletId].setProfile(profile);
+        }
+    });
 }
 
 
 void KCMWacomTabletWidget::loadTabletInformation()
+{
+    // nothing is shown until the daemon answers
+    hideConfig();
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusTabletInterface::instance().getTabletList(), this);
+
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        Q_D( KCMWacomTabletWidget );
+
+        call->deleteLater();
+
+        QDBusPendingReply<QStringList> connectedTablets = *call;
+
+        d->tabletListReceived = true;
+        d->serviceAvailable   = connectedTablets.isValid();
+
+        if (d->serviceAvailable) {
+            // request all tablets in parallel, they are added as their replies arrive
+            foreach(const QString &tabletId, connectedTablets.value()) {
+                requestTabletSnapshot(tabletId);
+            }
+        }
+
+        showHideConfig();
+    });
+}
+
+void KCMWacomTabletWidget::requestTabletSnapshot(const QString &tabletId)
+{
+    Q_D( KCMWacomTabletWidget );
+
+    ++d->pendingSnapshots;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(DBusTabletInterface::instance().getTabletSnapshot(tabletId), this);
+
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, tabletId](QDBusPendingCallWatcher *call) {
+        Q_D( KCMWacomTabletWidget );
+
+        call->deleteLater();
+        --d->pendingSnapshots;
+
+        QDBusPendingReply<QVariantMap> reply = *call;
+        TabletSnapshot snapshot(reply.isValid() ? reply.value() : QVariantMap());
+
+        if (!snapshot.isValid()) {
+            qCWarning(KCM) << "Could not get snapshot of tablet" << tabletId;
+            showHideConfig();
+            return;
+        }
+
+        onTabletSnapshotReceived(tabletId, snapshot);
+    });
+}
+
+void KCMWacomTabletWidget::onTabletSnapshotReceived(const QString &tabletId, const TabletSnapshot &snapshot)
 {
     Q_D( KCMWacomTabletWidget );
-    QDBusReply<QStringList> connectedTablets = DBusTabletInterface::instance().getTabletList();
 
-    if(!connectedTablets.isValid()) {
+    d->tabletSnapshots.insert(tabletId, snapshot);
+
+    // a touch sensor which belongs to the tablet currently shown completes the touch page
+    if (StringUtils::asBool(snapshot.getInformation(TabletInfo::IsTouchSensor))) {
+        const QString currentTabletId = d->ui.tabletListSelector->itemData(d->ui.tabletListSelector->currentIndex()).toString();
+
+        if (d->tabletSnapshots.value(currentTabletId).getInformation(TabletInfo::TouchSensorId) == tabletId) {
+            d->touchPage.reloadWidget(snapshot);
+        }
+
+        qCDebug(KCM) << "Ignoring tablet" << snapshot.getInformation(TabletInfo::TabletName) << tabletId << "because it's a touch sensor";
+
+        // this may have been the last snapshot we were waiting for
+        showHideConfig();
         return;
     }
 
-    d->ui.tabletListSelector->blockSignals(true);
-    foreach(const QString &tabletId, connectedTablets.value()) {
-        addTabletToSelector(tabletId);
+    if (d->ui.tabletListSelector->findData(tabletId) >= 0) {
+        return;
     }
+
+    // show the configuration as soon as the first tablet is known
+    d->ui.tabletListSelector->blockSignals(true);
+    const bool wasEmpty = (d->ui.tabletListSelector->count() == 0);
+    addTabletToSelector(tabletId, snapshot);
     d->ui.tabletListSelector->blockSignals(false);
+
+    if (wasEmpty || d->pendingSnapshots == 0) {
+        showHideConfig();
+    }
 }
 
 void KCMWacomTabletWidget::showHideConfig()
 {
-    // request this to see if dbus works and tablets are connected
-    QDBusReply<QStringList> connectedTablets = DBusTabletInterface::instance().getTabletList();
+    Q_D( KCMWacomTabletWidget );
 
-    if( !connectedTablets.isValid() ) {
+    if (!d->tabletListReceived) {
+        return; // still waiting for the daemon
+    }
+
+    if( !d->serviceAvailable ) {
         QString errorTitle = i18n( "KDE tablet service not found" );
         QString errorMsg   = i18n( "Please start the KDE wacom tablet service to use this configuration dialog.\n"
                                    "The service is required for tablet detection and profile support." );
         showError( errorTitle, errorMsg );
-    } else if( connectedTablets.value().count() == 0 ) {
+    } else if( d->ui.tabletListSelector->count() == 0 ) {
+        if (d->pendingSnapshots > 0) {
+            return; // a tablet may still show up
+        }
+
         QString errorTitle = i18n( "No tablet device detected" );
         QString errorMsg   = i18n( "Please connect a tablet device to continue.\n"
                                    "If your device is already connected, it is currently not in the device database." );
         showError(errorTitle, errorMsg, true);
-    } else {
+    } else if (d->ui.deviceTabWidget->isHidden()) {
         showConfig();
     }
 }
 
 void KCMWacomTabletWidget::onTabletAdded(const QString &tabletId)
 {
-    addTabletToSelector(tabletId);
+    requestTabletSnapshot(tabletId);
 }
 
 void KCMWacomTabletWidget::onTabletRemoved(const QString &tabletId)
 {
     Q_D( KCMWacomTabletWidget );
 
+    d->tabletSnapshots.remove(tabletId);
+
     int index = d->ui.tabletListSelector->findData(tabletId);
 
     if(index >= 0) {
         d->ui.tabletListSelector->removeItem(index);
     }
+
+    if (d->ui.tabletListSelector->count() == 0) {
+        showHideConfig();
+    }
 }
 
 void KCMWacomTabletWidget::onTabletSelectionChanged()
@@ -207,6 +311,7 @@ void KCMWacomTabletWidget::onTabletSelectionChanged()
     d->tabletPage.setTabletId(tabletId);
     d->touchPage.setTabletId(tabletId);
 
+    hideConfig();
     showHideConfig();
 }
 
@@ -382,34 +487,42 @@ void KCMWacomTabletWidget::showConfig()
     // make sure no error message is active
     hideError();
 
-    // reload profile and widget data
+    // reload profile and widget data from the cached snapshot
     QString tabletId = d->ui.tabletListSelector->itemData(d->ui.tabletListSelector->currentIndex()).toString();
+    const TabletSnapshot snapshot = d->tabletSnapshots.value(tabletId);
+
     ProfileManagement::instance().setTabletId(tabletId);
-    ProfileManagement::instance().reload();
+    ProfileManagement::instance().reload(snapshot);
 
     d->generalPage.setTabletId(tabletId);
     d->stylusPage.setTabletId(tabletId);
     d->buttonPage.setTabletId(tabletId);
     d->tabletPage.setTabletId(tabletId);
 
-    QDBusReply<QString> touchDeviceName = DBusTabletInterface::instance().getDeviceName(tabletId, DeviceType::Touch.key());
-    QDBusReply<QString> touchSensorId   = DBusTabletInterface::instance().getTouchSensorId(tabletId);
+    const QString touchSensorId = snapshot.getInformation(TabletInfo::TouchSensorId);
+
+    const bool hasBuiltInTouch = !snapshot.getDeviceName(DeviceType::Touch).isEmpty();
+    const bool hasPairedTouch  = !touchSensorId.isEmpty();
 
-    const bool hasBuiltInTouch = (touchDeviceName.isValid() && !touchDeviceName.value().isEmpty());
-    const bool hasPairedTouch  = (touchSensorId.isValid() && !touchSensorId.value().isEmpty());
+    d->generalPage.reloadWidget(snapshot);
+    d->stylusPage.reloadWidget();
+    d->buttonPage.reloadWidget(snapshot);
+    d->tabletPage.reloadWidget(snapshot);
 
     if (hasPairedTouch) {
-        d->touchPage.setTabletId(touchSensorId.value());
+        // the paired sensor is a tablet of its own, fill the page as soon as it is known
+        d->touchPage.setTabletId(touchSensorId);
+
+        if (d->tabletSnapshots.contains(touchSensorId)) {
+            d->touchPage.reloadWidget(d->tabletSnapshots.value(touchSensorId));
+        } else {
+            requestTabletSnapshot(touchSensorId);
+        }
     } else {
         d->touchPage.setTabletId(tabletId);
+        d->touchPage.reloadWidget(snapshot);
     }
 
-    d->generalPage.reloadWidget();
-    d->stylusPage.reloadWidget();
-    d->buttonPage.reloadWidget();
-    d->tabletPage.reloadWidget();
-    d->touchPage.reloadWidget();
-
     //show tablet Selector
     d->ui.tabletListSelector->setEnabled( true );
     d->ui.tabletListLabel->setVisible( true );
@@ -438,9 +551,7 @@ void KCMWacomTabletWidget::showConfig()
     makeScrollableTab(d->ui.deviceTabWidget, d->stylusPage, i18n( "Stylus" ) );
 
 
-    QDBusReply<bool> hasPadButtons = DBusTabletInterface::instance().hasPadButtons(tabletId);
-
-    if( hasPadButtons.isValid() && hasPadButtons.value() ) {
+    if( snapshot.hasPadButtons() ) {
         makeScrollableTab(d->ui.deviceTabWidget, d->buttonPage, i18n( "Express Buttons" ) );
     }
 
@@ -454,8 +565,8 @@ void KCMWacomTabletWidget::showConfig()
     d->ui.deviceTabWidget->setVisible( true );
 
     // switch to the currently active profile
-    QDBusReply<QString> profile = DBusTabletInterface::instance().getProfile(tabletId);
-    if( profile.isValid() ) {
+    const QString profile = snapshot.getProfile();
+    if( snapshot.isValid() ) {
         d->ui.profileSelector->setCurrentText( profile );
         switchProfile( profile );
     }
@@ -488,19 +599,13 @@ void KCMWacomTabletWidget::showTabletFinder()
     }
 }
 
-void KCMWacomTabletWidget::addTabletToSelector(const QString &tabletId)
+void KCMWacomTabletWidget::addTabletToSelector(const QString &tabletId, const TabletSnapshot &snapshot)
 {
     Q_D( KCMWacomTabletWidget );
 
-    QDBusReply<QString> deviceName = DBusTabletInterface::instance().getInformation(tabletId, TabletInfo::TabletName.key());
-    QDBusReply<QStringList> inputDevices = DBusTabletInterface::instance().getDeviceList(tabletId);
-    QDBusReply<bool> isTouchSensor = DBusTabletInterface::instance().isTouchSensor(tabletId);
-    if (isTouchSensor.isValid() && isTouchSensor.value()) {
-        qCDebug(KCM) << "Ignoring tablet" << deviceName << tabletId << "because it's a touch sensor";
-        return;
-    }
+    const QString deviceName = snapshot.getInformation(TabletInfo::TabletName);
 
-    qCDebug(KCM) << "Adding tablet" << deviceName << tabletId << "with" << inputDevices.value();
+    qCDebug(KCM) << "Adding tablet" << deviceName << tabletId << "with" << snapshot.getDeviceList();
 
     d->ui.tabletListSelector->addItem(QString::fromLatin1("%1 [%2]").arg(deviceName).arg(tabletId),tabletId);
 }
@@ -26,6 +26,7 @@ namespace Wacom
 {
 
 class KCMWacomTabletWidgetPrivate;
+class TabletSnapshot;
 
 /**
   * This class implements the tabletwidget.ui designer file
@@ -117,10 +118,29 @@ private:
     /**
       * Load all connected tablets on startup
       *
+      * The tablet list is requested asynchronously and a snapshot of every
+      * tablet is requested in parallel as soon as the list arrives.
       * Later on use ontanletAdded and onTabletRemoved
       */
     void loadTabletInformation();
 
+    /**
+     * Asynchronously requests a snapshot of the given tablet from the daemon.
+     * The reply is handled by onTabletSnapshotReceived().
+     *
+     * @param tabletId The identifier of the tablet.
+     */
+    void requestTabletSnapshot(const QString &tabletId);
+
+    /**
+     * Caches a received tablet snapshot and adds the tablet to the selector.
+     * Touch sensors are not added but complete the touch page of their tablet.
+     *
+     * @param tabletId The identifier of the tablet.
+     * @param snapshot The snapshot received from the daemon.
+     */
+    void onTabletSnapshotReceived(const QString &tabletId, const TabletSnapshot &snapshot);
+
     /**
       * Activates the current profile for all connected devices (pen/stylus/eraser)
       * Happens when the profile is saved/switched/loaded
@@ -178,7 +198,7 @@ private:
 
     void showTabletFinder();
 
-    void addTabletToSelector(const QString &tabletId);
+    void addTabletToSelector(const QString &tabletId, const TabletSnapshot &snapshot);
 
     Q_DECLARE_PRIVATE( KCMWacomTabletWidget )
     KCMWacomTabletWidgetPrivate *const d_ptr; /**< d-pointer for this class */
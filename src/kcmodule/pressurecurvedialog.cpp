@@ -21,6 +21,7 @@
 #include "ui_pressurecurvedialog.h"
 
 #include "logging.h"
+#include "pressurecurve.h"
 #include "pressurecurvewidget.h"
 #include "dbustabletinterface.h"
 
@@ -54,22 +55,14 @@ PressureCurveDialog::~PressureCurveDialog()
 
 void PressureCurveDialog::setControllPoints(const QString & points)
 {
-    QStringList splitPoints = points.split(QLatin1Char( ' ' ));
-
-    if (splitPoints.count() != 4) {
-        qCDebug(KCM) << "Invalid number of control points, using defaults";
-        splitPoints.insert(0, QLatin1String("0"));
-        splitPoints.insert(1, QLatin1String("0"));
-        splitPoints.insert(2, QLatin1String("100"));
-        splitPoints.insert(3, QLatin1String("100"));
+    PressureCurve curve;
+
+    if (!curve.fromString(points)) {
+        qCDebug(KCM) << "Invalid control points, using defaults";
     }
 
-    qreal p1 = splitPoints.at(0).toDouble();
-    qreal p2 = splitPoints.at(1).toDouble();
-    qreal p3 = splitPoints.at(2).toDouble();
-    qreal p4 = splitPoints.at(3).toDouble();
-    m_ui->pc_Widget->setControlPoints(p1, p2, p3, p4);
-    m_ui->pc_Values->setText(QString::fromLatin1("%1 %2 %3 %4").arg(p1).arg(p2).arg(p3).arg(p4));
+    m_ui->pc_Widget->setControlPoints(curve.x1(), curve.y1(), curve.x2(), curve.y2());
+    m_ui->pc_Values->setText(curve.toString());
 }
 
 QString PressureCurveDialog::getControllPoints()
@@ -22,27 +22,41 @@
 //Qt includes
 #include <QDebug>
 #include <QPainter>
-#include <QPainterPath>
 #include <QMouseEvent>
 #include <QResizeEvent>
 #include <QTabletEvent>
 
 using namespace Wacom;
 
+namespace
+{
+    constexpr int CURVE_SEGMENTS    = 64;   /**< Number of line segments the presscurve is sampled into */
+    constexpr int FRAME_INTERVAL_MS = 16;   /**< Minimum time between two updates caused by tablet events */
+}
+
 PressureCurveWidget::PressureCurveWidget(QWidget *parent) :
         QWidget(parent)
 {
     setBackgroundRole(QPalette::Base);
     setAutoFillBackground(true);
+
+    m_tabletEventTimer.setSingleShot(true);
+    m_tabletEventTimer.setInterval(FRAME_INTERVAL_MS);
+    connect(&m_tabletEventTimer, &QTimer::timeout, this, &PressureCurveWidget::onPendingTabletEvent);
 }
 
 void PressureCurveWidget::setControlPoints(qreal p1, qreal p2, qreal p3, qreal p4)
 {
     // change y values upside down (xsetwacom has 0,0 in the lower left QWidget in the upper left)
+    m_pressureCurve = PressureCurve(qRound(p1), qRound(p2), qRound(p3), qRound(p4));
+
     p2 = 100 - p2;
     p4 = 100 - p4;
     m_cP1 = QPointF((p1 / 100.0) * width() , (p2 / 100.0) * height());
     m_cP2 = QPointF((p3 / 100.0) * width() , (p4 / 100.0) * height());
+
+    updateCurve();
+    update();
 }
 
 void PressureCurveWidget::mousePressEvent(QMouseEvent * event)
@@ -68,6 +82,7 @@ void PressureCurveWidget::resizeEvent(QResizeEvent * event)
     if (event->oldSize().width() == -1
             || event->oldSize().width() == 0
             || event->oldSize().height() == 0) {
+        updateCurve();
         return;
     }
 
@@ -78,6 +93,8 @@ void PressureCurveWidget::resizeEvent(QResizeEvent * event)
     m_cP1.setY(m_cP1.y() * yRatio);
     m_cP2.setX(m_cP2.x() * xRatio);
     m_cP2.setY(m_cP2.y() * yRatio);
+
+    updateCurve();
 }
 
 void PressureCurveWidget::tabletEvent(QTabletEvent * event)
@@ -87,13 +104,36 @@ void PressureCurveWidget::tabletEvent(QTabletEvent * event)
 
     constexpr qreal threshold = 0.001;
     if (m_pressure <= threshold) {
-        m_activePoint = 0;
+        // the pen was lifted, the last move must not get lost with the active point
+        if (m_hasPendingMove && m_activePoint > 0) {
+            moveControlPoint(m_pendingPosition);
+        }
+
+        m_hasPendingMove = false;
+        m_activePoint    = 0;
     }
 
     if (m_activePoint > 0) {
-        moveControlPoint(event->pos());
+        // only the latest position matters, it is applied with the next update
+        m_pendingPosition = event->position();
+        m_hasPendingMove  = true;
     } else if (m_pressure > threshold) {
-        setNearestPoint(event->pos());
+        setNearestPoint(event->position());
+    }
+
+    if (!m_tabletEventTimer.isActive()) {
+        m_tabletEventTimer.start();
+    }
+}
+
+void PressureCurveWidget::onPendingTabletEvent()
+{
+    if (m_hasPendingMove) {
+        m_hasPendingMove = false;
+
+        if (m_activePoint > 0) {
+            moveControlPoint(m_pendingPosition);
+        }
     }
 
     update();
@@ -145,18 +185,29 @@ void PressureCurveWidget::moveControlPoint(const QPointF & pos)
         break;
     }
 
-    // build string with controlpoints as used in xsetwacom settings
+    // build the curve as used in xsetwacom settings, y values are upside down
+    // the curve derives the second control point from the first one the way the driver expects it
     int p1 = qRound((m_cP1.x() / width())  * 100.0);
-    int p2 = qRound((m_cP1.y() / height()) * 100.0);
-    int p3 = qRound((m_cP2.x() / width())  * 100.0);
-    int p4 = qRound((m_cP2.y() / height()) * 100.0);
+    int p2 = 100 - qRound((m_cP1.y() / height()) * 100.0);
 
-    //change y values upside down
-    p2 = 100 - p2;
-    p4 = 100 - p4;
-    QString pointsString = QString::fromLatin1("%1 %2 %3 %4").arg(p1).arg(p2).arg(p3).arg(p4);
+    m_pressureCurve = PressureCurve::fromControlPoint(p1, p2);
+
+    updateCurve();
+
+    emit controlPointsChanged(m_pressureCurve.toString());
+}
 
-    emit controlPointsChanged(pointsString);
+void PressureCurveWidget::updateCurve()
+{
+    m_curve = m_pressureCurve.toPolyline(CURVE_SEGMENTS);
+
+    // scale to the widget, y values are upside down
+    for (QPointF& point : m_curve) {
+        point = QPointF(point.x() * width(), (1.0 - point.y()) * height());
+    }
+
+    m_areaBelowCurve = m_curve;
+    m_areaBelowCurve << QPointF(width(), height()) << QPointF(0, height());
 }
 
 void PressureCurveWidget::paintEvent(QPaintEvent * event)
@@ -182,23 +233,16 @@ void PressureCurveWidget::paintEvent(QPaintEvent * event)
     painter.drawLine(m_cP1, QPoint(0, height()));
     painter.drawLine(m_cP2, QPoint(width(), 0));
 
-    // create presscurve
-    QPainterPath curvePath;
-    curvePath.moveTo(0, height());
-    curvePath.cubicTo(m_cP1, m_cP2, QPoint(width(), 0));
-
-    //create polygon for the area below the curve
-    QPainterPath areaBelowCurve(curvePath);
-    areaBelowCurve.lineTo(width(), height());
-    areaBelowCurve.lineTo(0, height());
-    QRectF clearRect(m_pressure * width(), 0, width(), height());
-    QPainterPath subtract;
-    subtract.addRect(clearRect);
-
-    //draw below curve area
-    painter.setPen(QPen());
-    painter.setBrush(QColor(0, 102, 255));
-    painter.drawPath(areaBelowCurve.subtracted(subtract));
+    // draw below curve area up to the current pressure
+    // clipping the cached polygon is a lot cheaper than subtracting paths
+    if (m_pressure > 0) {
+        painter.save();
+        painter.setClipRect(QRectF(-1, -1, m_pressure * width() + 1, height() + 2));
+        painter.setPen(QPen());
+        painter.setBrush(QColor(0, 102, 255));
+        painter.drawPolygon(m_areaBelowCurve);
+        painter.restore();
+    }
 
     // draw presscurve
     QPen curvePen;
@@ -206,7 +250,7 @@ void PressureCurveWidget::paintEvent(QPaintEvent * event)
     curvePen.setColor(m_curveColor);
     painter.setPen(curvePen);
     painter.setBrush(QBrush());
-    painter.drawPath(curvePath);
+    painter.drawPolyline(m_curve);
 
     // draw controllpoints
     painter.setPen(QColor(226, 8, 0));
@@ -20,11 +20,15 @@
 #ifndef PRESSURECURVEWIDGET_H
 #define PRESSURECURVEWIDGET_H
 
+#include "pressurecurve.h"
+
 //Qt includes
 #include <QWidget>
 #include <QColor>
 #include <QSize>
 #include <QPoint>
+#include <QPolygonF>
+#include <QTimer>
 
 class QMouseEvent;
 class QPaintEvent;
@@ -138,6 +142,21 @@ protected:
       */
     void moveControlPoint(const QPointF & pos);
 
+    /**
+      * Samples the presscurve into a polyline and the area below it
+      * Called whenever the control points or the size of the widget change,
+      * so painting the widget does not need to rebuild the curve.
+      */
+    void updateCurve();
+
+protected slots:
+    /**
+      * Applies the latest pending tablet event
+      * Tablets report pressure far more often than the screen is refreshed,
+      * so tablet events are merged into one update per frame.
+      */
+    void onPendingTabletEvent();
+
 signals:
     /**
       * This signal will be fired if the position of the control points change
@@ -158,6 +177,12 @@ private:
     QColor  m_curveColor = Qt::black;     /**< Color of the curve */
     qreal   m_pressure = 0;              /**< Buffers the current stylus pressure. (0.0 - 1.0) used to animate the pressure */
     QColor  m_pressAreaColor = Qt::blue;  /**< Color of the press indication area */
+    PressureCurve m_pressureCurve;        /**< The presscurve as set on the driver */
+    QPolygonF m_curve;                    /**< The presscurve sampled as polyline */
+    QPolygonF m_areaBelowCurve;           /**< The area between the presscurve and the bottom of the widget */
+    QTimer  m_tabletEventTimer;           /**< Merges tablet events into one update per frame */
+    QPointF m_pendingPosition;            /**< Position of the latest tablet event which was not applied yet */
+    bool    m_hasPendingMove = false;     /**< True if a control point has to be moved to m_pendingPosition */
 };
 
 }
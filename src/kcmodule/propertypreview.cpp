@@ -0,0 +1,194 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "propertypreview.h"
+
+#include "logging.h"
+#include "dbustabletinterface.h"
+
+#include <QDBusReply>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QTimer>
+
+using namespace Wacom;
+
+namespace Wacom
+{
+    class PropertyPreviewPrivate
+    {
+        public:
+            QString                     tabletId;
+            QStringList                 deviceTypes;    //!< The devices to preview the values on.
+            QMap<QString, QVariantMap>  originalValues; //!< Values the devices had before the preview by device type.
+            QVariantMap                 pendingValues;  //!< Values which were not sent yet.
+            bool                        isPreviewed = false; //!< Values were sent which were not reverted yet.
+            QTimer                      sendTimer;      //!< Sends the pending values once the interval elapsed.
+            QElapsedTimer               lastSent;       //!< Time since the devices were updated the last time.
+    };
+
+    const int PropertyPreview::DEFAULT_INTERVAL = 100;
+}
+
+
+PropertyPreview::PropertyPreview(const QString& tabletId, const QStringList& deviceTypes, QObject* parent)
+    : QObject(parent), d_ptr(new PropertyPreviewPrivate)
+{
+    Q_D(PropertyPreview);
+
+    d->tabletId    = tabletId;
+    d->deviceTypes = deviceTypes;
+
+    d->sendTimer.setSingleShot(true);
+    d->sendTimer.setInterval(DEFAULT_INTERVAL);
+    connect(&d->sendTimer, &QTimer::timeout, this, &PropertyPreview::sendPendingValues);
+}
+
+
+PropertyPreview::~PropertyPreview()
+{
+    delete this->d_ptr;
+}
+
+
+int PropertyPreview::getInterval() const
+{
+    Q_D(const PropertyPreview);
+
+    return d->sendTimer.interval();
+}
+
+
+bool PropertyPreview::isActive() const
+{
+    Q_D(const PropertyPreview);
+
+    return d->isPreviewed;
+}
+
+
+void PropertyPreview::preview(const QVariantMap& values)
+{
+    Q_D(PropertyPreview);
+
+    if (values.isEmpty()) {
+        return;
+    }
+
+    // later values of the same property replace earlier ones
+    for (auto value = values.constBegin() ; value != values.constEnd() ; ++value) {
+        d->pendingValues.insert(value.key(), value.value());
+    }
+
+    if (d->sendTimer.isActive()) {
+        return;
+    }
+
+    const int interval = d->sendTimer.interval();
+
+    if (!d->lastSent.isValid() || d->lastSent.elapsed() >= interval) {
+        sendPendingValues();
+    } else {
+        d->sendTimer.start(static_cast<int>(interval - d->lastSent.elapsed()));
+    }
+}
+
+
+void PropertyPreview::readOriginalValues(const QStringList& properties)
+{
+    Q_D(PropertyPreview);
+
+    d->originalValues.clear();
+
+    foreach (const QString& deviceType, d->deviceTypes) {
+        const QVariantMap originalValues = readProperties(deviceType, properties);
+
+        // empty values can not be restored
+        for (auto value = originalValues.constBegin() ; value != originalValues.constEnd() ; ++value) {
+            if (!value.value().toString().isEmpty()) {
+                d->originalValues[deviceType].insert(value.key(), value.value());
+            }
+        }
+    }
+}
+
+
+void PropertyPreview::revert()
+{
+    Q_D(PropertyPreview);
+
+    d->sendTimer.stop();
+    d->pendingValues.clear();
+
+    if (d->isPreviewed) {
+        for (auto device = d->originalValues.constBegin() ; device != d->originalValues.constEnd() ; ++device) {
+            writeProperties(device.key(), device.value());
+        }
+    }
+
+    d->isPreviewed = false;
+    d->lastSent.invalidate();
+}
+
+
+void PropertyPreview::setInterval(int msec)
+{
+    Q_D(PropertyPreview);
+
+    d->sendTimer.setInterval(qMax(0, msec));
+}
+
+
+QVariantMap PropertyPreview::readProperties(const QString& deviceType, const QStringList& properties)
+{
+    Q_D(PropertyPreview);
+
+    QDBusReply<QVariantMap> reply = DBusTabletInterface::instance().getProperties(d->tabletId, deviceType, properties);
+
+    if (!reply.isValid()) {
+        qCWarning(KCM) << QString::fromLatin1("Could not read properties '%1' of device '%2': %3").arg(properties.join(QLatin1Char(','))).arg(deviceType).arg(reply.error().message());
+        return QVariantMap();
+    }
+
+    return reply.value();
+}
+
+
+void PropertyPreview::writeProperties(const QString& deviceType, const QVariantMap& values)
+{
+    Q_D(PropertyPreview);
+
+    DBusTabletInterface::instance().setProperties(d->tabletId, deviceType, values);
+}
+
+
+void PropertyPreview::sendPendingValues()
+{
+    Q_D(PropertyPreview);
+
+    foreach (const QString& deviceType, d->deviceTypes) {
+        writeProperties(deviceType, d->pendingValues);
+    }
+
+    d->pendingValues.clear();
+    d->isPreviewed = true;
+    d->lastSent.start();
+}
+
+#include "moc_propertypreview.cpp"
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTYPREVIEW_H
+#define PROPERTYPREVIEW_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+namespace Wacom
+{
+
+class PropertyPreviewPrivate;
+
+/**
+ * @brief Pushes property values to tablet devices while the user is still editing them.
+ *
+ * Values are sent through the D-Bus tablet service. While the user drags
+ * something around, only the latest values are sent and at most once per
+ * interval. The values the devices had before the preview started are
+ * read up front, so the preview can be reverted once the user is done.
+ */
+class PropertyPreview : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Default time in milliseconds between two updates of the devices.
+     */
+    static const int DEFAULT_INTERVAL;
+
+    /**
+     * @param tabletId    The tablet to preview the values on.
+     * @param deviceTypes The keys of the devices to preview the values on.
+     * @param parent      The parent of this object.
+     */
+    PropertyPreview(const QString& tabletId, const QStringList& deviceTypes, QObject* parent = nullptr);
+
+    ~PropertyPreview() override;
+
+    /**
+     * @return The minimum time in milliseconds between two updates of the devices.
+     */
+    int getInterval() const;
+
+    /**
+     * @return True if values were previewed which were not reverted yet.
+     */
+    bool isActive() const;
+
+    /**
+     * Previews property values on all devices. Values which were not sent
+     * yet are replaced by newer values of the same property.
+     *
+     * @param values A map of property keys to their new values.
+     */
+    void preview(const QVariantMap& values);
+
+    /**
+     * Reads the current values of the given properties from all devices.
+     * This has to be done before anything is previewed, as revert() restores
+     * these values.
+     *
+     * @param properties The keys of the properties which are going to be previewed.
+     */
+    void readOriginalValues(const QStringList& properties);
+
+    /**
+     * Drops all pending values and restores the values which were read by
+     * readOriginalValues(). Devices without original values are not restored.
+     */
+    void revert();
+
+    /**
+     * Sets the minimum time in milliseconds between two updates of the devices.
+     */
+    void setInterval(int msec);
+
+
+protected:
+
+    /**
+     * Reads the current values of the given properties from a device.
+     */
+    virtual QVariantMap readProperties(const QString& deviceType, const QStringList& properties);
+
+    /**
+     * Sets the given property values on a device as one transaction.
+     */
+    virtual void writeProperties(const QString& deviceType, const QVariantMap& values);
+
+
+private:
+
+    /**
+     * Sends the pending values to all devices.
+     */
+    void sendPendingValues();
+
+    Q_DECLARE_PRIVATE(PropertyPreview)
+    PropertyPreviewPrivate *const d_ptr; //!< D-Pointer for this class.
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
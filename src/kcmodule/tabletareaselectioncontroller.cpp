@@ -22,6 +22,8 @@
 #include "logging.h"
 #include "tabletareaselectionview.h"
 #include "calibrationdialog.h"
+#include "propertypreview.h"
+#include "property.h"
 
 #include "stringutils.h"
 #include "screensinfo.h"
@@ -42,6 +44,7 @@ namespace Wacom {
             QString                  deviceName;            // the device this instance is handling
             ScreenMap                screenMap;             // the current screen mappings
             ScreenRotation           tabletRotation = ScreenRotation::NONE;        // the tablet rotation
+            PropertyPreview         *preview = nullptr;    // the live preview if enabled, parented to the controller
     };
 }
 
@@ -80,6 +83,16 @@ const ScreenSpace TabletAreaSelectionController::getScreenSpace() const
 }
 
 
+void TabletAreaSelectionController::revertPreview()
+{
+    Q_D(TabletAreaSelectionController);
+
+    if (d->preview) {
+        d->preview->revert();
+    }
+}
+
+
 void TabletAreaSelectionController::select(const ScreenSpace& screenSpace)
 {
     Q_D(TabletAreaSelectionController);
@@ -92,10 +105,27 @@ void TabletAreaSelectionController::select(const ScreenSpace& screenSpace)
 
     d->currentScreen = screenSpace;
     d->view->select(screenSpace.toString(), screenSpace.isDesktop(), getMapping(d->currentScreen));
+
+    // the selection of another screen has to be previewed even if it did not change
+    onSelectionChanged();
 }
 
 
 
+void TabletAreaSelectionController::setLivePreview(const QString& tabletId, const QStringList& deviceTypes)
+{
+    Q_D(TabletAreaSelectionController);
+
+    if (d->preview) {
+        d->preview->revert();
+        delete d->preview;
+    }
+
+    d->preview = new PropertyPreview(tabletId, deviceTypes, this);
+    d->preview->readOriginalValues(QStringList() << Property::Area.key() << Property::ScreenSpace.key());
+}
+
+
 void TabletAreaSelectionController::setView(TabletAreaSelectionView* view)
 {
     Q_D(TabletAreaSelectionController);
@@ -107,6 +137,7 @@ void TabletAreaSelectionController::setView(TabletAreaSelectionView* view)
         disconnect(d->view, SIGNAL(signalScreenToggle()),         this, SLOT(onScreenToggle()));
         disconnect(d->view, SIGNAL(signalSetScreenProportions()), this, SLOT(onSetScreenProportions()));
         disconnect(d->view, SIGNAL(signalTabletAreaSelection()),  this, SLOT(onTabletAreaSelected()));
+        disconnect(d->view, SIGNAL(signalSelectionChanged()),     this, SLOT(onSelectionChanged()));
     }
 
     // save view and connect signals
@@ -118,6 +149,7 @@ void TabletAreaSelectionController::setView(TabletAreaSelectionView* view)
         connect(view, SIGNAL(signalScreenToggle()),         this, SLOT(onScreenToggle()));
         connect(view, SIGNAL(signalSetScreenProportions()), this, SLOT(onSetScreenProportions()));
         connect(view, SIGNAL(signalTabletAreaSelection()),  this, SLOT(onTabletAreaSelected()));
+        connect(view, SIGNAL(signalSelectionChanged()),     this, SLOT(onSelectionChanged()));
     }
 }
 
@@ -242,6 +274,25 @@ void TabletAreaSelectionController::onTabletAreaSelected()
 }
 
 
+void TabletAreaSelectionController::onSelectionChanged()
+{
+    Q_D(TabletAreaSelectionController);
+
+    if (!d->preview || !hasView()) {
+        return;
+    }
+
+    // the daemon maps the area to the screen space, so both have to be previewed together
+    const TabletArea area = convertAreaFromRotation(d->tabletGeometry, d->view->getSelection(), d->tabletRotation);
+
+    QVariantMap values;
+    values.insert(Property::Area.key(), area.toString());
+    values.insert(Property::ScreenSpace.key(), d->currentScreen.toString());
+
+    d->preview->preview(values);
+}
+
+
 bool TabletAreaSelectionController::hasView() const
 {
     Q_D(const TabletAreaSelectionController);
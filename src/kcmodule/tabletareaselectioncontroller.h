@@ -27,6 +27,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 
 namespace Wacom
 {
@@ -56,12 +57,29 @@ public:
      */
     const ScreenSpace getScreenSpace() const;
 
+    /**
+     * Restores the values the tablet had before the selection was previewed.
+     */
+    void revertPreview();
+
     /**
      * Shows the selection for the given screen space.
      */
     void select(const ScreenSpace& screenSpace);
 
 
+    /**
+     * Enables the live preview. Once enabled, every change of the selection
+     * is applied to the given devices while the user is still editing it.
+     * The current values of the devices are read right away, so the preview
+     * can be reverted.
+     *
+     * @param tabletId    The identifier of the tablet to preview the selection on.
+     * @param deviceTypes The keys of the devices to preview the selection on.
+     */
+    void setLivePreview(const QString& tabletId, const QStringList& deviceTypes);
+
+
     /**
      * Sets the view. When a view has been set, the controller
      * needs to be set up again.
@@ -109,6 +127,11 @@ public slots:
      */
     void onTabletAreaSelected();
 
+    /**
+     * Called by the view whenever the selected tablet area changed.
+     */
+    void onSelectionChanged();
+
 
 private:
 
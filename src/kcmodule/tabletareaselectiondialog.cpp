@@ -87,6 +87,14 @@ void TabletAreaSelectionDialog::select(const ScreenSpace& screenSpace)
 }
 
 
+void TabletAreaSelectionDialog::setLivePreview(const QString& tabletId, const QStringList& deviceTypes)
+{
+    Q_D(TabletAreaSelectionDialog);
+
+    d->selectionWidget->setLivePreview(tabletId, deviceTypes);
+}
+
+
 void TabletAreaSelectionDialog::setupWidget(const ScreenMap& mappings, const QString& deviceName, const ScreenRotation& rotation)
 {
     Q_D(TabletAreaSelectionDialog);
@@ -95,6 +103,24 @@ void TabletAreaSelectionDialog::setupWidget(const ScreenMap& mappings, const QSt
 }
 
 
+void TabletAreaSelectionDialog::accept()
+{
+    Q_D(TabletAreaSelectionDialog);
+
+    // the selection is applied with the profile once the user saves it
+    d->selectionWidget->revertPreview();
+    QDialog::accept();
+}
+
+
+void TabletAreaSelectionDialog::reject()
+{
+    Q_D(TabletAreaSelectionDialog);
+
+    d->selectionWidget->revertPreview();
+    QDialog::reject();
+}
+
 
 void TabletAreaSelectionDialog::setupUi()
 {
@@ -27,6 +27,7 @@
 #include <QDialog>
 #include <QRect>
 #include <QList>
+#include <QStringList>
 
 namespace Wacom
 {
@@ -62,8 +63,24 @@ public:
 
     void select(const ScreenSpace& screenSpace);
 
+    /**
+     * Previews the selection on the given devices while the user edits it.
+     * The preview is reverted when the dialog is closed, an accepted selection
+     * is applied when the profile is saved.
+     *
+     * @param tabletId    The identifier of the tablet to preview the selection on.
+     * @param deviceTypes The keys of the devices to preview the selection on.
+     */
+    void setLivePreview(const QString& tabletId, const QStringList& deviceTypes);
+
     void setupWidget( const ScreenMap& mappings, const QString& deviceName, const ScreenRotation& rotation );
 
+public slots:
+
+    void accept() override;
+
+    void reject() override;
+
 private:
 
     /**
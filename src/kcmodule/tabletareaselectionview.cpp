@@ -248,6 +248,7 @@ void TabletAreaSelectionView::setTabletAreaType(TabletAreaSelectionView::TabletA
         d->ui->areaWidget->setEnabled(false);
 
         emit signalFullTabletSelection();
+        emit signalSelectionChanged();
 
     } else {
         d->ui->tabletAreaRadioButton->setChecked(true);
@@ -272,6 +273,8 @@ void TabletAreaSelectionView::onSelectionChanged()
     d->ui->lineEditY->setText(QString::number(selection.y()));
     d->ui->lineEditWidth->setText(QString::number(selection.width()));
     d->ui->lineEditHeight->setText(QString::number(selection.height()));
+
+    emit signalSelectionChanged();
 }
 
 void TabletAreaSelectionView::onFineTuneValuesChanged(QString)
@@ -294,6 +297,8 @@ void TabletAreaSelectionView::onFineTuneValuesChanged(QString)
     }
 
     d->ui->areaWidget->setSelection(newSelection, false);
+
+    emit signalSelectionChanged();
 }
 
 bool TabletAreaSelectionView::isFullAreaSelection(const TabletArea &selection) const
@@ -318,6 +323,7 @@ void TabletAreaSelectionView::setupUi()
     // FIXME: signal-slot editor can't see this signal for some reason
     // TODO: rename areaWidget and screenArea, this is confusing
     connect(d->ui->areaWidget, &AreaSelectionWidget::selectionChanged, this, &TabletAreaSelectionView::onSelectionChanged);
+    connect(d->ui->areaWidget, &AreaSelectionWidget::selectionDragged, this, &TabletAreaSelectionView::signalSelectionChanged);
 
     connect(d->ui->lineEditX, &QLineEdit::textChanged, this, &TabletAreaSelectionView::onFineTuneValuesChanged);
     connect(d->ui->lineEditY, &QLineEdit::textChanged, this, &TabletAreaSelectionView::onFineTuneValuesChanged);
@@ -156,6 +156,12 @@ signals:
      */
     void signalScreenToggle();
 
+    /**
+     * Signals the controller that the selected tablet area changed.
+     * This is also emitted while the user is still dragging the selection.
+     */
+    void signalSelectionChanged();
+
     /**
      * Signals the controller that the user wants to set screen proportions.
      */
@@ -64,6 +64,14 @@ const ScreenSpace TabletAreaSelectionWidget::getScreenSpace() const
 }
 
 
+void TabletAreaSelectionWidget::revertPreview()
+{
+    Q_D(TabletAreaSelectionWidget);
+
+    d->controller.revertPreview();
+}
+
+
 
 void TabletAreaSelectionWidget::select(const ScreenSpace& screenSpace)
 {
@@ -73,6 +81,14 @@ void TabletAreaSelectionWidget::select(const ScreenSpace& screenSpace)
 }
 
 
+void TabletAreaSelectionWidget::setLivePreview(const QString& tabletId, const QStringList& deviceTypes)
+{
+    Q_D(TabletAreaSelectionWidget);
+
+    d->controller.setLivePreview(tabletId, deviceTypes);
+}
+
+
 void TabletAreaSelectionWidget::setupWidget(const ScreenMap& mappings, const QString& deviceName, const ScreenRotation& rotation)
 {
     Q_D(TabletAreaSelectionWidget);
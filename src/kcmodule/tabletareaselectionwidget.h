@@ -25,6 +25,7 @@
 #include "screenrotation.h"
 
 #include <QObject>
+#include <QStringList>
 #include <QWidget>
 
 namespace Wacom
@@ -45,8 +46,12 @@ public:
 
     const ScreenSpace getScreenSpace() const;
 
+    void revertPreview();
+
     void select(const ScreenSpace& screenSpace);
 
+    void setLivePreview(const QString& tabletId, const QStringList& deviceTypes);
+
     void setupWidget( const ScreenMap& mappings, const QString& deviceName, const ScreenRotation& rotation );
 
 
@@ -20,12 +20,13 @@
 #include "tabletpagewidget.h"
 #include "ui_tabletpagewidget.h"
 
-#include "dbustabletinterface.h"
 #include "deviceprofile.h"
+#include "devicetype.h"
 #include "profilemanagement.h"
 #include "property.h"
 #include "stringutils.h"
 #include "tabletareaselectiondialog.h"
+#include "tabletsnapshot.h"
 #include "screensinfo.h"
 #include "x11wacom.h"
 
@@ -62,26 +63,20 @@ void TabletPageWidget::loadFromProfile(ProfileManagementInterface &profileManage
 }
 
 
-void TabletPageWidget::reloadWidget()
+void TabletPageWidget::reloadWidget(const TabletSnapshot &snapshot)
 {
     // get all tablet device names we need
-    QDBusReply<QString> stylusDeviceNameReply = DBusTabletInterface::instance().getDeviceName(_tabletId, DeviceType::Stylus.key());
-    QDBusReply<QString> touchDeviceNameReply  = DBusTabletInterface::instance().getDeviceName(_tabletId, DeviceType::Touch.key());
+    const QString stylusDeviceName = snapshot.getDeviceName(DeviceType::Stylus);
 
     // update name and maximum tablet area for all devices
-    _deviceNameStylus.clear();
-    _deviceNameTouch.clear();
-    _tabletGeometry = TabletArea();
-    _screenMap      = ScreenMap();
-
-    if (stylusDeviceNameReply.isValid()) {
-        _deviceNameStylus = stylusDeviceNameReply.value();
-        _tabletGeometry   = X11Wacom::getMaximumTabletArea(stylusDeviceNameReply.value());
-        _screenMap        = ScreenMap(_tabletGeometry);
-    }
+    _deviceNameStylus = stylusDeviceName;
+    _deviceNameTouch  = snapshot.getDeviceName(DeviceType::Touch);
+    _tabletGeometry   = TabletArea();
+    _screenMap        = ScreenMap();
 
-    if (touchDeviceNameReply.isValid()) {
-        _deviceNameTouch = touchDeviceNameReply.value();
+    if (!stylusDeviceName.isEmpty()) {
+        _tabletGeometry   = X11Wacom::getMaximumTabletArea(stylusDeviceName);
+        _screenMap        = ScreenMap(_tabletGeometry);
     }
 }
 
@@ -143,6 +138,7 @@ void TabletPageWidget::onTabletMappingClicked()
     TabletAreaSelectionDialog selectionDialog;
     selectionDialog.setupWidget( getScreenMap(), _deviceNameStylus, rotation);
     selectionDialog.select( getScreenSpace() );
+    selectionDialog.setLivePreview( _tabletId, QStringList({ DeviceType::Stylus.key(), DeviceType::Eraser.key() }) );
 
     if (selectionDialog.exec() == QDialog::Accepted) {
         setScreenMap(selectionDialog.getScreenMap());
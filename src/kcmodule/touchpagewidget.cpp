@@ -20,12 +20,13 @@
 #include "touchpagewidget.h"
 #include "ui_touchpagewidget.h"
 
-#include "dbustabletinterface.h"
 #include "deviceprofile.h"
+#include "devicetype.h"
 #include "profilemanagement.h"
 #include "property.h"
 #include "stringutils.h"
 #include "tabletareaselectiondialog.h"
+#include "tabletsnapshot.h"
 #include "x11wacom.h"
 
 #include <QStringList>
@@ -69,22 +70,16 @@ void TouchPageWidget::loadFromProfile(ProfileManagementInterface &profileManagem
 }
 
 
-void TouchPageWidget::reloadWidget()
+void TouchPageWidget::reloadWidget(const TabletSnapshot &snapshot)
 {
-    // get all tablet device names we need
-    QDBusReply<QString> touchDeviceNameReply  = DBusTabletInterface::instance().getDeviceName(_tabletId, DeviceType::Touch.key());
-
     // update name and maximum tablet area for all devices
-    _touchDeviceName.clear();
-    _tabletGeometry = TabletArea();
-    _screenMap      = ScreenMap();
-
-    if (touchDeviceNameReply.isValid()) {
-        _touchDeviceName = touchDeviceNameReply.value();
-        if (!_touchDeviceName.isEmpty()) { // touch device available
-            _tabletGeometry  = X11Wacom::getMaximumTabletArea(touchDeviceNameReply.value());
-            _screenMap       = ScreenMap(_tabletGeometry);
-        }
+    _touchDeviceName = snapshot.getDeviceName(DeviceType::Touch);
+    _tabletGeometry  = TabletArea();
+    _screenMap       = ScreenMap();
+
+    if (!_touchDeviceName.isEmpty()) { // touch device available
+        _tabletGeometry  = X11Wacom::getMaximumTabletArea(_touchDeviceName);
+        _screenMap       = ScreenMap(_tabletGeometry);
     }
 }
 
@@ -142,6 +137,7 @@ void TouchPageWidget::onTabletMappingClicked()
     TabletAreaSelectionDialog selectionDialog;
     selectionDialog.setupWidget( getScreenMap(), _touchDeviceName, _tabletRotation);
     selectionDialog.select( getScreenSpace() );
+    selectionDialog.setLivePreview( _tabletId, QStringList({ DeviceType::Touch.key() }) );
 
     if (selectionDialog.exec() == QDialog::Accepted) {
         setScreenMap(selectionDialog.getScreenMap());
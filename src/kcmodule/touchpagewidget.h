@@ -35,6 +35,7 @@ namespace Wacom
 {
 
 class ProfileManagementInterface;
+class TabletSnapshot;
 
 /**
  * The "Touch" tab of the main KCM widget.
@@ -57,8 +58,10 @@ public:
 
     /**
      * Reinitializes the widget when a new tablet gets connected.
+     *
+     * @param snapshot The current snapshot of the tablet set by setTabletId().
      */
-    void reloadWidget();
+    void reloadWidget(const TabletSnapshot &snapshot);
 
     /**
      * Saves the current settings to the current profile.
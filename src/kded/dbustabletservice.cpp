@@ -24,11 +24,13 @@
 #include "devicetype.h"
 #include "property.h"
 #include "tabletinfo.h"
+#include "tabletsnapshot.h"
 #include "wacomadaptor.h"
 
 #include <QDBusArgument>
 #include <QDBusConnection>
 #include <QDBusMetaType>
+#include <QTimer>
 
 using namespace Wacom;
 
@@ -41,7 +43,31 @@ namespace Wacom
             TabletHandlerInterface *tabletHandler = nullptr;
             QHash<QString, TabletInformation>        tabletInformationList; //!< Information of all currently connected tablets.
             QHash<QString, QString>                  currentProfileList;    //!< Currently active profile for each tablet.
+            QHash<QString, uint>                     stateVersionList;      //!< Version of the last published state of each tablet.
+            QHash<QString, TabletSnapshot>           publishedStateList;    //!< The state of each tablet as clients know it.
+            QHash<QString, TabletSnapshot>           pendingStateList;      //!< State changes per tablet which were not published yet.
+            QTimer                                   stateTimer;            //!< Publishes all state changes of one event loop turn as one delta.
+            QHash<QString, QHash<QString, QMap<QString,QString> > > pendingProperties; //!< Property changes per tablet and device which were not published yet.
+            QTimer                                   propertiesTimer;       //!< Coalesces property changes into one propertiesChanged signal.
     }; // CLASS
+
+    /**
+     * Time in milliseconds property changes are collected before they are published.
+     */
+    static const int PROPERTIES_CHANGED_DELAY = 50;
+
+    /**
+     * The device properties whose live values are part of a tablet snapshot.
+     * Keep this list short, every entry costs a backend read per snapshot.
+     */
+    static const struct {
+        const DeviceType& device;
+        const Property&   property;
+    } SNAPSHOT_PROPERTIES[] = {
+        { DeviceType::Stylus, Property::Mode   },
+        { DeviceType::Stylus, Property::Rotate },
+        { DeviceType::Touch,  Property::Touch  },
+    };
 } // NAMESPACE
 
 DBusTabletService::DBusTabletService(TabletHandlerInterface& tabletHandler)
@@ -51,6 +77,14 @@ DBusTabletService::DBusTabletService(TabletHandlerInterface& tabletHandler)
 
     d->tabletHandler = &tabletHandler;
 
+    d->propertiesTimer.setSingleShot(true);
+    d->propertiesTimer.setInterval(PROPERTIES_CHANGED_DELAY);
+    connect(&d->propertiesTimer, &QTimer::timeout, this, &DBusTabletService::publishProperties);
+
+    d->stateTimer.setSingleShot(true);
+    d->stateTimer.setInterval(0);
+    connect(&d->stateTimer, &QTimer::timeout, this, &DBusTabletService::publishStates);
+
     DBusTabletInterface::registerMetaTypes();
 
     d->wacomAdaptor = new WacomAdaptor( this );
@@ -228,6 +262,108 @@ bool DBusTabletService::isTouchSensor(const QString &tabletId)
     return d->tabletInformationList.value(tabletId).getBool(TabletInfo::IsTouchSensor);
 }
 
+QVariantMap DBusTabletService::getTabletSnapshot(const QString &tabletId)
+{
+    Q_D ( DBusTabletService );
+
+    if (!d->tabletInformationList.contains(tabletId)) {
+        qCWarning(KDED) << QString::fromLatin1("Can not create snapshot of unknown tablet '%1'!").arg(tabletId);
+        return QVariantMap();
+    }
+
+    // publish pending changes first, so the snapshot version covers them
+    // and clients mirroring the state do not miss them
+    if (d->pendingStateList.contains(tabletId)) {
+        publishStates();
+    }
+
+    const TabletInformation& info = d->tabletInformationList[tabletId];
+    TabletSnapshot           snapshot;
+
+    foreach (const TabletInfo& tabletInfo, TabletInfo::list()) {
+        snapshot.setInformation(tabletInfo, info.get(tabletInfo));
+    }
+
+    snapshot.setDeviceList(info.getDeviceList());
+
+    foreach (const DeviceType& type, DeviceType::list()) {
+        if (info.hasDevice(type)) {
+            snapshot.setDeviceName(type, info.getDeviceName(type));
+        }
+    }
+
+    snapshot.setStateVersion(d->stateVersionList.value(tabletId));
+    snapshot.setPadButtons(info.hasButtons());
+    snapshot.setProfile(d->currentProfileList.value(tabletId));
+    snapshot.setProfileList(d->tabletHandler->listProfiles(tabletId));
+    snapshot.setProfileRotationList(d->tabletHandler->getProfileRotationList(tabletId));
+
+    for (const auto& entry : SNAPSHOT_PROPERTIES) {
+        if (info.hasDevice(entry.device)) {
+            snapshot.setProperty(entry.device, entry.property, d->tabletHandler->getProperty(tabletId, entry.device, entry.property));
+        }
+    }
+
+    return snapshot.toVariantMap();
+}
+
+
+
+QVariantMap DBusTabletService::getProperties(const QString &tabletId, const QString& deviceType, const QStringList& properties) const
+{
+    Q_D ( const DBusTabletService );
+
+    QVariantMap values;
+
+    const DeviceType* type = DeviceType::find(deviceType);
+
+    if (!type) {
+        qCWarning(KDED) << QString::fromLatin1("Can not get properties '%1' from invalid device '%2'!").arg(properties.join(QLatin1Char(','))).arg(deviceType);
+        return values;
+    }
+
+    foreach (const QString& property, properties) {
+        const Property* prop = Property::find(property);
+
+        if (!prop) {
+            qCWarning(KDED) << QString::fromLatin1("Can not get invalid property '%1' from device '%2'!").arg(property).arg(deviceType);
+            continue;
+        }
+
+        values.insert(prop->key(), d->tabletHandler->getProperty(tabletId, *type, *prop));
+    }
+
+    return values;
+}
+
+
+
+void DBusTabletService::setProperties(const QString &tabletId, const QString& deviceType, const QVariantMap& values)
+{
+    Q_D ( DBusTabletService );
+
+    const DeviceType* type = DeviceType::find(deviceType);
+
+    if (!type) {
+        qCWarning(KDED) << QString::fromLatin1("Can not set properties '%1' on invalid device '%2'!").arg(values.keys().join(QLatin1Char(','))).arg(deviceType);
+        return;
+    }
+
+    DeviceProfile properties(*type);
+
+    for (QVariantMap::const_iterator iter = values.constBegin() ; iter != values.constEnd() ; ++iter) {
+        const Property* prop = Property::find(iter.key());
+
+        if (!prop || !properties.setProperty(*prop, iter.value().toString())) {
+            qCWarning(KDED) << QString::fromLatin1("Can not set invalid property '%1' on device '%2' to '%3'!").arg(iter.key()).arg(deviceType).arg(iter.value().toString());
+        }
+    }
+
+    d->tabletHandler->setProperties(tabletId, properties);
+}
+
+
+
 void DBusTabletService::onProfileChanged(const QString &tabletId, const QString& profile)
 {
     Q_D ( DBusTabletService );
@@ -235,6 +371,65 @@ void DBusTabletService::onProfileChanged(const QString &tabletId, const QString&
     d->currentProfileList.insert(tabletId, profile);
 
     emit profileChanged(tabletId, profile);
+
+    // the properties of the new profile are published by onPropertyChanged()
+    TabletSnapshot delta;
+    delta.setProfile(profile);
+
+    queueState(tabletId, delta);
+}
+
+
+
+void DBusTabletService::onPropertyChanged(const QString &tabletId, const DeviceType& deviceType, const Property& property, const QString& value)
+{
+    Q_D ( DBusTabletService );
+
+    // later writes of the same property replace earlier ones
+    d->pendingProperties[tabletId][deviceType.key()].insert(property.key(), value);
+
+    if (!d->propertiesTimer.isActive()) {
+        d->propertiesTimer.start();
+    }
+
+    if (value.isEmpty()) {
+        return;
+    }
+
+    for (const auto& entry : SNAPSHOT_PROPERTIES) {
+        if (entry.device == deviceType && entry.property == property) {
+            TabletSnapshot delta;
+            delta.setProperty(deviceType, property, value);
+            queueState(tabletId, delta);
+            return;
+        }
+    }
+}
+
+
+
+void DBusTabletService::onDevicePropertiesChanged(const QString &tabletId, const DeviceType& deviceType)
+{
+    Q_D ( DBusTabletService );
+
+    if (!d->tabletInformationList.contains(tabletId)) {
+        return;
+    }
+
+    // clients mirror the snapshot, so read its values of this device again
+    TabletSnapshot delta;
+    bool           hasChanges = false;
+
+    for (const auto& entry : SNAPSHOT_PROPERTIES) {
+        if (entry.device == deviceType) {
+            delta.setProperty(deviceType, entry.property, d->tabletHandler->getProperty(tabletId, deviceType, entry.property));
+            hasChanges = true;
+        }
+    }
+
+    if (hasChanges) {
+        queueState(tabletId, delta);
+    }
 }
 
 
@@ -256,8 +451,83 @@ void DBusTabletService::onTabletRemoved(const QString &tabletId)
 
     d->currentProfileList.remove(tabletId);
     d->tabletInformationList.remove(tabletId);
+    d->pendingProperties.remove(tabletId);
+    d->publishedStateList.remove(tabletId);
+    d->pendingStateList.remove(tabletId);
 
     emit tabletRemoved(tabletId);
 }
 
+
+
+void DBusTabletService::queueState(const QString &tabletId, const TabletSnapshot& delta)
+{
+    Q_D ( DBusTabletService );
+
+    if (!d->tabletInformationList.contains(tabletId)) {
+        return;
+    }
+
+    // later changes of the same value replace earlier ones
+    d->pendingStateList[tabletId].merge(delta);
+
+    if (!d->stateTimer.isActive()) {
+        d->stateTimer.start();
+    }
+}
+
+
+void DBusTabletService::publishStates()
+{
+    Q_D ( DBusTabletService );
+
+    // take the pending changes first, so signal handlers can queue new ones
+    const QHash<QString, TabletSnapshot> pendingStateList = d->pendingStateList;
+    d->pendingStateList.clear();
+
+    for (auto tablet = pendingStateList.constBegin() ; tablet != pendingStateList.constEnd() ; ++tablet) {
+        TabletSnapshot&    published = d->publishedStateList[tablet.key()];
+        const QVariantMap& known     = published.toVariantMap();
+        const QVariantMap& pending   = tablet.value().toVariantMap();
+        QVariantMap        changes;
+
+        // values the clients already know do not need a new version
+        for (auto iter = pending.constBegin() ; iter != pending.constEnd() ; ++iter) {
+            if (known.value(iter.key()) != iter.value()) {
+                changes.insert(iter.key(), iter.value());
+            }
+        }
+
+        if (changes.isEmpty()) {
+            continue;
+        }
+
+        // versions are never reset, so they stay unique if a tablet is reconnected
+        const uint version = d->stateVersionList.value(tablet.key()) + 1;
+        d->stateVersionList.insert(tablet.key(), version);
+
+        TabletSnapshot delta(changes);
+        delta.setStateVersion(version);
+        published.merge(delta);
+
+        emit stateChanged(tablet.key(), version, delta.toVariantMap());
+    }
+}
+
+
+void DBusTabletService::publishProperties()
+{
+    Q_D ( DBusTabletService );
+
+    // take the pending changes first, so signal handlers can queue new ones
+    const QHash<QString, QHash<QString, QMap<QString,QString> > > pendingProperties = d->pendingProperties;
+    d->pendingProperties.clear();
+
+    for (auto tablet = pendingProperties.constBegin() ; tablet != pendingProperties.constEnd() ; ++tablet) {
+        for (auto device = tablet.value().constBegin() ; device != tablet.value().constEnd() ; ++device) {
+            emit propertiesChanged(tablet.key(), device.key(), device.value());
+        }
+    }
+}
+
 #include "moc_dbustabletservice.cpp"
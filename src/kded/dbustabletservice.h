@@ -23,13 +23,16 @@
 #include "tablethandlerinterface.h"
 #include "tabletinformation.h"
 
+#include <QMap>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QVariantMap>
 
 namespace Wacom
 {
 class DBusTabletServicePrivate;
+class TabletSnapshot;
 
 /**
  * @brief The D-Bus tablet service.
@@ -206,6 +209,46 @@ public Q_SLOTS:
      */
     Q_SCRIPTABLE bool isTouchSensor(const QString &tabletId);
 
+    /**
+     * @brief Returns everything a client needs to display a tablet in one call.
+     *
+     * The snapshot contains all tablet information values, the device list
+     * and device names, the current profile, the profile list, the profile
+     * rotation list, the live values of a few selected properties and the
+     * state version. Use TabletSnapshot to read it and stateChanged() to keep
+     * it up to date. Pending state changes are published before the snapshot
+     * is taken.
+     *
+     * @param tabletId The id of the tablet.
+     *
+     * @return The snapshot or an empty map if the tablet is not available.
+     */
+    Q_SCRIPTABLE QVariantMap getTabletSnapshot(const QString &tabletId);
+
+    /**
+     * Gets the current values of several properties from one device.
+     *
+     * @param tabletId   The id of the tablet.
+     * @param deviceType Type of device (stylus/eraser/...) to get the values from.
+     * @param properties The properties we are looking for.
+     *
+     * @return A map of property keys to their values. Invalid properties are not part of the map.
+     */
+    Q_SCRIPTABLE QVariantMap getProperties(const QString &tabletId, const QString& deviceType,
+                                           const QStringList& properties) const;
+
+    /**
+     * Sets several properties on one device as a single transaction.
+     * The properties are applied in the order required by the backend,
+     * no matter in which order they are passed.
+     *
+     * @param tabletId   The id of the tablet.
+     * @param deviceType The device type to set the values on.
+     * @param values     A map of property keys to their new string values.
+     */
+    Q_SCRIPTABLE void setProperties(const QString &tabletId, const QString& deviceType,
+                                    const QVariantMap& values);
+
 // d-bus signals
 Q_SIGNALS:
 
@@ -230,6 +273,24 @@ Q_SIGNALS:
       */
     Q_SCRIPTABLE void profileChanged(const QString &tabletId, const QString& profile);
 
+    /**
+      * Emitted when a part of the tablet snapshot changed.
+      *
+      * The delta is a partial snapshot which only contains the changed values.
+      * The version is increased by one with every delta of a tablet, so a client
+      * which mirrors the snapshot can detect a missed delta and fetch a new one.
+      */
+    Q_SCRIPTABLE void stateChanged(const QString &tabletId, uint version, const QVariantMap& delta);
+
+    /**
+      * Emitted when properties of a tablet device were set.
+      *
+      * All changes made within a short time window are coalesced, so a whole
+      * profile or a setProperties() transaction results in one signal per device.
+      * The values map property keys to the values which were written.
+      */
+    Q_SCRIPTABLE void propertiesChanged(const QString &tabletId, const QString& deviceType, const QMap<QString,QString>& values);
+
 
 // normal Qt slots
 public slots:
@@ -237,6 +298,12 @@ public slots:
     //! Has to be called when the current profile was changed.
     void onProfileChanged (const QString &tabletId, const QString& profile);
 
+    //! Has to be called when a property of a tablet device was set.
+    void onPropertyChanged (const QString &tabletId, const Wacom::DeviceType& deviceType, const Wacom::Property& property, const QString& value);
+
+    //! Has to be called when properties of a tablet device were changed outside of our control.
+    void onDevicePropertiesChanged (const QString &tabletId, const Wacom::DeviceType& deviceType);
+
     //! Has to be called when a new tablet is added.
     void onTabletAdded (const TabletInformation& info);
 
@@ -245,6 +312,24 @@ public slots:
 
 
 private:
+
+    /**
+     * Queues a state change of a tablet. All changes made within one event
+     * loop turn are published as one delta by publishStates().
+     */
+    void queueState(const QString &tabletId, const TabletSnapshot& delta);
+
+    /**
+     * Publishes the pending state changes of every tablet whose values differ
+     * from the ones the clients know and increases its state version.
+     */
+    void publishStates();
+
+    /**
+     * Emits a propertiesChanged signal for every device with pending property changes.
+     */
+    void publishProperties();
+
     Q_DECLARE_PRIVATE(DBusTabletService)
     DBusTabletServicePrivate *const d_ptr; /**< d-pointer for this class */
 
@@ -22,6 +22,7 @@
 
 #include "screenrotation.h"
 
+#include <QStringList>
 #include <QWidget>
 
 namespace Wacom
@@ -70,6 +71,9 @@ Q_SIGNALS:
      */
     void screenRotated (const ScreenRotation& screenRotation);
 
+    //! Emitted when properties of a tablet device were changed by anyone, including us.
+    void devicePropertiesChanged (const QString& deviceName, const QStringList& properties);
+
 
 protected:
     explicit EventNotifier(QWidget *parent = nullptr);
@@ -21,8 +21,7 @@
 
 #include "logging.h"
 #include "procsystemproperty.h"
-
-#include <QProcess>
+#include "sysfsledwriter.h"
 
 using namespace Wacom;
 
@@ -30,13 +29,17 @@ namespace Wacom {
 class ProcSystemAdaptorPrivate
 {
     public:
+        ProcSystemAdaptorPrivate(const QString& deviceNode, const QString& sysfsRoot)
+            : ledWriter(deviceNode, sysfsRoot) {}
+
         QString        deviceName;
+        SysfsLedWriter ledWriter;  //!< Writes the LEDs of this tablet only.
 }; // CLASS
 } // NAMESPACE
 
 
-ProcSystemAdaptor::ProcSystemAdaptor(const QString& deviceName)
-    : PropertyAdaptor(nullptr), d_ptr(new ProcSystemAdaptorPrivate)
+ProcSystemAdaptor::ProcSystemAdaptor(const QString& deviceName, const QString& deviceNode, const QString& sysfsRoot)
+    : PropertyAdaptor(nullptr), d_ptr(new ProcSystemAdaptorPrivate(deviceNode, sysfsRoot))
 {
     Q_D(ProcSystemAdaptor);
     d->deviceName = deviceName;
@@ -68,6 +71,8 @@ const QString ProcSystemAdaptor::getProperty(const Property& property) const
 
 bool ProcSystemAdaptor::setProperty(const Property& property, const QString& value)
 {
+    Q_D(ProcSystemAdaptor);
+
     qCDebug(KDED) << QString::fromLatin1("Setting property '%1' to '%2'.").arg(property.key()).arg(value);
 
     // https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-driver-wacom
@@ -86,36 +91,22 @@ bool ProcSystemAdaptor::setProperty(const Property& property, const QString& val
     */
     // https://www.kernel.org/doc/Documentation/leds/leds-class.txt
 
-    QString cmd;
+    bool ok = false;
+    int  intValue = value.toInt(&ok);
+
+    if (!ok) {
+        return false;
+    }
+
     if (property == Property::StatusLEDs) {
-        int statusLed = value.toInt();
-        if(statusLed < 4 && statusLed >= 0) {
-            cmd = QString::fromLatin1("bash -c \"echo %1 > /sys/bus/hid/devices/*/wacom_led/status_led0_select\"").arg(statusLed);
-        }
-        else if(statusLed < 8 && statusLed >= 4) {
-            statusLed -= 4;
-            cmd = QString::fromLatin1("bash -c \"echo %1 > /sys/bus/hid/devices/*/wacom_led/status_led1_select\"").arg(statusLed);
-        }
-        else {
-            return false;
-        }
+        return d->ledWriter.setStatusLED(intValue);
+
     } else if (property == Property::StatusLEDsBrightness) {
-        int statusLedBrightness = value.toInt();
-        if(statusLedBrightness < 128 && statusLedBrightness >= 0) {
-            cmd = QString::fromLatin1("bash -c \"echo %1 > /sys/bus/hid/devices/*/wacom_led/status0_luminance\"").arg(statusLedBrightness);
-        }
-        else if(statusLedBrightness < 256 && statusLedBrightness >= 128) {
-            statusLedBrightness -= 128;
-            cmd = QString::fromLatin1("bash -c \"echo %1 > /sys/bus/hid/devices/*/wacom_led/status1_luminance\"").arg(statusLedBrightness);
-        }
-        else {
-            return false;
-        }
-    } else {
-        qCWarning(KDED) << "Unknown Property: " << property.key();
+        return d->ledWriter.setStatusLEDBrightness(intValue);
     }
 
-    return QProcess::execute(cmd, {}) == 0;
+    qCWarning(KDED) << "Unknown Property: " << property.key();
+    return false;
 }
 
 
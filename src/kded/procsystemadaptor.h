@@ -32,13 +32,20 @@ class ProcSystemProperty;
 class ProcSystemAdaptorPrivate;
 
 /**
- * A property adaptor which uses the proc system to set LED properties on a device.
+ * A property adaptor which uses the sysfs interface of the kernel driver to
+ * set LED properties on a device.
  */
 class ProcSystemAdaptor : public PropertyAdaptor
 {
 public:
-    //! Default constructor.
-    explicit ProcSystemAdaptor(const QString& deviceName);
+    /**
+     * Default constructor.
+     *
+     * @param deviceName The name of the device, only used for messages.
+     * @param deviceNode The device node of the device, i.e. "/dev/input/event5".
+     * @param sysfsRoot  The directory sysfs is mounted on. Only changed by unit tests.
+     */
+    ProcSystemAdaptor(const QString& deviceName, const QString& deviceNode, const QString& sysfsRoot = QLatin1String("/sys"));
 
     //! Destructor
     ~ProcSystemAdaptor() override;
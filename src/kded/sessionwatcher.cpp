@@ -0,0 +1,299 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sessionwatcher.h"
+
+#include "logging.h"
+
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusUnixFileDescriptor>
+#include <QDBusVariant>
+
+#include <unistd.h>
+
+namespace Wacom
+{
+    class SessionWatcherPrivate
+    {
+        public:
+            SessionWatcherPrivate(const QDBusConnection& connection)
+                : connection(connection) {}
+
+            static const QString MANAGER_PATH;
+            static const QString MANAGER_INTERFACE;
+            static const QString SESSION_INTERFACE;
+            static const QString USER_INTERFACE;
+            static const QString PROPERTIES_INTERFACE;
+
+            QDBusConnection         connection;
+            QString                 service;
+            QString                 sessionPath;
+            QDBusUnixFileDescriptor sleepLock;          //!< Delays suspend until the tablet settings were captured.
+            bool                    isStarted  = false;
+            bool                    isSleeping = false;
+            bool                    isInactive = false;
+    }; // CLASS
+
+    const QString SessionWatcherPrivate::MANAGER_PATH         = QLatin1String("/org/freedesktop/login1");
+    const QString SessionWatcherPrivate::MANAGER_INTERFACE    = QLatin1String("org.freedesktop.login1.Manager");
+    const QString SessionWatcherPrivate::SESSION_INTERFACE    = QLatin1String("org.freedesktop.login1.Session");
+    const QString SessionWatcherPrivate::USER_INTERFACE       = QLatin1String("org.freedesktop.login1.User");
+    const QString SessionWatcherPrivate::PROPERTIES_INTERFACE = QLatin1String("org.freedesktop.DBus.Properties");
+} // NAMESPACE
+
+using namespace Wacom;
+
+SessionWatcher::SessionWatcher(QObject* parent)
+    : SessionWatcher(QDBusConnection::systemBus(), QLatin1String("org.freedesktop.login1"), parent)
+{
+}
+
+
+SessionWatcher::SessionWatcher(const QDBusConnection& connection, const QString& service, QObject* parent)
+    : QObject(parent)
+    , d_ptr(new SessionWatcherPrivate(connection))
+{
+    Q_D(SessionWatcher);
+
+    d->service = service;
+}
+
+
+SessionWatcher::~SessionWatcher()
+{
+    delete d_ptr;
+}
+
+
+
+bool SessionWatcher::start()
+{
+    Q_D(SessionWatcher);
+
+    if (d->isStarted) {
+        return true;
+    }
+
+    if (!d->connection.isConnected()) {
+        qCWarning(KDED) << "Can not watch for suspend and session changes as the system bus is not available.";
+        return false;
+    }
+
+    if (!d->connection.connect(d->service, SessionWatcherPrivate::MANAGER_PATH, SessionWatcherPrivate::MANAGER_INTERFACE,
+                               QLatin1String("PrepareForSleep"), this, SLOT(onPrepareForSleep(bool)))) {
+        qCWarning(KDED) << "Can not watch for suspend as logind is not available.";
+        return false;
+    }
+
+    d->isStarted = true;
+
+    takeSleepLock();
+    findSession();
+
+    return true;
+}
+
+
+
+const QString& SessionWatcher::getSessionPath() const
+{
+    Q_D(const SessionWatcher);
+
+    return d->sessionPath;
+}
+
+
+
+void SessionWatcher::onPrepareForSleep(bool start)
+{
+    Q_D(SessionWatcher);
+
+    qCDebug(KDED) << (start ? "System is going to sleep." : "System resumed.");
+
+    setPaused(start, d->isInactive);
+
+    // the settings were captured by now, so the system may go to sleep
+    if (start) {
+        d->sleepLock = QDBusUnixFileDescriptor();
+    } else {
+        takeSleepLock();
+    }
+}
+
+
+
+void SessionWatcher::onSessionPropertiesChanged(const QString& interface, const QVariantMap& changedProperties, const QStringList& invalidatedProperties)
+{
+    Q_D(SessionWatcher);
+    Q_UNUSED(invalidatedProperties);
+
+    auto active = changedProperties.constFind(QLatin1String("Active"));
+
+    if (interface != SessionWatcherPrivate::SESSION_INTERFACE || active == changedProperties.constEnd()) {
+        return;
+    }
+
+    qCDebug(KDED) << (active.value().toBool() ? "Session became active." : "Session became inactive.");
+
+    setPaused(d->isSleeping, !active.value().toBool());
+}
+
+
+
+void SessionWatcher::callAsync(const QDBusMessage& message, const std::function<void(const QDBusMessage&)>& onReply)
+{
+    Q_D(SessionWatcher);
+
+    // the watcher is owned by us, so no reply is handled after we are gone
+    QDBusPendingCallWatcher* watcher = new QDBusPendingCallWatcher(d->connection.asyncCall(message), this);
+
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [onReply](QDBusPendingCallWatcher* call) {
+        call->deleteLater();
+        onReply(call->reply());
+    });
+}
+
+
+
+void SessionWatcher::findSession()
+{
+    Q_D(SessionWatcher);
+
+    const QString sessionId = QString::fromLocal8Bit(qgetenv("XDG_SESSION_ID"));
+
+    if (!sessionId.isEmpty()) {
+        QDBusMessage message = QDBusMessage::createMethodCall(d->service, SessionWatcherPrivate::MANAGER_PATH,
+                                                              SessionWatcherPrivate::MANAGER_INTERFACE, QLatin1String("GetSession"));
+        message << sessionId;
+
+        callAsync(message, [this](const QDBusMessage& reply) {
+            if (reply.type() == QDBusMessage::ErrorMessage) {
+                qCWarning(KDED) << "Can not find the logind session:" << reply.errorMessage();
+            }
+
+            watchSession(reply.arguments().value(0).value<QDBusObjectPath>().path());
+        });
+        return;
+    }
+
+    QDBusMessage message = QDBusMessage::createMethodCall(d->service, SessionWatcherPrivate::MANAGER_PATH,
+                                                          SessionWatcherPrivate::MANAGER_INTERFACE, QLatin1String("GetUser"));
+    message << static_cast<uint>(getuid());
+
+    callAsync(message, [this](const QDBusMessage& reply) {
+        Q_D(SessionWatcher);
+
+        if (reply.type() == QDBusMessage::ErrorMessage) {
+            qCWarning(KDED) << "Can not find the logind user:" << reply.errorMessage();
+            watchSession(QString());
+            return;
+        }
+
+        QDBusMessage message = QDBusMessage::createMethodCall(d->service, reply.arguments().value(0).value<QDBusObjectPath>().path(),
+                                                              SessionWatcherPrivate::PROPERTIES_INTERFACE, QLatin1String("Get"));
+        message << SessionWatcherPrivate::USER_INTERFACE << QLatin1String("Display");
+
+        callAsync(message, [this](const QDBusMessage& reply) {
+            QString         sessionId;
+            QDBusObjectPath sessionPath;
+
+            if (reply.type() == QDBusMessage::ErrorMessage) {
+                qCWarning(KDED) << "Can not find the display session of the user:" << reply.errorMessage();
+            } else {
+                // the display session is a struct of the session id and its path
+                const QDBusArgument display = reply.arguments().value(0).value<QDBusVariant>().variant().value<QDBusArgument>();
+
+                display.beginStructure();
+                display >> sessionId >> sessionPath;
+                display.endStructure();
+            }
+
+            watchSession(sessionPath.path());
+        });
+    });
+}
+
+
+
+void SessionWatcher::takeSleepLock()
+{
+    Q_D(SessionWatcher);
+
+    QDBusMessage message = QDBusMessage::createMethodCall(d->service, SessionWatcherPrivate::MANAGER_PATH,
+                                                          SessionWatcherPrivate::MANAGER_INTERFACE, QLatin1String("Inhibit"));
+    message << QLatin1String("sleep")
+            << QLatin1String("Wacom Tablet")
+            << QLatin1String("Saving the tablet settings")
+            << QLatin1String("delay");
+
+    callAsync(message, [this](const QDBusMessage& reply) {
+        Q_D(SessionWatcher);
+
+        if (reply.type() == QDBusMessage::ErrorMessage) {
+            qCDebug(KDED) << "Can not delay suspend:" << reply.errorMessage();
+            return;
+        }
+
+        // the system went to sleep before the lock was granted
+        if (!d->isSleeping) {
+            d->sleepLock = reply.arguments().value(0).value<QDBusUnixFileDescriptor>();
+        }
+    });
+}
+
+
+
+void SessionWatcher::watchSession(const QString& sessionPath)
+{
+    Q_D(SessionWatcher);
+
+    if (sessionPath.isEmpty() || sessionPath == QLatin1String("/")) {
+        qCWarning(KDED) << "No logind session found, tablet settings lost on VT switches will not be restored.";
+        return;
+    }
+
+    d->sessionPath = sessionPath;
+
+    d->connection.connect(d->service, d->sessionPath, SessionWatcherPrivate::PROPERTIES_INTERFACE, QLatin1String("PropertiesChanged"),
+                          this, SLOT(onSessionPropertiesChanged(QString,QVariantMap,QStringList)));
+}
+
+
+
+void SessionWatcher::setPaused(bool isSleeping, bool isInactive)
+{
+    Q_D(SessionWatcher);
+
+    bool wasPaused = d->isSleeping || d->isInactive;
+    bool isPaused  = isSleeping || isInactive;
+
+    d->isSleeping = isSleeping;
+    d->isInactive = isInactive;
+
+    if (isPaused && !wasPaused) {
+        emit sessionPaused();
+
+    } else if (!isPaused && wasPaused) {
+        emit sessionResumed();
+    }
+}
+
+#include "moc_sessionwatcher.cpp"
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SESSIONWATCHER_H
+#define SESSIONWATCHER_H
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <functional>
+
+namespace Wacom
+{
+
+class SessionWatcherPrivate;
+
+/**
+ * Watches logind for the system being suspended and for the session of
+ * the daemon becoming inactive, i.e. on VT switches.
+ *
+ * The X server might reset the properties of its input devices in both
+ * cases, so the tablet settings have to be checked once the system was
+ * resumed or the session became active again.
+ */
+class SessionWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Creates a watcher for logind on the system bus.
+     */
+    explicit SessionWatcher(QObject* parent = nullptr);
+
+    /**
+     * Creates a watcher for a logind compatible service on the given bus.
+     * Only used by unit tests.
+     *
+     * @param connection The bus to connect to.
+     * @param service    The service name of logind.
+     */
+    SessionWatcher(const QDBusConnection& connection, const QString& service, QObject* parent = nullptr);
+
+    ~SessionWatcher() override;
+
+    /**
+     * Connects to the logind signals. The session of the daemon is looked
+     * up in the background.
+     *
+     * @return True on success, false if logind is not available.
+     */
+    bool start();
+
+    /**
+     * @return The object path of the logind session which is watched for
+     *         VT switches or an empty string if it was not found (yet).
+     */
+    const QString& getSessionPath() const;
+
+
+Q_SIGNALS:
+    /**
+     * Emitted before the system is suspended or when the session becomes inactive.
+     */
+    void sessionPaused();
+
+    /**
+     * Emitted after the system was resumed or when the session becomes active again.
+     */
+    void sessionResumed();
+
+
+private Q_SLOTS:
+    void onPrepareForSleep(bool start);
+
+    void onSessionPropertiesChanged(const QString& interface, const QVariantMap& changedProperties, const QStringList& invalidatedProperties);
+
+
+private:
+    /**
+     * Calls a logind method without blocking the daemon.
+     *
+     * @param message The method call.
+     * @param onReply Called with the reply or the error message.
+     */
+    void callAsync(const QDBusMessage& message, const std::function<void(const QDBusMessage&)>& onReply);
+
+    /**
+     * Looks up the session of the daemon by $XDG_SESSION_ID or, as kded may
+     * run as a systemd user service outside of any session, as the display
+     * session of the user.
+     */
+    void findSession();
+
+    /**
+     * Takes a logind delay lock, so the tablet settings can be captured
+     * before the system goes to sleep.
+     */
+    void takeSleepLock();
+
+    /**
+     * Watches the given session for becoming active or inactive.
+     *
+     * @param sessionPath The object path of the session, empty or "/" if there is none.
+     */
+    void watchSession(const QString& sessionPath);
+
+    /**
+     * Updates the paused state and emits the matching signal.
+     */
+    void setPaused(bool isSleeping, bool isInactive);
+
+    Q_DECLARE_PRIVATE(SessionWatcher)
+    SessionWatcherPrivate *const d_ptr; /**< d-pointer for this class */
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
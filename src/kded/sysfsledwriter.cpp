@@ -0,0 +1,257 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sysfsledwriter.h"
+
+#include "logging.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace Wacom;
+
+namespace Wacom {
+class SysfsLedWriterPrivate
+{
+    public:
+        QString deviceNode;       //!< The device node the tablet was resolved from.
+        QString sysfsRoot;        //!< The sysfs mount point.
+        QString deviceDirectory;  //!< The HID device directory of the tablet.
+
+        // legacy wacom_led attributes
+        QString ledSelect[2];     //!< The status_led<n>_select attribute of both LED groups.
+        QString luminance[2];     //!< The status<n>_luminance attributes.
+
+        // LED class devices
+        QString ledBrightness[8]; //!< The brightness attribute of each LED.
+        int     ledMaxBrightness[8];
+}; // CLASS
+} // NAMESPACE
+
+
+SysfsLedWriter::SysfsLedWriter(const QString& deviceNode, const QString& sysfsRoot)
+    : d_ptr(new SysfsLedWriterPrivate)
+{
+    Q_D(SysfsLedWriter);
+
+    d->deviceNode = deviceNode;
+    d->sysfsRoot  = sysfsRoot;
+
+    for (int i = 0 ; i < 8 ; ++i) {
+        d->ledMaxBrightness[i] = 0;
+    }
+
+    resolve();
+}
+
+
+SysfsLedWriter::~SysfsLedWriter()
+{
+    delete this->d_ptr;
+}
+
+
+const QString& SysfsLedWriter::getDeviceDirectory() const
+{
+    Q_D(const SysfsLedWriter);
+    return d->deviceDirectory;
+}
+
+
+bool SysfsLedWriter::isAvailable() const
+{
+    Q_D(const SysfsLedWriter);
+
+    if (!d->ledSelect[0].isEmpty()) {
+        return true;
+    }
+
+    for (int i = 0 ; i < 8 ; ++i) {
+        if (!d->ledBrightness[i].isEmpty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool SysfsLedWriter::setStatusLED(int led)
+{
+    Q_D(SysfsLedWriter);
+
+    if (led < 0 || led >= 8) {
+        return false;
+    }
+
+    const int group = led / 4;
+
+    if (!d->ledSelect[group].isEmpty()) {
+        return writeAttribute(d->ledSelect[group], led % 4);
+    }
+
+    // the LED class driver selects a LED of a group when its brightness is set
+    if (!d->ledBrightness[led].isEmpty()) {
+        return writeAttribute(d->ledBrightness[led], d->ledMaxBrightness[led]);
+    }
+
+    qCDebug(KDED) << QString::fromLatin1("Status LED %1 of device '%2' is not available.").arg(led).arg(d->deviceNode);
+    return false;
+}
+
+
+bool SysfsLedWriter::setStatusLEDBrightness(int brightness)
+{
+    Q_D(SysfsLedWriter);
+
+    if (brightness < 0 || brightness >= 256) {
+        return false;
+    }
+
+    const int group = brightness / 128;
+
+    if (d->luminance[group].isEmpty()) {
+        // the LED class interface has no separate luminance for pressed styli
+        qCDebug(KDED) << QString::fromLatin1("Status LED luminance of device '%1' is not available.").arg(d->deviceNode);
+        return false;
+    }
+
+    return writeAttribute(d->luminance[group], brightness % 128);
+}
+
+
+void SysfsLedWriter::resolve()
+{
+    Q_D(SysfsLedWriter);
+
+    if (d->deviceNode.isEmpty()) {
+        qCDebug(KDED) << "Can not resolve status LEDs as the device node is unknown.";
+        return;
+    }
+
+    // /sys/class/input/eventN links to the event device below the HID device
+    const QString eventName = QFileInfo(d->deviceNode).fileName();
+    const QString rootPath  = QFileInfo(d->sysfsRoot).canonicalFilePath();
+    QString       path      = QFileInfo(QString::fromLatin1("%1/class/input/%2").arg(d->sysfsRoot).arg(eventName)).canonicalFilePath();
+
+    if (path.isEmpty() || rootPath.isEmpty()) {
+        qCDebug(KDED) << QString::fromLatin1("Could not find sysfs entry of device '%1'.").arg(d->deviceNode);
+        return;
+    }
+
+    // walk up until we find the device which exports the LEDs
+    QDir directory(path);
+
+    while (directory.absolutePath().startsWith(rootPath) && directory.absolutePath() != rootPath) {
+
+        if (directory.exists(QLatin1String("wacom_led"))) {
+            const QString ledPath = directory.absoluteFilePath(QLatin1String("wacom_led"));
+
+            d->deviceDirectory = directory.absolutePath();
+
+            for (int group = 0 ; group < 2 ; ++group) {
+                const QString select    = QString::fromLatin1("%1/status_led%2_select").arg(ledPath).arg(group);
+                const QString luminance = QString::fromLatin1("%1/status%2_luminance").arg(ledPath).arg(group);
+
+                if (QFile::exists(select)) {
+                    d->ledSelect[group] = select;
+                }
+
+                if (QFile::exists(luminance)) {
+                    d->luminance[group] = luminance;
+                }
+            }
+            return;
+        }
+
+        if (directory.exists(QLatin1String("leds"))) {
+            QDir ledsDirectory(directory.absoluteFilePath(QLatin1String("leds")));
+
+            // LED class devices are named "<hid device>::wacom-<group>.<led>"
+            foreach (const QString& ledName, ledsDirectory.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+                int separator = ledName.lastIndexOf(QLatin1String("::wacom-"));
+
+                if (separator < 0) {
+                    continue;
+                }
+
+                const QStringView groupAndLed = QStringView(ledName).mid(separator + 8);
+                const int         dot         = groupAndLed.indexOf(QLatin1Char('.'));
+
+                bool groupOk = false;
+                bool ledOk   = false;
+                int  group   = groupAndLed.left(dot).toInt(&groupOk);
+                int  led     = groupAndLed.mid(dot + 1).toInt(&ledOk);
+
+                if (dot < 0 || !groupOk || !ledOk || group < 0 || group > 1 || led < 0 || led > 3) {
+                    continue;
+                }
+
+                const QString ledPath    = ledsDirectory.absoluteFilePath(ledName);
+                const int     index      = group * 4 + led;
+                QFile         maxBrightness(ledPath + QLatin1String("/max_brightness"));
+
+                d->ledBrightness[index]    = ledPath + QLatin1String("/brightness");
+                d->ledMaxBrightness[index] = 255;
+
+                if (maxBrightness.open(QIODevice::ReadOnly)) {
+                    bool ok    = false;
+                    int  value = maxBrightness.readAll().trimmed().toInt(&ok);
+
+                    if (ok) {
+                        d->ledMaxBrightness[index] = value;
+                    }
+                }
+            }
+
+            if (isAvailable()) {
+                d->deviceDirectory = directory.absolutePath();
+                return;
+            }
+        }
+
+        if (!directory.cdUp()) {
+            break;
+        }
+    }
+
+    qCDebug(KDED) << QString::fromLatin1("Device '%1' does not have status LEDs.").arg(d->deviceNode);
+}
+
+
+bool SysfsLedWriter::writeAttribute(const QString& path, int value) const
+{
+    QFile attribute(path);
+
+    if (!attribute.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        qCWarning(KDED) << QString::fromLatin1("Could not open '%1' for writing: %2").arg(path).arg(attribute.errorString());
+        return false;
+    }
+
+    // sysfs attributes have to be written with a single write call
+    const QByteArray data = QByteArray::number(value) + '\n';
+
+    if (attribute.write(data) != data.size()) {
+        qCWarning(KDED) << QString::fromLatin1("Could not write '%1': %2").arg(path).arg(attribute.errorString());
+        return false;
+    }
+
+    return true;
+}
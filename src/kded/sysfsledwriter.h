@@ -0,0 +1,110 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYSFSLEDWRITER_H
+#define SYSFSLEDWRITER_H
+
+#include <QString>
+
+namespace Wacom {
+
+class SysfsLedWriterPrivate;
+
+/**
+ * Writes the status LEDs of a single Wacom tablet using the sysfs interface
+ * of the kernel driver.
+ *
+ * The HID device directory of the tablet is resolved once from the device node
+ * of one of its input devices, i.e. "/dev/input/event5". The legacy "wacom_led"
+ * attributes are used if the driver exports them, otherwise the LED class
+ * devices of the tablet are used.
+ *
+ * @sa https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-driver-wacom
+ * @sa https://www.kernel.org/doc/Documentation/leds/leds-class.txt
+ */
+class SysfsLedWriter
+{
+public:
+
+    /**
+     * Creates a new LED writer for the tablet the given device node belongs to.
+     *
+     * @param deviceNode The device node of one of the tablet's input devices.
+     * @param sysfsRoot  The directory sysfs is mounted on. Only changed by unit tests.
+     */
+    explicit SysfsLedWriter(const QString& deviceNode, const QString& sysfsRoot = QLatin1String("/sys"));
+
+    //! Destructor
+    ~SysfsLedWriter();
+
+    /**
+     * @return The HID device directory of the tablet or an empty string if it could not be found.
+     */
+    const QString& getDeviceDirectory() const;
+
+    /**
+     * @return True if the tablet has status LEDs which can be written.
+     */
+    bool isAvailable() const;
+
+    /**
+     * Selects a status LED. LEDs 0 to 3 belong to the first LED group,
+     * LEDs 4 to 7 to the second one.
+     *
+     * @param led The LED to select.
+     *
+     * @return True on success, false if the LED is invalid or could not be written.
+     */
+    bool setStatusLED(int led);
+
+    /**
+     * Sets the status LED luminance. Values from 0 to 127 set the luminance
+     * when the stylus does not touch the tablet, values from 128 to 255
+     * set the luminance (minus 128) when the stylus touches the tablet.
+     *
+     * @param brightness The brightness to set.
+     *
+     * @return True on success, false if the brightness is invalid or could not be written.
+     */
+    bool setStatusLEDBrightness(int brightness);
+
+private:
+
+    /**
+     * Resolves the HID device directory and the LED attributes of the tablet.
+     * This is only done once when the writer is created.
+     */
+    void resolve();
+
+    /**
+     * Writes a value to a sysfs attribute.
+     *
+     * @param path  The full path of the attribute.
+     * @param value The value to write.
+     *
+     * @return True on success, else false.
+     */
+    bool writeAttribute(const QString& path, int value) const;
+
+    Q_DECLARE_PRIVATE( SysfsLedWriter )
+    SysfsLedWriterPrivate *const d_ptr; /**< d-pointer for this class */
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
@@ -24,6 +24,10 @@
 #include "procsystemproperty.h"
 #include "property.h"
 #include "propertyset.h"
+#include "screentopology.h"
+#include "stringutils.h"
+
+#include <QSet>
 
 namespace Wacom
 {
@@ -33,6 +37,49 @@ namespace Wacom
             TabletBackend::DeviceMap deviceAdaptors;
             PropertyAdaptor*         statusLEDAdaptor;
             TabletInformation        tabletInformation;
+
+            typedef QMap<QString, QMap<QString, QString> > PropertyValueMap;
+
+            PropertyValueMap appliedValues;  //!< Last values set for fingerprint and mapping properties by device type.
+            PropertyValueMap fingerprint;    //!< Fingerprint property values as read back from the devices.
+
+            QMap<QString, quint64> screenSpaceGenerations; //!< The screen topology generation of the last screen space by device type.
+
+            mutable PropertyValueMap cachedValues;          //!< Last values written to or read from the devices by device type.
+            bool                     isCacheVerified = false; //!< Read cached values from the devices anyway and compare them.
+
+            /**
+             * The properties which are checked after a resume. The X server
+             * usually loses all or none of them.
+             */
+            static bool isFingerprintProperty(const Property& property)
+            {
+                return property == Property::Area          || property == Property::Rotate ||
+                       property == Property::ScreenSpace   || property == Property::PressureCurve;
+            }
+
+            /**
+             * The properties which are set by TabletBackend::remapDevice().
+             */
+            static bool isMappingProperty(const Property& property)
+            {
+                return property == Property::Mode || property == Property::Area || property == Property::ScreenSpace;
+            }
+
+            /**
+             * The properties the driver changes when the given property is set.
+             * The transformation matrix is not cached, letterboxing it to a new
+             * area is done by TabletBackend::updateLetterbox().
+             */
+            static QList<Property> getDependentProperties(const Property& property)
+            {
+                // the driver resets the area whenever the rotation changes
+                if (property == Property::Rotate || property == Property::ResetArea) {
+                    return QList<Property>() << Property::Area;
+                }
+
+                return QList<Property>();
+            }
     };
 }
 
@@ -43,7 +90,15 @@ TabletBackend::TabletBackend(const Wacom::TabletInformation& tabletInformation)
     Q_D(TabletBackend);
     d->tabletInformation = tabletInformation;
 
-    d_ptr->statusLEDAdaptor = new ProcSystemAdaptor(d->tabletInformation.getDeviceName(DeviceType::Pad));
+    // the LEDs belong to the HID device of the pad, but every device of the tablet will do
+    const DeviceInformation* ledDevice = d->tabletInformation.getDevice(DeviceType::Pad);
+
+    if (!ledDevice) {
+        ledDevice = d->tabletInformation.getDevice(DeviceType::Stylus);
+    }
+
+    d_ptr->statusLEDAdaptor = new ProcSystemAdaptor(d->tabletInformation.getDeviceName(DeviceType::Pad),
+                                                    ledDevice ? ledDevice->getDeviceNode() : QString());
 }
 
 TabletBackend::~TabletBackend()
@@ -89,6 +144,69 @@ const QString TabletBackend::getProperty(const DeviceType& type, const Property&
 {
     Q_D(const TabletBackend);
 
+    // most reads would spawn a process, but the values rarely change behind our back
+    auto cachedDevice = d->cachedValues.constFind(type.key());
+    bool isCached     = (cachedDevice != d->cachedValues.constEnd() && cachedDevice->contains(property.key()));
+
+    if (isCached && !d->isCacheVerified) {
+        return cachedDevice->value(property.key());
+    }
+
+    const QString value = readProperty(type, property);
+
+    if (isCached && cachedDevice->value(property.key()).compare(value, Qt::CaseInsensitive) != 0) {
+        qCWarning(KDED) << QString::fromLatin1("Cached value '%1' of property '%2' of device '%3' differs from the device value '%4'!").arg(cachedDevice->value(property.key())).arg(property.key()).arg(type.key()).arg(value);
+    }
+
+    if (!value.isEmpty()) {
+        d->cachedValues[type.key()].insert(property.key(), value);
+    }
+
+    return value;
+}
+
+
+
+void TabletBackend::invalidateProperties(const DeviceType& type)
+{
+    Q_D(TabletBackend);
+
+    // the applied values might not be set anymore, so the next remap sets them again
+    if (type == DeviceType::Unknown) {
+        d->cachedValues.clear();
+        d->appliedValues.clear();
+        d->screenSpaceGenerations.clear();
+    } else {
+        d->cachedValues.remove(type.key());
+        d->appliedValues.remove(type.key());
+        d->screenSpaceGenerations.remove(type.key());
+    }
+}
+
+
+
+void TabletBackend::invalidateProperties(const DeviceType& type, const QList<Property>& properties)
+{
+    foreach (const Property& property, properties) {
+        forgetValue(type, property);
+    }
+}
+
+
+
+void TabletBackend::setPropertyCacheVerified(bool verify)
+{
+    Q_D(TabletBackend);
+
+    d->isCacheVerified = verify;
+}
+
+
+
+const QString TabletBackend::readProperty(const DeviceType& type, const Property& property) const
+{
+    Q_D(const TabletBackend);
+
     DeviceMap::const_iterator adaptors = d->deviceAdaptors.constFind(type);
     if (adaptors == d->deviceAdaptors.constEnd()) {
         qCWarning(KDED) << QString::fromLatin1("Could not get property '%1' from unsupported device type '%2'!").arg(property.key()).arg(type.key());
@@ -106,6 +224,21 @@ const QString TabletBackend::getProperty(const DeviceType& type, const Property&
 
 
 
+const QString TabletBackend::readPropertyState(const DeviceType& type, const Property& property) const
+{
+    Q_D(const TabletBackend);
+
+    foreach(const PropertyAdaptor* adaptor, d->deviceAdaptors.value(type)) {
+        if (adaptor->supportsProperty(property)) {
+            return adaptor->getPropertyState(property);
+        }
+    }
+
+    return QString();
+}
+
+
+
 void TabletBackend::setProfile(const TabletProfile& profile)
 {
     Q_D(TabletBackend);
@@ -138,6 +271,8 @@ void TabletBackend::setProfile(const DeviceType& deviceType, const DeviceProfile
     }
 
     QString value;
+    bool    isAreaChanged    = false;
+    bool    isScreenSpaceSet = false;
 
     // set properties on all adaptors
     foreach(PropertyAdaptor* adaptor, adaptors.value()) {
@@ -150,12 +285,21 @@ void TabletBackend::setProfile(const DeviceType& deviceType, const DeviceProfile
             if (profile.supportsProperty(property)) {
                 value = profile.getProperty(property);
 
-                if (!value.isEmpty()) {
-                    adaptor->setProperty(property, value);
+                // auto rotation and other values which are not set are not part of the fingerprint
+                if (!value.isEmpty() && adaptor->setProperty(property, value)) {
+                    rememberValue(deviceType, property, value);
+
+                    isAreaChanged    = isAreaChanged || property == Property::Area || property == Property::Rotate;
+                    isScreenSpaceSet = isScreenSpaceSet || property == Property::ScreenSpace;
                 }
             }
         }
     }
+
+    // the screen space is set after the area, unless the profile does not contain one
+    if (isAreaChanged && !isScreenSpaceSet) {
+        updateLetterbox(deviceType);
+    }
 }
 
 void TabletBackend::setStatusLED(int led)
@@ -193,5 +337,237 @@ bool TabletBackend::setProperty(const DeviceType& type, const Property& property
         }
     }
 
+    if (returnValue) {
+        rememberValue(type, property, value);
+
+        if (property == Property::Area || property == Property::Rotate) {
+            updateLetterbox(type);
+        }
+    } else {
+        forgetValue(type, property);
+    }
+
     return returnValue;
 }
+
+
+
+bool TabletBackend::remapDevice(const DeviceType& type, const QString& mode, const QString& area, const QString& screenSpace)
+{
+    Q_D(TabletBackend);
+
+    DeviceMap::iterator adaptors = d->deviceAdaptors.find(type);
+    if (adaptors == d->deviceAdaptors.end()) {
+        qCWarning(KDED) << QString::fromLatin1("Could not remap unsupported device type '%1'!").arg(type.key());
+        return false;
+    }
+
+    // compute all changes first, so they can be set back to back
+    const QMap<QString, QString> applied    = d->appliedValues.value(type.key());
+    const quint64                generation = ScreenTopology::current().generation();
+
+    // empty values are not set, just like setProfile() skips them
+    auto isChanged = [&applied](const Property& property, const QString& value) {
+        auto appliedValue = applied.constFind(property.key());
+        return (!value.isEmpty() && (appliedValue == applied.constEnd() || appliedValue.value() != value));
+    };
+
+    const bool isAreaChanged        = isChanged(Property::Area, area);
+    const bool isScreenSpaceChanged = !screenSpace.isEmpty() &&
+                                      (isAreaChanged || isChanged(Property::ScreenSpace, screenSpace) ||
+                                       d->screenSpaceGenerations.value(type.key()) != generation);
+
+    QList<Property> properties;
+    QStringList     values;
+
+    if (isChanged(Property::Mode, mode)) {
+        properties.append(Property::Mode);
+        values.append(mode);
+    }
+
+    if (isAreaChanged) {
+        properties.append(Property::Area);
+        values.append(area);
+    }
+
+    if (isScreenSpaceChanged) {
+        properties.append(Property::ScreenSpace);
+        values.append(screenSpace);
+    }
+
+    if (properties.isEmpty()) {
+        qCDebug(KDED) << QString::fromLatin1("Mapping of device '%1' is unchanged.").arg(type.key());
+        return true;
+    }
+
+    bool isRemapped = true;
+
+    for (int i = 0 ; i < properties.size() ; ++i) {
+        bool isSet = false;
+
+        foreach (PropertyAdaptor* adaptor, adaptors.value()) {
+            if (adaptor->supportsProperty(properties.at(i)) && adaptor->setProperty(properties.at(i), values.at(i))) {
+                isSet = true;
+            }
+        }
+
+        if (isSet) {
+            rememberValue(type, properties.at(i), values.at(i));
+        } else {
+            // forget the old value, so the next remap sets it again
+            forgetValue(type, properties.at(i));
+            isRemapped = false;
+        }
+    }
+
+    if (!isRemapped) {
+        qCWarning(KDED) << QString::fromLatin1("Failed to remap device '%1'!").arg(type.key());
+    }
+
+    return isRemapped;
+}
+
+
+
+void TabletBackend::captureFingerprint()
+{
+    Q_D(TabletBackend);
+
+    d->fingerprint.clear();
+
+    for (auto device = d->appliedValues.constBegin() ; device != d->appliedValues.constEnd() ; ++device) {
+        const DeviceType* deviceType = DeviceType::find(device.key());
+
+        if (!deviceType) {
+            continue;
+        }
+
+        for (auto value = device->constBegin() ; value != device->constEnd() ; ++value) {
+            const Property* property = Property::find(value.key());
+
+            if (property && TabletBackendPrivate::isFingerprintProperty(*property)) {
+                d->fingerprint[device.key()].insert(value.key(), readPropertyState(*deviceType, *property));
+            }
+        }
+    }
+}
+
+
+
+int TabletBackend::restoreFingerprint()
+{
+    Q_D(TabletBackend);
+
+    if (d->fingerprint.isEmpty()) {
+        return -1;
+    }
+
+    // the devices may have lost any of their values
+    d->cachedValues.clear();
+
+    // restoring a value may forget the values which depend on it
+    const TabletBackendPrivate::PropertyValueMap fingerprint   = d->fingerprint;
+    const TabletBackendPrivate::PropertyValueMap appliedValues = d->appliedValues;
+    d->fingerprint.clear();
+
+    int  restored   = 0;
+    bool isRestored = true;
+
+    for (auto device = fingerprint.constBegin() ; device != fingerprint.constEnd() ; ++device) {
+        const DeviceType* deviceType = DeviceType::find(device.key());
+
+        if (!deviceType) {
+            continue;
+        }
+
+        // restore in the order setProfile() uses, e.g. a rotation resets the area
+        QSet<QString> checkedProperties;
+
+        foreach (PropertyAdaptor* adaptor, d->deviceAdaptors.value(*deviceType)) {
+            foreach (const Property& property, adaptor->getProperties()) {
+                auto value = device->constFind(property.key());
+
+                if (value == device->constEnd() || checkedProperties.contains(property.key())) {
+                    continue;
+                }
+
+                checkedProperties.insert(property.key());
+
+                // read it just now, as restoring an earlier property might have changed it
+                if (adaptor->getPropertyState(property) == value.value()) {
+                    continue;
+                }
+
+                const QString appliedValue = appliedValues.value(device.key()).value(property.key());
+
+                qCDebug(KDED) << QString::fromLatin1("Restoring lost property '%1' of device '%2' on tablet '%3'.").arg(property.key()).arg(deviceType->key()).arg(d->tabletInformation.get(TabletInfo::TabletName));
+
+                if (!appliedValue.isEmpty() && adaptor->setProperty(property, appliedValue)) {
+                    rememberValue(*deviceType, property, appliedValue);
+                    ++restored;
+                } else {
+                    qCWarning(KDED) << QString::fromLatin1("Failed to restore property '%1' of device '%2'!").arg(property.key()).arg(deviceType->key());
+                    forgetValue(*deviceType, property);
+                    isRestored = false;
+                }
+            }
+        }
+    }
+
+    // the caller has to apply everything again
+    return (isRestored ? restored : -1);
+}
+
+
+
+void TabletBackend::rememberValue(const DeviceType& type, const Property& property, const QString& value)
+{
+    Q_D(TabletBackend);
+
+    d->cachedValues[type.key()].insert(property.key(), value);
+
+    // whatever the driver changed on its own is neither cached nor applied anymore
+    foreach (const Property& dependentProperty, TabletBackendPrivate::getDependentProperties(property)) {
+        forgetValue(type, dependentProperty);
+    }
+
+    if (TabletBackendPrivate::isFingerprintProperty(property) || TabletBackendPrivate::isMappingProperty(property)) {
+        d->appliedValues[type.key()].insert(property.key(), value);
+    }
+
+    if (property == Property::ScreenSpace) {
+        d->screenSpaceGenerations.insert(type.key(), ScreenTopology::current().generation());
+    }
+}
+
+
+
+void TabletBackend::updateLetterbox(const DeviceType& type)
+{
+    Q_D(TabletBackend);
+
+    const QString screenSpace = d->appliedValues.value(type.key()).value(Property::ScreenSpace.key());
+
+    if (screenSpace.isEmpty() || !StringUtils::asBool(getProperty(type, Property::KeepAspectRatio))) {
+        return;
+    }
+
+    qCDebug(KDED) << QString::fromLatin1("Updating letterbox of device '%1' to its new tablet area.").arg(type.key());
+
+    // setting the screen space again letterboxes it to the current tablet area
+    foreach (PropertyAdaptor* adaptor, d->deviceAdaptors.value(type)) {
+        if (adaptor->supportsProperty(Property::ScreenSpace) && !adaptor->setProperty(Property::ScreenSpace, screenSpace)) {
+            forgetValue(type, Property::ScreenSpace);
+        }
+    }
+}
+
+
+
+void TabletBackend::forgetValue(const DeviceType& type, const Property& property)
+{
+    Q_D(TabletBackend);
+
+    d->appliedValues[type.key()].remove(property.key());
+    d->cachedValues[type.key()].remove(property.key());
+}
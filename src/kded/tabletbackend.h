@@ -83,11 +83,72 @@ public:
      */
     bool setProperty(const DeviceType& type, const Property& property, const QString& value) override;
 
+    /**
+     * @see TabletBackendInterface::remapDevice(const DeviceType&, const QString&, const QString&, const QString&)
+     */
+    bool remapDevice(const DeviceType& type, const QString& mode, const QString& area, const QString& screenSpace) override;
+
+    /**
+     * @see TabletBackendInterface::invalidateProperties(const DeviceType&)
+     */
+    void invalidateProperties(const DeviceType& type) override;
+
+    /**
+     * @see TabletBackendInterface::invalidateProperties(const DeviceType&, const QList<Property>&)
+     */
+    void invalidateProperties(const DeviceType& type, const QList<Property>& properties) override;
+
+    /**
+     * @see TabletBackendInterface::setPropertyCacheVerified(bool)
+     */
+    void setPropertyCacheVerified(bool verify) override;
+
+    /**
+     * @see TabletBackendInterface::captureFingerprint()
+     */
+    void captureFingerprint() override;
+
+    /**
+     * @see TabletBackendInterface::restoreFingerprint()
+     */
+    int restoreFingerprint() override;
+
 
 private:
     typedef QList<PropertyAdaptor*>       AdaptorList;
     typedef QMap<DeviceType, AdaptorList> DeviceMap;
 
+    /**
+     * Reads a property from the first adaptor which supports it, bypassing the cache.
+     */
+    const QString readProperty(const DeviceType& type, const Property& property) const;
+
+    /**
+     * Reads the state of a property from the first adaptor which supports it.
+     * This is what the fingerprint is made of.
+     */
+    const QString readPropertyState(const DeviceType& type, const Property& property) const;
+
+    /**
+     * Caches the value of a property which was set. The value is also remembered
+     * if it is part of the fingerprint or of the mapping of a device. Values the
+     * driver changes as a side effect are forgotten.
+     */
+    void rememberValue(const DeviceType& type, const Property& property, const QString& value);
+
+    /**
+     * Forgets the cached and the applied value of a property which could not
+     * be set, so it is read from the device and set again next time.
+     */
+    void forgetValue(const DeviceType& type, const Property& property);
+
+    /**
+     * Sets the screen space of a device again if it is letterboxed to the
+     * aspect ratio of the tablet area, which changes with the area and the
+     * rotation.
+     */
+    void updateLetterbox(const DeviceType& type);
+
     Q_DECLARE_PRIVATE(TabletBackend);
     TabletBackendPrivate *const d_ptr; //!< D-Pointer which gives access to private members.
 
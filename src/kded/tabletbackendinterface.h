@@ -61,6 +61,8 @@ public:
     /**
      * Gets a tablet property. If the property is not supported by any of the
      * adaptors which were added to this tablet, an empty string is returned.
+     * Values which were written or read before are returned from a cache
+     * until invalidateProperties() is called.
      *
      * @param type     The device to read the property from.
      * @param property The property to get.
@@ -109,6 +111,67 @@ public:
      */
     virtual bool setProperty(const DeviceType& type, const Property& property, const QString& value) = 0;
 
+    /**
+     * Maps a device to a screen space in one step. The tracking mode, the
+     * tablet area and the screen space are set together in the order the
+     * drivers expect them. Values which are still set on the device are
+     * skipped. The screen space is set again if the screen layout or the
+     * tablet area changed, as its transformation matrix depends on both.
+     *
+     * @param type        The device to remap.
+     * @param mode        The tracking mode.
+     * @param area        The tablet area.
+     * @param screenSpace The screen space to map the device to.
+     *
+     * @return True if all changed properties were set, false on error.
+     */
+    virtual bool remapDevice(const DeviceType& type, const QString& mode, const QString& area, const QString& screenSpace) = 0;
+
+    /**
+     * Drops the cached property values of a device, so they are read from the
+     * device again, and forgets which values were applied, so remapDevice()
+     * sets them again. Has to be called whenever someone else may have
+     * changed properties of the device.
+     *
+     * @param type The device to drop the values of or DeviceType::Unknown for all devices.
+     */
+    virtual void invalidateProperties(const DeviceType& type) = 0;
+
+    /**
+     * Drops the cached values of the given properties of a device, so they
+     * are read from the device again and set again by remapDevice().
+     *
+     * @param type       The device to drop the values of.
+     * @param properties The properties someone else changed.
+     */
+    virtual void invalidateProperties(const DeviceType& type, const QList<Property>& properties) = 0;
+
+    /**
+     * Enables the verification of the property cache. Cached values are then
+     * read from the device anyway and a warning is logged if they differ.
+     *
+     * @param verify True to verify cached values, false to trust them.
+     */
+    virtual void setPropertyCacheVerified(bool verify) = 0;
+
+    /**
+     * Reads back a small set of properties which get lost when the X server
+     * resets its devices, i.e. the tablet area, rotation, transformation matrix
+     * and pressure curve. Has to be called before the system is suspended or
+     * the session becomes inactive.
+     */
+    virtual void captureFingerprint() = 0;
+
+    /**
+     * Reads the properties of the last fingerprint again and sets all
+     * properties which changed to the values which were set last. They are
+     * restored in the same order a profile is set.
+     *
+     * @return The number of restored properties or -1 if no fingerprint was
+     *         captured or a property could not be restored.
+     */
+    virtual int restoreFingerprint() = 0;
+
 }; // CLASS
 }  // NAMESPACE
 #endif // HEADER PROTECTION
@@ -0,0 +1,351 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tabletcache.h"
+
+#include "logging.h"
+#include "deviceprofile.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace Wacom
+{
+    class TabletCachePrivate
+    {
+        public:
+            static const quint32 MAGIC   = 0x57435443; // "WCTC"
+            static const quint32 VERSION = 1;
+
+            typedef QMap<QString, QString>      ValueMap;
+            typedef QMap<QString, ValueMap>     ProfileMap;
+
+            struct Entry
+            {
+                ValueMap   information; //!< Tablet information values by key.
+                ValueMap   buttonMap;   //!< Button map of the tablet.
+                QString    profileName; //!< Name of the last profile.
+                ProfileMap profile;     //!< Property values of the last profile by device type.
+            };
+
+            static ValueMap   informationToMap(const TabletInformation& info);
+            static ProfileMap profileToMap(const TabletProfile& profile);
+
+            QString               fileName;
+            bool                  isOpen = false;
+            QHash<QString, Entry> entries;  //!< Cache entries by unique device id.
+    }; // CLASS
+
+    QDataStream& operator<< (QDataStream& stream, const TabletCachePrivate::Entry& entry)
+    {
+        return stream << entry.information << entry.buttonMap << entry.profileName << entry.profile;
+    }
+
+    QDataStream& operator>> (QDataStream& stream, TabletCachePrivate::Entry& entry)
+    {
+        return stream >> entry.information >> entry.buttonMap >> entry.profileName >> entry.profile;
+    }
+} // NAMESPACE
+
+using namespace Wacom;
+
+TabletCachePrivate::ValueMap TabletCachePrivate::informationToMap(const TabletInformation& info)
+{
+    ValueMap values;
+
+    foreach (const TabletInfo& tabletInfo, TabletInfo::list()) {
+        const QString& value = info.get(tabletInfo);
+
+        if (!value.isEmpty()) {
+            values.insert(tabletInfo.key(), value);
+        }
+    }
+
+    return values;
+}
+
+
+TabletCachePrivate::ProfileMap TabletCachePrivate::profileToMap(const TabletProfile& profile)
+{
+    ProfileMap devices;
+
+    foreach (const DeviceType& deviceType, DeviceType::list()) {
+        if (!profile.hasDevice(deviceType)) {
+            continue;
+        }
+
+        const DeviceProfile deviceProfile = profile.getDevice(deviceType);
+        ValueMap&           values        = devices[deviceType.key()];
+
+        foreach (const Property& property, deviceProfile.getProperties()) {
+            const QString value = deviceProfile.getProperty(property);
+
+            if (!value.isEmpty()) {
+                values.insert(property.key(), value);
+            }
+        }
+    }
+
+    return devices;
+}
+
+
+TabletCache::TabletCache()
+    : d_ptr(new TabletCachePrivate)
+{
+}
+
+
+TabletCache::~TabletCache()
+{
+    delete d_ptr;
+}
+
+
+TabletCache& TabletCache::instance()
+{
+    static TabletCache instance;
+    return instance;
+}
+
+
+QString TabletCache::defaultFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/wacomtablet/tablets.cache");
+}
+
+
+
+void TabletCache::open(const QString& fileName)
+{
+    Q_D(TabletCache);
+
+    close();
+
+    d->fileName = fileName;
+    d->isOpen   = true;
+
+    if (!load()) {
+        d->entries.clear();
+    }
+}
+
+
+
+void TabletCache::close()
+{
+    Q_D(TabletCache);
+
+    d->fileName.clear();
+    d->isOpen = false;
+    d->entries.clear();
+}
+
+
+
+bool TabletCache::isOpen() const
+{
+    Q_D(const TabletCache);
+
+    return d->isOpen;
+}
+
+
+
+bool TabletCache::lookupTablet(const QString& uniqueDeviceId, TabletInformation& info) const
+{
+    Q_D(const TabletCache);
+
+    auto entry = d->entries.constFind(uniqueDeviceId);
+
+    if (entry == d->entries.constEnd() || entry->information.isEmpty()) {
+        return false;
+    }
+
+    TabletInformation cachedInfo;
+
+    for (auto value = entry->information.constBegin() ; value != entry->information.constEnd() ; ++value) {
+        const TabletInfo* tabletInfo = TabletInfo::find(value.key());
+
+        if (tabletInfo) {
+            cachedInfo.set(*tabletInfo, value.value());
+        }
+    }
+
+    cachedInfo.setButtonMap(entry->buttonMap);
+
+    // the key might belong to another tablet if the file was tampered with
+    if (cachedInfo.getUniqueDeviceId() != uniqueDeviceId) {
+        return false;
+    }
+
+    info = cachedInfo;
+    return true;
+}
+
+
+
+bool TabletCache::storeTablet(const TabletInformation& info)
+{
+    Q_D(TabletCache);
+
+    if (!d->isOpen) {
+        return true;
+    }
+
+    TabletCachePrivate::Entry&   entry       = d->entries[info.getUniqueDeviceId()];
+    TabletCachePrivate::ValueMap information = TabletCachePrivate::informationToMap(info);
+
+    if (entry.information == information && entry.buttonMap == info.getButtonMap()) {
+        return false;
+    }
+
+    entry.information = information;
+    entry.buttonMap   = info.getButtonMap();
+
+    save();
+    return true;
+}
+
+
+
+bool TabletCache::lookupProfile(const QString& uniqueDeviceId, const QString& profileName, TabletProfile& profile) const
+{
+    Q_D(const TabletCache);
+
+    auto entry = d->entries.constFind(uniqueDeviceId);
+
+    if (entry == d->entries.constEnd() || entry->profile.isEmpty() || entry->profileName != profileName) {
+        return false;
+    }
+
+    TabletProfile cachedProfile(profileName);
+
+    for (auto device = entry->profile.constBegin() ; device != entry->profile.constEnd() ; ++device) {
+        const DeviceType* deviceType = DeviceType::find(device.key());
+
+        if (!deviceType) {
+            return false;
+        }
+
+        DeviceProfile deviceProfile(*deviceType);
+
+        for (auto value = device->constBegin() ; value != device->constEnd() ; ++value) {
+            const Property* property = Property::find(value.key());
+
+            if (property) {
+                deviceProfile.setProperty(*property, value.value());
+            }
+        }
+
+        cachedProfile.setDevice(deviceProfile);
+    }
+
+    profile = cachedProfile;
+    return true;
+}
+
+
+
+bool TabletCache::storeProfile(const QString& uniqueDeviceId, const TabletProfile& profile)
+{
+    Q_D(TabletCache);
+
+    if (!d->isOpen) {
+        return true;
+    }
+
+    TabletCachePrivate::Entry&     entry   = d->entries[uniqueDeviceId];
+    TabletCachePrivate::ProfileMap devices = TabletCachePrivate::profileToMap(profile);
+
+    if (entry.profileName == profile.getName() && entry.profile == devices) {
+        return false;
+    }
+
+    entry.profileName = profile.getName();
+    entry.profile     = devices;
+
+    save();
+    return true;
+}
+
+
+
+bool TabletCache::load()
+{
+    Q_D(TabletCache);
+
+    QFile file(d->fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic   = 0;
+    quint32 version = 0;
+
+    stream >> magic >> version;
+
+    if (magic != TabletCachePrivate::MAGIC || version != TabletCachePrivate::VERSION) {
+        qCDebug(KDED) << QString::fromLatin1("Ignoring outdated tablet cache '%1'.").arg(d->fileName);
+        return false;
+    }
+
+    stream >> d->entries;
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(KDED) << QString::fromLatin1("Ignoring broken tablet cache '%1'.").arg(d->fileName);
+        return false;
+    }
+
+    return true;
+}
+
+
+
+bool TabletCache::save() const
+{
+    Q_D(const TabletCache);
+
+    QDir().mkpath(QFileInfo(d->fileName).absolutePath());
+
+    // never leave a half written cache behind
+    QSaveFile file(d->fileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KDED) << QString::fromLatin1("Could not write tablet cache '%1'!").arg(d->fileName);
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    stream << TabletCachePrivate::MAGIC << TabletCachePrivate::VERSION << d->entries;
+
+    return file.commit();
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TABLETCACHE_H
+#define TABLETCACHE_H
+
+#include "tabletinformation.h"
+#include "tabletprofile.h"
+
+#include <QString>
+
+namespace Wacom
+{
+
+class TabletCachePrivate;
+
+/**
+ * A small binary cache of the tablets which were connected in previous sessions.
+ *
+ * Discovering a tablet requires a database and libwacom lookup and applying its
+ * last profile requires parsing the profile configuration. The cache keeps the
+ * result of both per tablet, so the daemon can configure a known tablet as soon
+ * as its X11 devices were found and verify the cached data afterwards.
+ *
+ * Tablets are identified by their unique device id, which consists of the USB
+ * vendor id and the tablet serial. The cache is disabled until it was opened,
+ * so unit tests never touch the cache of the user.
+ */
+class TabletCache
+{
+public:
+    ~TabletCache();
+
+    /**
+     * @return The only instance of this class.
+     */
+    static TabletCache& instance();
+
+    /**
+     * @return The default location of the cache file.
+     */
+    static QString defaultFileName();
+
+    /**
+     * Opens a cache file and reads its content. A missing, outdated or broken
+     * cache file is not an error, the cache is just empty in this case.
+     *
+     * @param fileName The cache file to use.
+     */
+    void open(const QString& fileName = defaultFileName());
+
+    /**
+     * Closes the cache and forgets all entries. The cache file is not touched.
+     */
+    void close();
+
+    /**
+     * @return True if the cache was opened, else false.
+     */
+    bool isOpen() const;
+
+    /**
+     * Looks up the cached database information of a tablet.
+     *
+     * @param uniqueDeviceId The unique device id of the tablet.
+     * @param info           Set to the cached information on success. It does not contain any devices.
+     *
+     * @return True if the tablet was found, else false.
+     */
+    bool lookupTablet(const QString& uniqueDeviceId, TabletInformation& info) const;
+
+    /**
+     * Stores the database information and button map of a tablet. Devices
+     * are not stored as their ids change between sessions.
+     *
+     * @param info The tablet information to store.
+     *
+     * @return True if the cache changed or is closed, false if it already contained this information.
+     */
+    bool storeTablet(const TabletInformation& info);
+
+    /**
+     * Looks up the cached last profile of a tablet.
+     *
+     * @param uniqueDeviceId The unique device id of the tablet.
+     * @param profileName    The name of the profile which is requested.
+     * @param profile        Set to the cached profile on success.
+     *
+     * @return True if the profile was cached as last profile of the tablet, else false.
+     */
+    bool lookupProfile(const QString& uniqueDeviceId, const QString& profileName, TabletProfile& profile) const;
+
+    /**
+     * Stores the profile which was applied to a tablet. Only the last
+     * profile of a tablet is kept.
+     *
+     * @param uniqueDeviceId The unique device id of the tablet.
+     * @param profile        The profile to store.
+     *
+     * @return True if the cache changed or is closed, false if it already contained this profile.
+     */
+    bool storeProfile(const QString& uniqueDeviceId, const TabletProfile& profile);
+
+
+private:
+    TabletCache();
+
+    TabletCache(const TabletCache& cache) = delete;
+    TabletCache& operator= (const TabletCache& cache) = delete;
+
+    /**
+     * Reads the cache file.
+     *
+     * @return True on success, false if the file is missing or invalid.
+     */
+    bool load();
+
+    /**
+     * Writes the cache file.
+     *
+     * @return True on success, else false.
+     */
+    bool save() const;
+
+    Q_DECLARE_PRIVATE(TabletCache)
+    TabletCachePrivate *const d_ptr; /**< d-pointer for this class */
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
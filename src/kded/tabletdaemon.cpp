@@ -21,8 +21,11 @@
 
 #include "logging.h"
 #include "dbustabletservice.h"
+#include "sessionwatcher.h"
+#include "tabletcache.h"
 #include "tabletfinder.h"
 #include "tablethandler.h"
+#include "udevtabletwatcher.h"
 #include "wacomadaptor.h"
 #include "x11eventnotifier.h"
 #include "globalactions.h"
@@ -30,6 +33,7 @@
 
 // common includes
 #include "aboutdata.h"
+#include "screentopology.h"
 
 // stdlib includes
 #include <memory>
@@ -62,6 +66,8 @@ public:
 
     TabletHandler                     tabletHandler;    /**< tablet handler */
     DBusTabletService                 dbusTabletService;
+    UdevTabletWatcher                 udevTabletWatcher; /**< announces tablets before X11 sets them up */
+    SessionWatcher                    sessionWatcher;    /**< reports suspend and VT switches */
     std::shared_ptr<GlobalActions>  actionCollection; /**< Collection of all global actions */
 
 }; // CLASS
@@ -77,6 +83,10 @@ TabletDaemon::TabletDaemon( QObject *parent, const QVariantList &args )
 
     setupApplication();
     setupDBus();
+
+    // known tablets are set up from the cache before the databases are read
+    TabletCache::instance().open();
+
     setupEventNotifier();
     setupActions();
 
@@ -184,6 +194,8 @@ void TabletDaemon::setupDBus()
     // connect tablet handler events to D-Bus
     // this is done here and not in the D-Bus tablet service to facilitate unit testing
     connect(&(d->tabletHandler), &TabletHandler::profileChanged, &(d->dbusTabletService), &DBusTabletService::onProfileChanged);
+    connect(&(d->tabletHandler), &TabletHandler::propertyChanged, &(d->dbusTabletService), &DBusTabletService::onPropertyChanged);
+    connect(&(d->tabletHandler), &TabletHandler::devicePropertiesChanged, &(d->dbusTabletService), &DBusTabletService::onDevicePropertiesChanged);
     connect(&(d->tabletHandler), &TabletHandler::tabletAdded,    &(d->dbusTabletService), &DBusTabletService::onTabletAdded);
     connect(&(d->tabletHandler), &TabletHandler::tabletRemoved,  &(d->dbusTabletService), &DBusTabletService::onTabletRemoved);
 }
@@ -205,17 +217,32 @@ void TabletDaemon::setupEventNotifier()
     // Set up tablet connected/disconnected signals
     connect( &X11EventNotifier::instance(), &X11EventNotifier::tabletAdded,   &TabletFinder::instance(), &TabletFinder::onX11TabletAdded);
     connect( &X11EventNotifier::instance(), &X11EventNotifier::tabletRemoved, &TabletFinder::instance(), &TabletFinder::onX11TabletRemoved);
+    connect( &X11EventNotifier::instance(), &X11EventNotifier::devicePropertiesChanged, &(d->tabletHandler), &TabletHandler::onDevicePropertiesChanged);
 
     connect( &TabletFinder::instance(),     &TabletFinder::tabletAdded,       &(d->tabletHandler),       &TabletHandler::onTabletAdded);
     connect( &TabletFinder::instance(),     &TabletFinder::tabletRemoved,     &(d->tabletHandler),       &TabletHandler::onTabletRemoved);
+    connect( &TabletFinder::instance(),     &TabletFinder::tabletPrepared,    &(d->tabletHandler),       &TabletHandler::onTabletPrepared);
+    connect( &TabletFinder::instance(),     &TabletFinder::preparedTabletRemoved, &(d->tabletHandler),   &TabletHandler::onPreparedTabletRemoved);
+
+    connect( &(d->udevTabletWatcher),       &UdevTabletWatcher::tabletAdded,   &TabletFinder::instance(), &TabletFinder::onUdevTabletAdded);
+    connect( &(d->udevTabletWatcher),       &UdevTabletWatcher::tabletRemoved, &TabletFinder::instance(), &TabletFinder::onUdevTabletRemoved);
+
+    // Set up suspend and session switch handling
+    connect( &(d->sessionWatcher),          &SessionWatcher::sessionPaused,    &(d->tabletHandler),       &TabletHandler::onSessionPaused);
+    connect( &(d->sessionWatcher),          &SessionWatcher::sessionResumed,   &(d->tabletHandler),       &TabletHandler::onSessionResumed);
 
     if (QX11Info::isPlatformX11()) {
+        d->udevTabletWatcher.start();
+        d->sessionWatcher.start();
         X11EventNotifier::instance().start();
     }
 }
 
 void TabletDaemon::monitorAllScreensGeometry()
 {
+    // the screen topology has to be updated before our handlers are called
+    ScreenTopology::watchScreens();
+
     // Add existing screens
     for (const auto &screen : QGuiApplication::screens())
     {
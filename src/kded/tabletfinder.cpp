@@ -20,13 +20,16 @@
 #include "tabletfinder.h"
 
 #include "logging.h"
+#include "tabletcache.h"
 #include "tabletdatabase.h"
 #include "x11tabletfinder.h"
 #include "libwacomwrapper.h"
 
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QString>
+#include <QTimer>
 
 #include "private/qtx11extras_p.h"
 
@@ -41,6 +44,9 @@ namespace Wacom
 
             TabletInformationList tabletList;
 
+            QHash<QString, TabletInformation> preparedTablets; //!< Looked up information of tablets announced by udev by unique device id.
+            QHash<QString, TabletInformation> unverifiedTablets; //!< Tablets set up from the cache by unique device id, as found by X11.
+
     }; // CLASS
 } // NAMESPACE
 
@@ -83,8 +89,10 @@ bool TabletFinder::scan()
         TabletFinderPrivate::TabletInformationList::Iterator iter;
 
         for (iter = d->tabletList.begin() ; iter != d->tabletList.end() ; ++iter) {
-            // lookup device information and button map
-            lookupInformation(*iter);
+            // lookup device information and button map unless udev or the cache were faster
+            if (!bindPreparedInformation(*iter)) {
+                lookupInformation(*iter);
+            }
 
             // empty device name will crash the system, ignore them for now
             if (iter->get(TabletInfo::TabletName).isEmpty()) {
@@ -131,7 +139,10 @@ void TabletFinder::onX11TabletAdded(int deviceId)
         if (info.hasDevice(deviceId)) {
             // tablet found - lookup additional information
             TabletInformation tabletInfo = info;
-            lookupInformation(tabletInfo);
+
+            if (!bindPreparedInformation(tabletInfo)) {
+                lookupInformation(tabletInfo);
+            }
 
             // empty device name will crash the system, ignore them for now
             if (tabletInfo.get(TabletInfo::TabletName).isEmpty()) {
@@ -170,11 +181,165 @@ void TabletFinder::onX11TabletRemoved(int deviceId)
 
 
 
+void TabletFinder::onUdevTabletAdded(int vendorId, int productId)
+{
+    Q_D(TabletFinder);
+
+    TabletInformation tabletInfo(productId);
+    tabletInfo.set(TabletInfo::CompanyId, QString::fromLatin1("%1").arg(vendorId, 4, 16, QLatin1Char('0')).toUpper());
+
+    if (d->preparedTablets.contains(tabletInfo.getUniqueDeviceId())) {
+        return;
+    }
+
+    // udev enumerates all tablets at login, so use the cache before the databases
+    TabletInformation cachedInfo;
+
+    if (TabletCache::instance().lookupTablet(tabletInfo.getUniqueDeviceId(), cachedInfo)) {
+        tabletInfo = cachedInfo;
+        queueVerification(tabletInfo);
+
+    } else if (!lookupInformation(tabletInfo)) {
+        return;
+    }
+
+    if (tabletInfo.get(TabletInfo::TabletName).isEmpty()) {
+        return;
+    }
+
+    qCDebug(KDED) << QString::fromLatin1("Tablet '%1' (%2) announced by udev.").arg(tabletInfo.get(TabletInfo::TabletName)).arg(tabletInfo.get(TabletInfo::TabletId));
+
+    d->preparedTablets.insert(tabletInfo.getUniqueDeviceId(), tabletInfo);
+    emit tabletPrepared(tabletInfo);
+}
+
+
+
+void TabletFinder::onUdevTabletRemoved(int vendorId, int productId)
+{
+    Q_D(TabletFinder);
+
+    // the X11 devices are removed by X11 hierarchy events
+    const TabletInformation tabletInfo = d->preparedTablets.take(QString::fromLatin1("%1:%2")
+                                                                  .arg(vendorId, 4, 16, QLatin1Char('0'))
+                                                                  .arg(productId, 4, 16, QLatin1Char('0'))
+                                                                  .toUpper());
+
+    if (!tabletInfo.get(TabletInfo::TabletId).isEmpty()) {
+        emit preparedTabletRemoved(tabletInfo);
+    }
+}
+
+
+
+bool TabletFinder::bindPreparedInformation(TabletInformation& info)
+{
+    Q_D(TabletFinder);
+
+    TabletInformation tabletInfo;
+    auto              prepared = d->preparedTablets.constFind(info.getUniqueDeviceId());
+
+    if (prepared != d->preparedTablets.constEnd()) {
+        tabletInfo = prepared.value();
+
+    } else if (TabletCache::instance().lookupTablet(info.getUniqueDeviceId(), tabletInfo)) {
+        queueVerification(info);
+
+    } else {
+        return false;
+    }
+
+    foreach (const DeviceType& type, DeviceType::list()) {
+        const DeviceInformation* device = info.getDevice(type);
+
+        if (device) {
+            tabletInfo.setDevice(*device);
+        }
+    }
+
+    info = tabletInfo;
+    return true;
+}
+
+
+
+void TabletFinder::queueVerification(const TabletInformation& info)
+{
+    Q_D(TabletFinder);
+
+    // the database might have changed since the cache was written
+    if (d->unverifiedTablets.isEmpty()) {
+        QTimer::singleShot(0, this, &TabletFinder::verifyCachedInformation);
+    }
+
+    d->unverifiedTablets.insert(info.getUniqueDeviceId(), info);
+}
+
+
+
+void TabletFinder::verifyCachedInformation()
+{
+    Q_D(TabletFinder);
+
+    const QList<TabletInformation> unverifiedTablets = d->unverifiedTablets.values();
+    d->unverifiedTablets.clear();
+
+    foreach (TabletInformation info, unverifiedTablets) {
+        // this also updates the cache
+        lookupInformation(info);
+
+        // tablets announced by udev bind their X11 devices to this information
+        if (d->preparedTablets.contains(info.getUniqueDeviceId())) {
+            d->preparedTablets.insert(info.getUniqueDeviceId(), info);
+        }
+
+        TabletFinderPrivate::TabletInformationList::iterator iter;
+
+        for (iter = d->tabletList.begin() ; iter != d->tabletList.end() ; ++iter) {
+            if (iter->getUniqueDeviceId() != info.getUniqueDeviceId()) {
+                continue;
+            }
+
+            // the information of a tablet announced by udev has no devices yet
+            TabletInformation currentInfo = info;
+
+            foreach (const DeviceType& type, DeviceType::list()) {
+                const DeviceInformation* device = iter->getDevice(type);
+
+                if (device) {
+                    currentInfo.setDevice(*device);
+                }
+            }
+
+            if (*iter == currentInfo && iter->getButtonMap() == currentInfo.getButtonMap()) {
+                break;
+            }
+
+            // set the tablet up again with the current information
+            TabletInformation outdatedInfo = *iter;
+            *iter = currentInfo;
+
+            qCDebug(KDED) << QString::fromLatin1("Cached information of tablet '%1' (%2) is outdated.").arg(outdatedInfo.get(TabletInfo::TabletName)).arg(outdatedInfo.get(TabletInfo::TabletId));
+
+            emit tabletRemoved(outdatedInfo);
+
+            if (!currentInfo.get(TabletInfo::TabletName).isEmpty()) {
+                emit tabletAdded(currentInfo);
+            }
+
+            break;
+        }
+    }
+}
+
+
+
 bool TabletFinder::lookupInformation(TabletInformation& info)
 {
     // lookup information from our local & system-wide tablet databases
     if (TabletDatabase::instance().lookupTablet(info.get (TabletInfo::TabletId), info)) {
         qCDebug(KDED) << "Found in database: " << info.get(TabletInfo::TabletId);
+        TabletCache::instance().storeTablet(info);
         return true;
     }
 
@@ -183,6 +348,7 @@ bool TabletFinder::lookupInformation(TabletInformation& info)
     auto vendorId = info.get(TabletInfo::CompanyId).toInt(nullptr, 16);
     if (libWacomWrapper::instance().lookupTabletInfo(tabletId, vendorId, info)) {
         qCDebug(KDED) << "Found in libwacom: " << info.get(TabletInfo::TabletId);
+        TabletCache::instance().storeTablet(info);
         return true;
     }
 
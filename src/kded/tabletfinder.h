@@ -33,6 +33,14 @@ class TabletFinderPrivate;
  * Uses the underlying window system and other sources to detect tablets.
  * This class needs the help of an event notifier which signals adding
  * and removal of tablet devices.
+ *
+ * If udev is available, tablets are announced by the kernel before the
+ * X server has set up their devices. The database lookup is done at that
+ * point and the X11 device ids are only bound to the prepared tablet
+ * information once the X11 devices show up.
+ *
+ * Tablets known from a previous session are set up with the information
+ * from the tablet cache, which is verified against the databases later.
  */
 class TabletFinder : public QObject
 {
@@ -61,6 +69,16 @@ public Q_SLOTS:
      */
     void onX11TabletRemoved (int deviceId);
 
+    /**
+     * This slot has to be connected to the udev tablet watcher.
+     */
+    void onUdevTabletAdded (int vendorId, int productId);
+
+    /**
+     * This slot has to be connected to the udev tablet watcher.
+     */
+    void onUdevTabletRemoved (int vendorId, int productId);
+
 
 Q_SIGNALS:
 
@@ -74,6 +92,17 @@ Q_SIGNALS:
      */
     void tabletRemoved (TabletInformation tabletInformation);
 
+    /**
+     * Emitted when a tablet was announced by udev and its information was
+     * looked up. The tablet has no X11 devices yet.
+     */
+    void tabletPrepared (TabletInformation tabletInformation);
+
+    /**
+     * Emitted when udev removed a tablet which was announced by tabletPrepared().
+     */
+    void preparedTabletRemoved (TabletInformation tabletInformation);
+
 
 protected:
     /**
@@ -90,6 +119,29 @@ protected:
      */
     bool lookupInformation (TabletInformation& info);
 
+    /**
+     * Binds the devices of a tablet found by the window system to the tablet
+     * information prepared when udev announced the tablet or, if udev did not
+     * announce it, to the information from the tablet cache.
+     *
+     * @param info The tablet information of the window system which will be replaced by the prepared information.
+     *
+     * @return True if prepared information was found, else false.
+     */
+    bool bindPreparedInformation (TabletInformation& info);
+
+    /**
+     * Queues a tablet whose information was taken from the tablet cache
+     * for verifyCachedInformation().
+     */
+    void queueVerification(const TabletInformation& info);
+
+    /**
+     * Looks up all tablets which were set up from the tablet cache in the
+     * databases and sets them up again if their information changed.
+     */
+    void verifyCachedInformation();
+
 
 private:
     /**
@@ -21,10 +21,13 @@
 
 #include "tabletbackendinterface.h"
 #include "tabletbackendfactory.h"
+#include "tabletcache.h"
 #include "tabletinfo.h"
 #include "devicetype.h"
+#include "xinputproperty.h"
 #include "screenmap.h"
 #include "screenspace.h"
+#include "screentopology.h"
 #include "stringutils.h"
 
 // common includes
@@ -35,11 +38,13 @@
 #include "profilemanager.h"
 #include "profilemanagement.h"
 #include "tabletprofile.h"
-#include "screensinfo.h"
 
-#include <QGuiApplication>
+#include <QElapsedTimer>
 #include <QList>
 #include <QRect>
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrentMap>
 
 #include <KLocalizedString>
 
@@ -52,9 +57,65 @@ namespace Wacom
             MainConfig                               mainConfig;            //!< Main config file which stores general parameters.
             QString                                  profileFile;           //!< Save which profile we should use
             QHash<QString, ProfileManager *>         profileManagerList;    //!< Profile manager which reads profile configuration from file.
+            QHash<QString, ProfileManager *>         preparedProfileManagers; //!< Profile managers of tablets which are about to be connected.
+            QSet<QString>                            preparedProfiles;      //!< Tablets whose profiles were read ahead and not loaded yet.
             QHash<QString, TabletBackendInterface *> tabletBackendList;     //!< Tablet backend of all currently connected tablets.
             QHash<QString, TabletInformation>        tabletInformationList; //!< Information of all currently connected tablets.
             QHash<QString, QString>                  currentProfileList;    //!< Currently active profile for each tablet.
+            QHash<QString, QString>                  cachedProfiles;        //!< Profiles applied from the tablet cache which still need to be verified.
+            QHash<QString, QHash<QString, QString> > mappedScreenSpaces;    //!< Screen space each device of a tablet was last announced with.
+
+            typedef QList<std::function<void(TabletBackendInterface*)> > BackendCallList;
+
+            bool                                     isReconfiguring = false; //!< Backend calls are queued while tablets are reconfigured.
+            mutable QHash<QString, BackendCallList>  backendCalls;          //!< Queued backend calls of each tablet.
+            QList<std::function<void()> >            pendingSignals;        //!< Signals which are emitted once the queued backend calls were applied.
+            mutable QHash<QString, QElapsedTimer>    lastWrites;            //!< Time since backend calls were last applied to each tablet.
+
+            static const qint64 ECHO_TIMEOUT = 500; //!< Milliseconds after a write in which device property changes are our own.
+
+            /**
+             * Maps the names of X11 device properties to the properties they store.
+             * Properties which are not configured by us are ignored.
+             */
+            static QList<Property> findProperties(const QStringList& deviceProperties)
+            {
+                static const QHash<QString, QList<Property> > driverProperties = {
+                    { QLatin1String("Wacom Tablet Area"),              { Property::Area } },
+                    { QLatin1String("Wacom Rotation"),                 { Property::Rotate } },
+                    { QLatin1String("Wacom Pressurecurve"),            { Property::PressureCurve } },
+                    { QLatin1String("Wacom Pressure Threshold"),       { Property::Threshold } },
+                    { QLatin1String("Wacom Sample and Suppress"),      { Property::RawSample, Property::Suppress } },
+                    { QLatin1String("Wacom Enable Touch"),             { Property::Touch } },
+                    { QLatin1String("Wacom Enable Touch Gesture"),     { Property::Gesture } },
+                    { QLatin1String("Wacom Touch Gesture Parameters"), { Property::ZoomDistance, Property::ScrollDistance, Property::TapTime } },
+                    { QLatin1String("Wacom Proximity Threshold"),      { Property::CursorProximity } },
+                    { QLatin1String("Wacom Hover Click"),              { Property::TabletPcButton } },
+                    { QLatin1String("Wacom Button Actions"),           { Property::Button1,  Property::Button2,  Property::Button3,  Property::Button4,
+                                                                         Property::Button5,  Property::Button6,  Property::Button7,  Property::Button8,
+                                                                         Property::Button9,  Property::Button10, Property::Button11, Property::Button12,
+                                                                         Property::Button13, Property::Button14, Property::Button15, Property::Button16,
+                                                                         Property::Button17, Property::Button18 } },
+                    { QLatin1String("Wacom Wheel Buttons"),            { Property::AbsWheelUp, Property::AbsWheelDown, Property::AbsWheel2Up,
+                                                                         Property::AbsWheel2Down, Property::RelWheelUp, Property::RelWheelDown } },
+                    { QLatin1String("Wacom Strip Buttons"),            { Property::StripLeftUp, Property::StripLeftDown,
+                                                                         Property::StripRightUp, Property::StripRightDown } }
+                };
+
+                QList<Property> properties;
+
+                foreach (const QString& deviceProperty, deviceProperties) {
+                    const XinputProperty* xinputProperty = XinputProperty::find(deviceProperty);
+
+                    if (xinputProperty) {
+                        properties.append(xinputProperty->id());
+                    } else {
+                        properties.append(driverProperties.value(deviceProperty));
+                    }
+                }
+
+                return properties;
+            }
     }; // CLASS
 } // NAMESPACE
 
@@ -84,6 +145,7 @@ TabletHandler::~TabletHandler()
 {
     qDeleteAll(d_ptr->tabletBackendList);
     qDeleteAll(d_ptr->profileManagerList);
+    qDeleteAll(d_ptr->preparedProfileManagers);
     delete d_ptr;
 }
 
@@ -98,6 +160,9 @@ QString TabletHandler::getProperty(const QString &tabletId, const DeviceType& de
         return QString();
     }
 
+    // make sure queued changes of this tablet are applied before reading them
+    flushBackendCalls(tabletId);
+
     return d->tabletBackendList.value(tabletId)->getProperty( deviceType, property );
 }
 
@@ -123,18 +188,29 @@ void TabletHandler::onTabletAdded( const TabletInformation& info )
              << (info.hasDevice(DeviceType::Cursor) ? "cursor" : "")
              << "]";
 
+    // reuse the profiles read ahead when udev announced the tablet
+    ProfileManager *profileManager = d->preparedProfileManagers.take(tabletId);
+
     // create tablet backend
     TabletBackendInterface *tbi = TabletBackendFactory::createBackend(info);
 
     if (!tbi) {
         qCWarning(KDED) << "Could not create tablet backend interface. Ignoring Tablet";
+        delete profileManager;
         return; // no valid backend found
     }
 
+    tbi->setPropertyCacheVerified(d->mainConfig.isPropertyCacheVerified());
     d->tabletBackendList.insert(tabletId, tbi);
 
     // update tablet information
-    d->profileManagerList.insert(tabletId, new ProfileManager(d->profileFile));
+    if (profileManager) {
+        d->preparedProfiles.insert(tabletId);
+    } else {
+        profileManager = new ProfileManager(d->profileFile);
+    }
+
+    d->profileManagerList.insert(tabletId, profileManager);
     d->tabletInformationList.insert(tabletId, info);
 
     // if we found something notify about it and set the default profile to it
@@ -153,7 +229,25 @@ void TabletHandler::onTabletAdded( const TabletInformation& info )
         }
     }
 
-    setProfile(tabletId, lastProfile);
+    TabletProfile cachedProfile;
+
+    if (TabletCache::instance().lookupProfile(info.getUniqueDeviceId(), lastProfile, cachedProfile)) {
+        // apply the profile from the last session right away and load
+        // the profile configuration once the daemon is idle
+        qCDebug(KDED) << QString::fromLatin1("Applying cached tablet profile '%1' to device '%2'.").arg(lastProfile).arg(tabletId);
+
+        applyProfile(tabletId, cachedProfile);
+        d->cachedProfiles.insert(tabletId, lastProfile);
+
+        QTimer::singleShot(0, this, [this, tabletId, lastProfile]() {
+            if (hasTablet(tabletId)) {
+                setProfile(tabletId, lastProfile);
+            }
+        });
+
+    } else {
+        setProfile(tabletId, lastProfile);
+    }
 
     // notify everyone else about the new tablet
     emit tabletAdded(info);
@@ -161,6 +255,105 @@ void TabletHandler::onTabletAdded( const TabletInformation& info )
 
 
 
+void TabletHandler::onTabletPrepared( const TabletInformation& info )
+{
+    Q_D( TabletHandler );
+
+    QString tabletId = info.get(TabletInfo::TabletId);
+
+    if (d->tabletBackendList.contains(tabletId)) {
+        return;
+    }
+
+    ProfileManager *profileManager = new ProfileManager(d->profileFile);
+    profileManager->readProfiles(info.getUniqueDeviceId(), info.getLegacyUniqueDeviceId());
+
+    delete d->preparedProfileManagers.value(tabletId);
+    d->preparedProfileManagers.insert(tabletId, profileManager);
+}
+
+
+
+void TabletHandler::onPreparedTabletRemoved( const TabletInformation& info )
+{
+    Q_D( TabletHandler );
+
+    delete d->preparedProfileManagers.take(info.get(TabletInfo::TabletId));
+}
+
+
+
+void TabletHandler::onSessionPaused()
+{
+    Q_D( TabletHandler );
+
+    foreach (const QString &tabletId, d->tabletBackendList.keys()) {
+        // make sure the fingerprint contains all queued changes
+        flushBackendCalls(tabletId);
+        d->tabletBackendList.value(tabletId)->captureFingerprint();
+    }
+}
+
+
+
+void TabletHandler::onSessionResumed()
+{
+    Q_D( TabletHandler );
+
+    foreach (const QString &tabletId, d->tabletBackendList.keys()) {
+        flushBackendCalls(tabletId);
+
+        int restored = d->tabletBackendList.value(tabletId)->restoreFingerprint();
+
+        if (restored < 0) {
+            // nothing to compare with or the restore failed, so apply everything again
+            qCDebug(KDED) << QString::fromLatin1("Could not restore the settings of tablet '%1', applying the profile again.").arg(tabletId);
+            setProfile(tabletId, d->currentProfileList.value(tabletId));
+
+        } else if (restored > 0) {
+            qCDebug(KDED) << QString::fromLatin1("Restored %1 lost settings of tablet '%2'.").arg(restored).arg(tabletId);
+        }
+    }
+}
+
+
+
+void TabletHandler::onDevicePropertiesChanged(const QString& deviceName, const QStringList& deviceProperties)
+{
+    Q_D( TabletHandler );
+
+    const QList<Property> properties = TabletHandlerPrivate::findProperties(deviceProperties);
+
+    if (properties.isEmpty()) {
+        return;
+    }
+
+    for (auto iter = d->tabletInformationList.constBegin() ; iter != d->tabletInformationList.constEnd() ; ++iter) {
+        foreach (const DeviceType& type, DeviceType::list()) {
+            if (!iter->hasDevice(type) || iter->getDeviceName(type) != deviceName) {
+                continue;
+            }
+
+            // reading the device back to tell our own changes apart would cost
+            // a process per property with xsetwacom, so go by the time instead
+            if (d->backendCalls.contains(iter.key()) || (d->lastWrites.contains(iter.key()) &&
+                                                         !d->lastWrites.value(iter.key()).hasExpired(TabletHandlerPrivate::ECHO_TIMEOUT))) {
+                qCDebug(KDED) << QString::fromLatin1("Ignoring property changes of device '%1' as we just configured it.").arg(deviceName);
+                continue;
+            }
+
+            TabletBackendInterface* backend = d->tabletBackendList.value(iter.key());
+
+            if (backend) {
+                backend->invalidateProperties(type, properties);
+                emit devicePropertiesChanged(iter.key(), type);
+            }
+        }
+    }
+}
+
+
+
 void TabletHandler::onTabletRemoved( const TabletInformation& info )
 {
     Q_D( TabletHandler );
@@ -175,6 +368,11 @@ void TabletHandler::onTabletRemoved( const TabletInformation& info )
                     false);
 
         QString tabletId = info.get(TabletInfo::TabletId);
+        d->backendCalls.remove(tabletId);
+        d->cachedProfiles.remove(tabletId);
+        d->lastWrites.remove(tabletId);
+        d->mappedScreenSpaces.remove(tabletId);
+        d->preparedProfiles.remove(tabletId);
         d->tabletBackendList.remove(tabletId);
         d->tabletInformationList.remove(tabletId);
         delete tbi;
@@ -194,7 +392,7 @@ void TabletHandler::onScreenRotated(QString output, const Qt::ScreenOrientation
     qCDebug(KDED) << "Screen" << output << "rotation has changed to" << newScreenRotation;
 
     //for each connected tablet, do the rotation
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d, output, newScreenRotation](const QString &tabletId) {
         QString curProfile = d->currentProfileList.value(tabletId);
         TabletProfile tabletProfile = d->profileManagerList.value(tabletId)->loadProfile(curProfile);
         ScreenRotation screenRotation = ScreenRotation::NONE;
@@ -221,7 +419,7 @@ void TabletHandler::onScreenRotated(QString output, const Qt::ScreenOrientation
 
         // when the rotation changes, the screen mapping has to be applied again
         mapTabletToCurrentScreenSpace(tabletId, tabletProfile);
-    }
+    });
 }
 
 void TabletHandler::onScreenAddedRemoved(QScreen *screen)
@@ -231,12 +429,12 @@ void TabletHandler::onScreenAddedRemoved(QScreen *screen)
     Q_UNUSED(screen)
     qCDebug(KDED) << "Number of screens has changed";
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         QString curProfile = d->currentProfileList.value(tabletId);
         TabletProfile tabletProfile = d->profileManagerList.value(tabletId)->loadProfile(curProfile);
 
         mapTabletToCurrentScreenSpace(tabletId, tabletProfile);
-    }
+    });
 }
 
 void TabletHandler::onScreenGeometryChanged()
@@ -245,12 +443,12 @@ void TabletHandler::onScreenGeometryChanged()
 
     qCDebug(KDED) << "Screen geometry has changed";
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         QString curProfile = d->currentProfileList.value(tabletId);
         TabletProfile tabletProfile = d->profileManagerList.value(tabletId)->loadProfile(curProfile);
 
         mapTabletToCurrentScreenSpace(tabletId, tabletProfile);
-    }
+    });
 }
 
 
@@ -258,9 +456,9 @@ void TabletHandler::onTogglePenMode()
 {
     Q_D( TabletHandler );
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         if( !hasTablet(tabletId) || !hasDevice(tabletId, DeviceType::Stylus)) {
-            continue;
+            return;
         }
 
         // read current mode and screen space from profile
@@ -287,7 +485,7 @@ void TabletHandler::onTogglePenMode()
         mapDeviceToOutput(tabletId, DeviceType::Eraser, screenSpace, trackingMode, tabletProfile);
 
         d->profileManagerList.value(tabletId)->saveProfile(tabletProfile);
-    }
+    });
 }
 
 
@@ -296,9 +494,9 @@ void TabletHandler::onToggleTouch()
 {
     Q_D( TabletHandler );
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         if( !hasDevice(tabletId, DeviceType::Touch) ) {
-            continue;
+            return;
         }
 
         QString touchMode = getProperty(tabletId, DeviceType::Touch, Property::Touch);
@@ -319,7 +517,7 @@ void TabletHandler::onToggleTouch()
 
         tabletProfile.setDevice(touchProfile);
         d->profileManagerList.value(tabletId)->saveProfile(tabletProfile);
-    }
+    });
 }
 
 
@@ -327,9 +525,9 @@ void TabletHandler::onToggleScreenMapping()
 {
     Q_D( TabletHandler );
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         if (!hasTablet(tabletId)) {
-            continue;
+            return;
         }
 
         QString curProfile = d->currentProfileList.value(tabletId);
@@ -338,40 +536,40 @@ void TabletHandler::onToggleScreenMapping()
         ScreenSpace   screenSpace    = ScreenSpace(stylusProfile.getProperty(Property::ScreenSpace));
 
         mapPenToScreenSpace(tabletId, screenSpace.next());
-    }
+    });
 }
 
 
 void TabletHandler::onMapToFullScreen()
 {
-    Q_D( TabletHandler );
-
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this](const QString &tabletId) {
         mapPenToScreenSpace(tabletId, ScreenSpace::desktop().toString());
-    }
+    });
 }
 
 
 
 void TabletHandler::onMapToScreen1()
 {
-    Q_D( TabletHandler );
+    const ScreenSpace screenSpace = ScreenSpace::monitor(ScreenTopology::current().primaryOutput());
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
-        mapPenToScreenSpace(tabletId, ScreenSpace::monitor(ScreensInfo::getPrimaryScreenName()));
-    }
+    reconfigureTablets([this, screenSpace](const QString &tabletId) {
+        mapPenToScreenSpace(tabletId, screenSpace);
+    });
 }
 
 
 
 void TabletHandler::onMapToScreen2()
 {
-    Q_D( TabletHandler );
+    const ScreenTopology topology = ScreenTopology::current();
 
-    if (QGuiApplication::screens().count() > 1) {
-        foreach(const QString &tabletId, d->tabletInformationList.keys()) {
-            mapPenToScreenSpace(tabletId, ScreenSpace::monitor(ScreensInfo::getPrimaryScreenName()).next());
-        }
+    if (topology.outputCount() > 1) {
+        const ScreenSpace screenSpace = ScreenSpace::monitor(topology.primaryOutput()).next();
+
+        reconfigureTablets([this, screenSpace](const QString &tabletId) {
+            mapPenToScreenSpace(tabletId, screenSpace);
+        });
     }
 }
 
@@ -379,7 +577,7 @@ void TabletHandler::onNextProfile()
 {
     Q_D( TabletHandler );
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         if(d->profileManagerList.value(tabletId)->profileRotationList().empty()) {
             qCDebug(KDED) << "No items in the rotation list. Nothing to rotate";
         }
@@ -387,14 +585,14 @@ void TabletHandler::onNextProfile()
             QString nextProfile = d->profileManagerList.value(tabletId)->nextProfile();
             setProfile(tabletId, nextProfile);
         }
-    }
+    });
 }
 
 void TabletHandler::onPreviousProfile()
 {
     Q_D( TabletHandler );
 
-    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+    reconfigureTablets([this, d](const QString &tabletId) {
         if(d->profileManagerList.value(tabletId)->profileRotationList().empty()) {
             qCDebug(KDED) << "No items in the rotation list. Nothing to rotate";
         }
@@ -402,7 +600,7 @@ void TabletHandler::onPreviousProfile()
             QString previousProfile = d->profileManagerList.value(tabletId)->previousProfile();
             setProfile(tabletId, previousProfile);
         }
-    }
+    });
 }
 
 QStringList TabletHandler::listProfiles( const QString &tabletId )
@@ -441,8 +639,13 @@ void TabletHandler::setProfile( const QString &tabletId, const QString &profile
     }
 
     TabletInformation tabletInformation = d->tabletInformationList.value(tabletId);
-    profileManager->readProfiles(tabletInformation.getUniqueDeviceId(),
-                                 tabletInformation.getLegacyUniqueDeviceId());
+
+    // the profiles of a tablet announced by udev were read ahead already,
+    // afterwards read them every time as they might have been changed
+    if (!d->preparedProfiles.remove(tabletId)) {
+        profileManager->readProfiles(tabletInformation.getUniqueDeviceId(),
+                                     tabletInformation.getLegacyUniqueDeviceId());
+    }
     TabletProfile tabletProfile = profileManager->loadProfile(profile);
 
     if (tabletProfile.listDevices().isEmpty()) {
@@ -485,26 +688,31 @@ void TabletHandler::setProfile( const QString &tabletId, const QString &profile
         d->currentProfileList.insert(tabletId, profile);
     }
 
-    // Handle auto-rotation.
-    // This has to be done before screen mapping!
-    autoRotateTablet(tabletId, tabletProfile);
+    QString currentProfile = d->currentProfileList.value(tabletId);
 
-    // Map tablet to screen.
-    // This is necessary to ensure the correct area map is used. Somone might have changed
-    // the ScreenSpace property without updating the Area property.
-    mapTabletToCurrentScreenSpace(tabletId, tabletProfile);
+    // skip applying the profile if the cached one was applied already when the tablet was added
+    bool isCachedProfileApplied = d->cachedProfiles.contains(tabletId) && d->cachedProfiles.take(tabletId) == currentProfile;
+    bool isCachedProfileOutdated = TabletCache::instance().storeProfile(tabletInformation.getUniqueDeviceId(), tabletProfile);
+
+    if (!isCachedProfileApplied || isCachedProfileOutdated) {
+        applyProfile(tabletId, tabletProfile);
+    }
 
-    // set profile on tablet
-    QString currentProfile = d->currentProfileList.value(tabletId);
-    d->tabletBackendList.value(tabletId)->setProfile(tabletProfile);
     d->mainConfig.setLastProfile(tabletInformation.getUniqueDeviceId(), currentProfile);
 
     // check profile rotation values and LEDs
     profileManager->updateCurrentProfileNumber(currentProfile);
-    d->tabletBackendList.value(tabletId)->setStatusLED( profileManager->profileNumber( currentProfile ));
-    d->tabletBackendList.value(tabletId)->setStatusLEDBrightness( 32 ); // TODO: Read the brightness from the settings. Add support to the kcmodule GUI for that.
+    const int profileNumber = profileManager->profileNumber( currentProfile );
 
-    emit profileChanged( tabletId, currentProfile );
+    callBackend(tabletId, [profileNumber](TabletBackendInterface* backend) {
+        backend->setStatusLED( profileNumber );
+        backend->setStatusLEDBrightness( 32 ); // TODO: Read the brightness from the settings. Add support to the kcmodule GUI for that.
+    });
+
+    // clients reading the profile's values have to see them applied
+    emitWhenApplied([this, tabletId, currentProfile]() {
+        emit profileChanged( tabletId, currentProfile );
+    });
 
     QString touchSensorId = tabletInformation.get(TabletInfo::TouchSensorId);
     // TODO: check if for some reason someone will make an infinitely nested tablets
@@ -525,7 +733,28 @@ void TabletHandler::setProperty(const QString &tabletId, const DeviceType& devic
         return;
     }
 
-    d->tabletBackendList.value(tabletId)->setProperty(deviceType, property, value);
+    callBackend(tabletId, [deviceType, property, value](TabletBackendInterface* backend) {
+        backend->setProperty(deviceType, property, value);
+    });
+
+    emitPropertyChanged(tabletId, deviceType, property, value);
+}
+
+
+void TabletHandler::setProperties(const QString &tabletId, const DeviceProfile& properties)
+{
+    Q_D( TabletHandler );
+
+    if (!hasDevice(tabletId, properties.getDeviceType())) {
+        qCWarning(KDED) << QString::fromLatin1("Unable to set properties on device '%1' as no device is currently available!").arg(properties.getName());
+        return;
+    }
+
+    callBackend(tabletId, [properties](TabletBackendInterface* backend) {
+        backend->setProfile(properties.getDeviceType(), properties);
+    });
+
+    emitPropertiesChanged(tabletId, properties);
 }
 
 QStringList TabletHandler::getProfileRotationList(const QString &tabletId)
@@ -540,6 +769,33 @@ QStringList TabletHandler::getProfileRotationList(const QString &tabletId)
     return d->profileManagerList.value(tabletId)->profileRotationList();
 }
 
+void TabletHandler::applyProfile(const QString &tabletId, const TabletProfile &profile)
+{
+    TabletProfile tabletProfile = profile;
+
+    // Handle auto-rotation.
+    // This has to be done before screen mapping!
+    autoRotateTablet(tabletId, tabletProfile);
+
+    // Map tablet to screen.
+    // This is necessary to ensure the correct area map is used. Somone might have changed
+    // the ScreenSpace property without updating the Area property.
+    mapTabletToCurrentScreenSpace(tabletId, tabletProfile);
+
+    // set profile on tablet
+    callBackend(tabletId, [tabletProfile](TabletBackendInterface* backend) {
+        backend->setProfile(tabletProfile);
+    });
+
+    foreach(const DeviceType& deviceType, DeviceType::list()) {
+        if (hasDevice(tabletId, deviceType) && tabletProfile.hasDevice(deviceType)) {
+            emitPropertiesChanged(tabletId, tabletProfile.getDevice(deviceType));
+        }
+    }
+}
+
+
+
 void TabletHandler::setProfileRotationList(const QString &tabletId, const QStringList &rotationList)
 {
     Q_D( TabletHandler );
@@ -552,6 +808,187 @@ void TabletHandler::setProfileRotationList(const QString &tabletId, const QStrin
     d->profileManagerList.value(tabletId)->setProfileRotationList(rotationList);
 }
 
+void TabletHandler::callBackend(const QString &tabletId, const std::function<void(TabletBackendInterface*)>& call)
+{
+    Q_D( TabletHandler );
+
+    if (d->isReconfiguring) {
+        d->backendCalls[tabletId].append(call);
+        return;
+    }
+
+    call(d->tabletBackendList.value(tabletId));
+    d->lastWrites[tabletId].start();
+}
+
+
+void TabletHandler::reconfigureTablets(const std::function<void(const QString &tabletId)>& reconfigure)
+{
+    Q_D( TabletHandler );
+
+    if (d->isReconfiguring) {
+        // nested call, the outermost call applies the backend calls
+        foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+            reconfigure(tabletId);
+        }
+        return;
+    }
+
+    d->isReconfiguring = true;
+
+    foreach(const QString &tabletId, d->tabletInformationList.keys()) {
+        reconfigure(tabletId);
+    }
+
+    d->isReconfiguring = false;
+
+    applyBackendCalls();
+
+    // announce the changes only after they were written
+    const QList<std::function<void()> > pendingSignals = d->pendingSignals;
+    d->pendingSignals.clear();
+
+    foreach(const auto &emitSignal, pendingSignals) {
+        emitSignal();
+    }
+}
+
+
+void TabletHandler::applyBackendCalls()
+{
+    Q_D( TabletHandler );
+
+    // tablets linked by TouchSensorId have to be configured one after another
+    QList<QStringList> chains;
+    QSet<QString>      scheduled;
+
+    foreach(const QString &tabletId, d->backendCalls.keys()) {
+        if (scheduled.contains(tabletId)) {
+            continue;
+        }
+
+        // start with the tablet which is not a touch sensor of another tablet
+        QString       rootId = tabletId;
+        QSet<QString> visited;
+
+        visited.insert(rootId);
+
+        for (QString parentId = getTouchSensorParent(rootId) ; !parentId.isEmpty() && !visited.contains(parentId) ; parentId = getTouchSensorParent(rootId)) {
+            rootId = parentId;
+            visited.insert(rootId);
+        }
+
+        QStringList chain;
+
+        foreach(const QString &chainId, getTouchSensorChain(rootId)) {
+            // never configure a tablet twice, even if the configuration is broken
+            if (!scheduled.contains(chainId)) {
+                scheduled.insert(chainId);
+                chain.append(chainId);
+            }
+        }
+
+        chains.append(chain);
+    }
+
+    const QHash<QString, TabletHandlerPrivate::BackendCallList> backendCalls = d->backendCalls;
+    const QHash<QString, TabletBackendInterface *>              backends     = d->tabletBackendList;
+
+    d->backendCalls.clear();
+
+    auto applyChain = [&backendCalls, &backends](const QStringList &chain) {
+        foreach(const QString &tabletId, chain) {
+            TabletBackendInterface *backend = backends.value(tabletId);
+
+            if (!backend) {
+                continue;
+            }
+
+            foreach(const auto &call, backendCalls.value(tabletId)) {
+                call(backend);
+            }
+        }
+    };
+
+    if (chains.size() == 1) {
+        // no need for another thread if only one tablet is affected
+        applyChain(chains.first());
+    } else {
+        // backend calls may map tablets to screens, so make sure the screen
+        // topology is built and watched here, the workers only read it
+        ScreenTopology::watchScreens();
+        QtConcurrent::blockingMap(chains, applyChain);
+    }
+
+    foreach(const QString &tabletId, backendCalls.keys()) {
+        d->lastWrites[tabletId].start();
+    }
+}
+
+
+void TabletHandler::flushBackendCalls(const QString &tabletId) const
+{
+    Q_D( const TabletHandler );
+
+    if (!d->backendCalls.contains(tabletId)) {
+        return;
+    }
+
+    // the tablet which references this touch sensor has to be configured first
+    QString parentId = getTouchSensorParent(tabletId);
+
+    if (!parentId.isEmpty() && parentId != tabletId) {
+        flushBackendCalls(parentId);
+    }
+
+    TabletBackendInterface *backend = d->tabletBackendList.value(tabletId);
+
+    foreach(const auto &call, d->backendCalls.take(tabletId)) {
+        if (backend) {
+            call(backend);
+        }
+    }
+
+    d->lastWrites[tabletId].start();
+}
+
+
+QStringList TabletHandler::getTouchSensorChain(const QString &tabletId) const
+{
+    Q_D( const TabletHandler );
+
+    QStringList chain;
+    QString     currentId = tabletId;
+
+    // stop on cycles, a touch sensor should never reference its tablet
+    while (!currentId.isEmpty() && !chain.contains(currentId)) {
+        chain.append(currentId);
+
+        if (!d->tabletInformationList.contains(currentId)) {
+            break;
+        }
+
+        currentId = d->tabletInformationList.value(currentId).get(TabletInfo::TouchSensorId);
+    }
+
+    return chain;
+}
+
+
+QString TabletHandler::getTouchSensorParent(const QString &touchSensorId) const
+{
+    Q_D( const TabletHandler );
+
+    for (auto iter = d->tabletInformationList.constBegin() ; iter != d->tabletInformationList.constEnd() ; ++iter) {
+        if (iter.key() != touchSensorId && iter.value().get(TabletInfo::TouchSensorId) == touchSensorId) {
+            return iter.key();
+        }
+    }
+
+    return QString();
+}
+
+
 void TabletHandler::autoRotateTablet(const QString &tabletId,
                                      const TabletProfile &tabletProfile,
                                      QString output,
@@ -573,15 +1010,17 @@ void TabletHandler::autoRotateTablet(const QString &tabletId,
         return;
     }
 
-    ScreenSpace stylusSpace = ScreenSpace(stylusProfile.getProperty(Property::ScreenSpace));
-    if (!stylusSpace.isMonitor() && QGuiApplication::screens().count() > 1) {
+    const ScreenTopology topology    = ScreenTopology::current();
+    ScreenSpace          stylusSpace = ScreenSpace(stylusProfile.getProperty(Property::ScreenSpace));
+
+    if (!stylusSpace.isMonitor() && topology.outputCount() > 1) {
         qCDebug(KDED) << "We're not mapped to a specific display, can't determine auto-rotation";
         return;
     }
 
     if (output.isEmpty()) {
-        screenRotation = ScreensInfo::getScreenRotation(stylusSpace.toString());
-    } else if (output != stylusSpace.toString() && QGuiApplication::screens().count() > 1) {
+        screenRotation = topology.outputRotation(stylusSpace.toString());
+    } else if (output != stylusSpace.toString() && topology.outputCount() > 1) {
         qCDebug(KDED) << "Tablet is mapped to a different screen";
         return;
     }
@@ -600,6 +1039,50 @@ void TabletHandler::autoRotateTablet(const QString &tabletId,
 }
 
 
+void TabletHandler::emitPropertiesChanged(const QString &tabletId, const DeviceProfile& properties)
+{
+    const DeviceType deviceType = properties.getDeviceType();
+
+    // the backend skips empty values, so do we
+    foreach (const Property& property, properties.getProperties()) {
+        const QString value = properties.getProperty(property);
+
+        if (!value.isEmpty()) {
+            emitPropertyChanged(tabletId, deviceType, property, value);
+        }
+    }
+}
+
+
+void TabletHandler::emitPropertyChanged(const QString &tabletId, const DeviceType& deviceType,
+                                        const Property& property, const QString& value)
+{
+    Q_D( TabletHandler );
+
+    if (property == Property::ScreenSpace) {
+        d->mappedScreenSpaces[tabletId].insert(deviceType.key(), value);
+    }
+
+    // the callers pass temporaries, so the signal has to keep copies
+    emitWhenApplied([this, tabletId, deviceType, property, value]() {
+        emit propertyChanged(tabletId, deviceType, property, value);
+    });
+}
+
+
+void TabletHandler::emitWhenApplied(const std::function<void()>& emitSignal)
+{
+    Q_D( TabletHandler );
+
+    if (d->isReconfiguring) {
+        d->pendingSignals.append(emitSignal);
+        return;
+    }
+
+    emitSignal();
+}
+
+
 bool TabletHandler::hasDevice(const QString &tabletId, const DeviceType& type) const
 {
     Q_D( const TabletHandler );
@@ -625,6 +1108,8 @@ void TabletHandler::mapDeviceToOutput(const QString &tabletId,
                                       const QString& trackingMode,
                                       TabletProfile& tabletProfile)
 {
+    Q_D( TabletHandler );
+
     if (!hasTablet(tabletId) || !hasDevice(tabletId, device)) {
         return; // we do not have a tablet or the requested device
     }
@@ -634,20 +1119,44 @@ void TabletHandler::mapDeviceToOutput(const QString &tabletId,
     // if the screen is missing or it's the only screen, use desktop instead
     // however do not override this in the saved profile, because it breaks user
     // settings if they disconnect external tablet
+    const ScreenTopology topology = ScreenTopology::current();
     const bool screen_is_valid =
         !screen.isMonitor() ||
-        (QGuiApplication::screens().count() > 1 &&
-         ScreensInfo::getScreenGeometries().contains(screen.toString()));
+        (topology.outputCount() > 1 && topology.hasOutput(screen.toString()));
 
     DeviceProfile deviceProfile = tabletProfile.getDevice(device);
     ScreenMap screenMap(deviceProfile.getProperty(Property::ScreenMap));
     QString tabletArea = screenMap.getMappingAsString(screen);
 
-    setProperty(tabletId, device, Property::Mode, trackingMode);
-    setProperty(tabletId, device, Property::ScreenSpace,
-                screen_is_valid ? screen.toString()
-                    : ScreenSpace::desktop().toString());
-    setProperty(tabletId, device, Property::Area, tabletArea);
+    const QString mappedScreenSpace = screen_is_valid ? screen.toString()
+                                                      : ScreenSpace::desktop().toString();
+
+    // the backend sets all of them at once and skips the unchanged ones
+    callBackend(tabletId, [device, trackingMode, tabletArea, mappedScreenSpace](TabletBackendInterface* backend) {
+        backend->remapDevice(device, trackingMode, tabletArea, mappedScreenSpace);
+    });
+
+    // the profile keeps the requested screen, so compare with what was last
+    // announced, otherwise an unavailable screen is announced on every remap
+    const QString lastScreenSpace = d->mappedScreenSpaces.value(tabletId).value(device.key(),
+                                                                                deviceProfile.getProperty(Property::ScreenSpace));
+
+    // only announce what actually changed, the backend skips empty values as well
+    const struct {
+        const Property& property;
+        const QString&  value;
+        const QString   lastValue;
+    } mappedProperties[] = {
+        { Property::Mode,        trackingMode,      deviceProfile.getProperty(Property::Mode) },
+        { Property::Area,        tabletArea,        deviceProfile.getProperty(Property::Area) },
+        { Property::ScreenSpace, mappedScreenSpace, lastScreenSpace },
+    };
+
+    for (const auto& entry : mappedProperties) {
+        if (!entry.value.isEmpty() && entry.value != entry.lastValue) {
+            emitPropertyChanged(tabletId, device, entry.property, entry.value);
+        }
+    }
 
     deviceProfile.setProperty(Property::Mode, trackingMode);
     deviceProfile.setProperty(Property::ScreenSpace, screen.toString());
@@ -674,7 +1183,12 @@ void TabletHandler::mapPenToScreenSpace(const QString &tabletId,
     mapDeviceToOutput(tabletId, DeviceType::Stylus, screenSpace, trackingMode, tabletProfile);
     mapDeviceToOutput(tabletId, DeviceType::Eraser, screenSpace, trackingMode, tabletProfile);
 
-    d->profileManagerList.value(tabletId)->saveProfile(tabletProfile);
+    // profiles applied from the tablet cache are saved once the profiles were read
+    ProfileManager *profileManager = d->profileManagerList.value(tabletId);
+
+    if (profileManager && profileManager->isLoaded()) {
+        profileManager->saveProfile(tabletProfile);
+    }
 }
 
 
@@ -695,7 +1209,12 @@ void TabletHandler::mapTabletToCurrentScreenSpace(const QString &tabletId,
     mapDeviceToOutput(tabletId, DeviceType::Eraser, stylusSpace, stylusMode, tabletProfile);
     mapDeviceToOutput(tabletId, DeviceType::Touch,  touchSpace,  touchMode,  tabletProfile);
 
-    d->profileManagerList.value(tabletId)->saveProfile(tabletProfile);
+    // profiles applied from the tablet cache are saved once the profiles were read
+    ProfileManager *profileManager = d->profileManagerList.value(tabletId);
+
+    if (profileManager && profileManager->isLoaded()) {
+        profileManager->saveProfile(tabletProfile);
+    }
 }
 
 
@@ -29,11 +29,14 @@
 #include <QString>
 #include <QStringList>
 
+#include <functional>
+
 class QScreen;
 
 namespace Wacom
 {
 class ScreenSpace;
+class TabletBackendInterface;
 class TabletProfile;
 class TabletHandlerPrivate;
 
@@ -102,6 +105,17 @@ public:
     void setProperty(const QString &tabletId, const DeviceType& deviceType, const Property & property, const QString& value) override;
 
 
+    /**
+      * Sets all properties of @p properties on one device as a single transaction.
+      * The properties are applied in the order required by the backend, the
+      * same way a device profile is applied. Empty values are skipped.
+      *
+      * @param tabletId   The identifier of the device to set the properties on.
+      * @param properties The properties to set, including the device type.
+      */
+    void setProperties(const QString &tabletId, const DeviceProfile& properties) override;
+
+
     QStringList getProfileRotationList(const QString &tabletId) override;
 
     void setProfileRotationList(const QString &tabletId, const QStringList &rotationList) override;
@@ -128,6 +142,58 @@ public Q_SLOTS:
       */
     void onTabletRemoved(const TabletInformation& info);
 
+    /**
+      * @brief Prepares the profiles of a tablet which is about to be connected.
+      *
+      * This slot has to be connected to the tablet finder and is executed
+      * when udev announces a tablet before its X devices are available.
+      * The profiles are read ahead so they can be applied right away
+      * when the tablet is added.
+      *
+      * @param info The device info as found in the tablet database.
+      */
+    void onTabletPrepared(const TabletInformation& info);
+
+    /**
+      * @brief Drops the profiles read ahead for a tablet which is gone.
+      *
+      * This slot has to be connected to the tablet finder and is executed
+      * when udev removes a tablet which was prepared by onTabletPrepared().
+      *
+      * @param info The device info as found in the tablet database.
+      */
+    void onPreparedTabletRemoved(const TabletInformation& info);
+
+    /**
+      * @brief Captures the settings of all tablets which might get lost.
+      *
+      * This slot has to be connected to the session watcher and is executed
+      * before the system is suspended or the session becomes inactive.
+      */
+    void onSessionPaused();
+
+    /**
+      * @brief Restores the settings of all tablets which got lost.
+      *
+      * This slot has to be connected to the session watcher and is executed
+      * after the system was resumed or the session became active again.
+      * Only the settings the X server lost are applied again.
+      */
+    void onSessionResumed();
+
+    /**
+      * @brief Drops the cached properties of a device which someone else changed.
+      *
+      * This slot has to be connected to the X event notifier and is executed
+      * whenever properties of a device were changed. Changes which arrive
+      * shortly after we wrote to the tablet are echoes of our own changes
+      * and are ignored.
+      *
+      * @param deviceName       The X11 name of the device which changed.
+      * @param deviceProperties The names of the X11 device properties which changed.
+      */
+    void onDevicePropertiesChanged(const QString& deviceName, const QStringList& deviceProperties);
+
     /**
      * @brief Handles rotating the tablet.
      *
@@ -228,6 +294,27 @@ Q_SIGNALS:
     void profileChanged(const QString &tabletId, const QString& profile);
 
 
+    /**
+      * Emitted when a property of a tablet device was set.
+      *
+      * @param tabletId The identifier of the tablet.
+      * @param deviceType The device the property was set on.
+      * @param property The property which was set.
+      * @param value The new value of the property.
+      */
+    void propertyChanged(const QString &tabletId, const Wacom::DeviceType& deviceType, const Wacom::Property& property, const QString& value);
+
+
+    /**
+      * Emitted when properties of a tablet device were changed outside of our
+      * control. The new values have to be read again.
+      *
+      * @param tabletId The identifier of the tablet.
+      * @param deviceType The device whose properties changed.
+      */
+    void devicePropertiesChanged(const QString &tabletId, const Wacom::DeviceType& deviceType);
+
+
     /**
       * Emitted when a new tablet is connected or if the currently active tablet changes.
       */
@@ -242,6 +329,65 @@ Q_SIGNALS:
 
 private:
 
+    /**
+     * Calls the backend of a tablet. While tablets are reconfigured by
+     * reconfigureTablets() the call is queued and applied together with
+     * the calls of all other tablets, otherwise it is executed immediately.
+     *
+     * @param tabletId The id of the Tablet whose backend should be called.
+     * @param call The backend call.
+     */
+    void callBackend(const QString &tabletId, const std::function<void(TabletBackendInterface*)>& call);
+
+    /**
+     * Runs the given reconfiguration for each connected tablet. The logic of
+     * the reconfiguration runs sequentially, but the backend calls it makes
+     * are applied concurrently for independent tablets once all tablets were
+     * handled. A touch sensor is always configured after the tablet which
+     * references it by TouchSensorId. Returns when all tablets are configured.
+     *
+     * @param reconfigure The reconfiguration to run for each tablet.
+     */
+    void reconfigureTablets(const std::function<void(const QString &tabletId)>& reconfigure);
+
+    /**
+     * Applies all queued backend calls. Tablets which do not depend on each
+     * other are configured in parallel.
+     */
+    void applyBackendCalls();
+
+    /**
+     * Applies the queued backend calls of the given tablet and the tablet
+     * it is a touch sensor of, so the backend of the tablet can be read.
+     *
+     * @param tabletId The id of the Tablet to flush.
+     */
+    void flushBackendCalls(const QString &tabletId) const;
+
+    /**
+     * Returns the tablets which have to be configured one after another
+     * because they are linked by TouchSensorId, starting with the given tablet.
+     *
+     * @param tabletId The id of the first Tablet of the chain.
+     */
+    QStringList getTouchSensorChain(const QString &tabletId) const;
+
+    /**
+     * Returns the tablet which uses the given tablet as touch sensor or an
+     * empty string if there is none.
+     *
+     * @param touchSensorId The id of the touch sensor Tablet.
+     */
+    QString getTouchSensorParent(const QString &touchSensorId) const;
+
+    /**
+     * Applies a profile to a tablet, including auto-rotation and screen mapping.
+     *
+     * @param tabletId The id of the tablet.
+     * @param profile  The profile to apply.
+     */
+    void applyProfile(const QString &tabletId, const TabletProfile &profile);
+
     /**
      * Auto rotates the tablet if auto-rotation is enabled. If auto-rotation
      * is disabled, the tablet's rotation settings will be left untouched.
@@ -255,6 +401,30 @@ private:
                           QString output = QString(),
                           ScreenRotation screenRotations = ScreenRotation::NONE);
 
+    /**
+     * Emits a propertyChanged signal for every non-empty property of the given
+     * device profile. Has to be called after the profile was passed to the backend.
+     *
+     * @param tabletId The id of the Tablet the properties were set on.
+     * @param properties The device profile which was set.
+     */
+    void emitPropertiesChanged(const QString &tabletId, const DeviceProfile& properties);
+
+    /**
+     * Emits propertyChanged. While tablets are reconfigured the signal is
+     * delayed until the queued backend calls were applied, so listeners never
+     * see a value before it was written.
+     */
+    void emitPropertyChanged(const QString &tabletId, const Wacom::DeviceType& deviceType,
+                             const Wacom::Property& property, const QString& value);
+
+    /**
+     * Emits a signal right away or, while tablets are reconfigured, once the
+     * queued backend calls were applied. The function must not reference
+     * temporaries of the caller.
+     */
+    void emitWhenApplied(const std::function<void()>& emitSignal);
+
     /**
      * Checks if the current tablet supports the given device type.
      *
@@ -22,6 +22,7 @@
 
 #include "property.h"
 #include "devicetype.h"
+#include "deviceprofile.h"
 
 #include <QObject>
 #include <QString>
@@ -49,6 +50,8 @@ public:
 
     virtual void setProperty(const QString& tabletId, const DeviceType& deviceType, const Property & property, const QString& value) = 0;
 
+    virtual void setProperties(const QString& tabletId, const DeviceProfile& properties) = 0;
+
     virtual QStringList getProfileRotationList(const QString& tabletId) = 0;
 
     virtual void setProfileRotationList(const QString& tabletId, const QStringList &rotationList) = 0;
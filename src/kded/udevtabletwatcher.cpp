@@ -0,0 +1,300 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "udevtabletwatcher.h"
+
+#include "logging.h"
+
+#include <QSocketNotifier>
+#include <QStringList>
+
+#ifdef HAVE_LIBUDEV
+#include <libudev.h>
+#endif
+
+namespace Wacom
+{
+    class UdevTabletWatcherPrivate
+    {
+        public:
+#ifdef HAVE_LIBUDEV
+            /**
+             * Reads all udev properties of a device.
+             */
+            static QHash<QString, QString> readProperties(udev_device* device);
+
+            udev*                  udev     = nullptr;
+            udev_monitor*          monitor  = nullptr;
+#endif
+            QSocketNotifier*       notifier = nullptr;
+
+            QHash<QString, quint32> devices;      //!< Tablet key of each known kernel device by sysfs path.
+            QHash<quint32, int>     deviceCount;  //!< Number of known kernel devices of each tablet key.
+    }; // CLASS
+} // NAMESPACE
+
+using namespace Wacom;
+
+#ifdef HAVE_LIBUDEV
+QHash<QString, QString> UdevTabletWatcherPrivate::readProperties(udev_device* device)
+{
+    QHash<QString, QString> properties;
+    udev_list_entry*        entry;
+
+    udev_list_entry_foreach(entry, udev_device_get_properties_list_entry(device)) {
+        properties.insert(QString::fromLatin1(udev_list_entry_get_name(entry)), QString::fromLatin1(udev_list_entry_get_value(entry)));
+    }
+
+    // make sure the properties we depend on are set
+    const char* subsystem = udev_device_get_subsystem(device);
+    const char* driver    = udev_device_get_driver(device);
+
+    if (subsystem) {
+        properties.insert(QLatin1String("SUBSYSTEM"), QString::fromLatin1(subsystem));
+    }
+
+    if (driver) {
+        properties.insert(QLatin1String("DRIVER"), QString::fromLatin1(driver));
+    }
+
+    return properties;
+}
+#endif
+
+
+UdevTabletWatcher::UdevTabletWatcher(QObject* parent)
+    : QObject(parent)
+    , d_ptr(new UdevTabletWatcherPrivate)
+{
+}
+
+
+UdevTabletWatcher::~UdevTabletWatcher()
+{
+    stop();
+    delete d_ptr;
+}
+
+
+
+bool UdevTabletWatcher::start()
+{
+#ifdef HAVE_LIBUDEV
+    Q_D(UdevTabletWatcher);
+
+    if (d->monitor) {
+        return true;
+    }
+
+    d->udev = udev_new();
+
+    if (!d->udev) {
+        qCWarning(KDED) << "Could not connect to udev, tablet hotplug detection falls back to X11 events.";
+        return false;
+    }
+
+    d->monitor = udev_monitor_new_from_netlink(d->udev, "udev");
+
+    if (!d->monitor) {
+        qCWarning(KDED) << "Could not create udev monitor, tablet hotplug detection falls back to X11 events.";
+        udev_unref(d->udev);
+        d->udev = nullptr;
+        return false;
+    }
+
+    udev_monitor_filter_add_match_subsystem_devtype(d->monitor, "input", nullptr);
+    udev_monitor_filter_add_match_subsystem_devtype(d->monitor, "hid", nullptr);
+    udev_monitor_enable_receiving(d->monitor);
+
+    d->notifier = new QSocketNotifier(udev_monitor_get_fd(d->monitor), QSocketNotifier::Read, this);
+    connect(d->notifier, &QSocketNotifier::activated, this, &UdevTabletWatcher::onMonitorReadable);
+
+    // register devices which are already present, the monitor is already
+    // receiving so we can not miss a device which is added meanwhile
+    udev_enumerate*  enumerate = udev_enumerate_new(d->udev);
+    udev_list_entry* entry;
+
+    udev_enumerate_add_match_subsystem(enumerate, "input");
+    udev_enumerate_add_match_subsystem(enumerate, "hid");
+    udev_enumerate_scan_devices(enumerate);
+
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(enumerate)) {
+        udev_device* device = udev_device_new_from_syspath(d->udev, udev_list_entry_get_name(entry));
+
+        if (device) {
+            handleUevent(QLatin1String("add"), QString::fromLatin1(udev_device_get_syspath(device)), UdevTabletWatcherPrivate::readProperties(device));
+            udev_device_unref(device);
+        }
+    }
+
+    udev_enumerate_unref(enumerate);
+
+    return true;
+#else
+    qCDebug(KDED) << "Built without libudev, tablet hotplug detection relies on X11 events.";
+    return false;
+#endif
+}
+
+
+
+void UdevTabletWatcher::stop()
+{
+    Q_D(UdevTabletWatcher);
+
+    delete d->notifier;
+    d->notifier = nullptr;
+
+#ifdef HAVE_LIBUDEV
+    if (d->monitor) {
+        udev_monitor_unref(d->monitor);
+        d->monitor = nullptr;
+    }
+
+    if (d->udev) {
+        udev_unref(d->udev);
+        d->udev = nullptr;
+    }
+#endif
+
+    d->devices.clear();
+    d->deviceCount.clear();
+}
+
+
+
+bool UdevTabletWatcher::handleUevent(const QString& action, const QString& sysPath, const QHash<QString, QString>& properties)
+{
+    Q_D(UdevTabletWatcher);
+
+    if (action == QLatin1String("remove") || action == QLatin1String("unbind")) {
+        auto device = d->devices.find(sysPath);
+
+        if (device == d->devices.end()) {
+            return false;
+        }
+
+        quint32 key = device.value();
+        d->devices.erase(device);
+
+        if (--d->deviceCount[key] > 0) {
+            return true;
+        }
+
+        d->deviceCount.remove(key);
+
+        qCDebug(KDED) << QString::fromLatin1("udev: last device of tablet %1:%2 removed.").arg(key >> 16, 4, 16, QLatin1Char('0')).arg(key & 0xFFFF, 4, 16, QLatin1Char('0'));
+        emit tabletRemoved(key >> 16, key & 0xFFFF);
+        return true;
+    }
+
+    int vendorId;
+    int productId;
+
+    if (!parseTabletIds(properties, vendorId, productId)) {
+        return false;
+    }
+
+    // "bind" and "change" events are sent for devices we already know
+    if (d->devices.contains(sysPath)) {
+        return true;
+    }
+
+    quint32 key = (static_cast<quint32>(vendorId) << 16) | static_cast<quint32>(productId);
+    d->devices.insert(sysPath, key);
+
+    if (++d->deviceCount[key] > 1) {
+        return true;
+    }
+
+    qCDebug(KDED) << QString::fromLatin1("udev: tablet %1:%2 added.").arg(vendorId, 4, 16, QLatin1Char('0')).arg(productId, 4, 16, QLatin1Char('0'));
+    emit tabletAdded(vendorId, productId);
+    return true;
+}
+
+
+
+void UdevTabletWatcher::onMonitorReadable()
+{
+#ifdef HAVE_LIBUDEV
+    Q_D(UdevTabletWatcher);
+
+    udev_device* device;
+
+    while (d->monitor && (device = udev_monitor_receive_device(d->monitor)) != nullptr) {
+        const char* action = udev_device_get_action(device);
+
+        if (action) {
+            handleUevent(QString::fromLatin1(action), QString::fromLatin1(udev_device_get_syspath(device)), UdevTabletWatcherPrivate::readProperties(device));
+        }
+
+        udev_device_unref(device);
+    }
+#endif
+}
+
+
+
+bool UdevTabletWatcher::parseTabletIds(const QHash<QString, QString>& properties, int& vendorId, int& productId)
+{
+    const QString subsystem = properties.value(QLatin1String("SUBSYSTEM"));
+    QStringList   ids;
+
+    if (subsystem == QLatin1String("input")) {
+        // only tablets are tagged by the input_id builtin of udev
+        if (properties.value(QLatin1String("ID_INPUT_TABLET")) != QLatin1String("1") &&
+            properties.value(QLatin1String("ID_INPUT_TABLET_PAD")) != QLatin1String("1")) {
+            return false;
+        }
+
+        // "bus/vendor/product/version" is set on the parent input device,
+        // event devices of USB tablets have separate vendor and model ids
+        ids = properties.value(QLatin1String("PRODUCT")).split(QLatin1Char('/'));
+
+        if (ids.size() < 3) {
+            ids = QStringList() << QString() << properties.value(QLatin1String("ID_VENDOR_ID")) << properties.value(QLatin1String("ID_MODEL_ID"));
+        }
+
+    } else if (subsystem == QLatin1String("hid")) {
+        // hid devices of all kinds show up here, only trust the wacom kernel driver
+        if (properties.value(QLatin1String("DRIVER")) != QLatin1String("wacom")) {
+            return false;
+        }
+
+        // "bus:vendor:product"
+        ids = properties.value(QLatin1String("HID_ID")).split(QLatin1Char(':'));
+
+    } else {
+        return false;
+    }
+
+    if (ids.size() < 3) {
+        return false;
+    }
+
+    bool vendorOk  = false;
+    bool productOk = false;
+
+    vendorId  = ids.at(1).toInt(&vendorOk, 16);
+    productId = ids.at(2).toInt(&productOk, 16);
+
+    return vendorOk && productOk && vendorId > 0 && vendorId <= 0xFFFF && productId >= 0 && productId <= 0xFFFF;
+}
+
+#include "moc_udevtabletwatcher.cpp"
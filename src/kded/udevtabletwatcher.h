@@ -0,0 +1,123 @@
+/*
+ * This file is part of the KDE wacomtablet project. For copyright
+ * information and license terms see the AUTHORS and COPYING files
+ * in the top-level directory of this distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UDEVTABLETWATCHER_H
+#define UDEVTABLETWATCHER_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+namespace Wacom
+{
+
+class UdevTabletWatcherPrivate;
+
+/**
+ * Watches udev for tablets being plugged in or removed.
+ *
+ * The kernel announces a new tablet long before the X server has set up
+ * its input devices. This watcher listens to the uevents of the "input" and
+ * "hid" subsystems and signals the vendor and product id of a tablet as soon
+ * as the first of its kernel devices shows up, so the tablet can be looked up
+ * in the device database while the X driver is still busy.
+ *
+ * A tablet consists of several kernel devices. The added signal is only
+ * emitted for the first device of a tablet, the removed signal only when
+ * the last one is gone.
+ */
+class UdevTabletWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UdevTabletWatcher(QObject* parent = nullptr);
+
+    ~UdevTabletWatcher() override;
+
+    /**
+     * Connects to the udev monitor and registers all tablet devices which
+     * are already present.
+     *
+     * @return True on success, false if udev is not available.
+     */
+    bool start();
+
+    /**
+     * Disconnects from the udev monitor and forgets all known devices.
+     */
+    void stop();
+
+    /**
+     * Processes a single uevent. This is called for every event received
+     * from the udev monitor and can be used to replay a fake udev
+     * environment in unit tests.
+     *
+     * @param action     The uevent action, i.e. "add" or "remove".
+     * @param sysPath    The sysfs path of the device.
+     * @param properties The udev properties of the device.
+     *
+     * @return True if the event belonged to a tablet, else false.
+     */
+    bool handleUevent(const QString& action, const QString& sysPath, const QHash<QString, QString>& properties);
+
+
+Q_SIGNALS:
+    /**
+     * Emitted when the first kernel device of a tablet was added.
+     *
+     * @param vendorId  The USB vendor id of the tablet.
+     * @param productId The USB product id of the tablet.
+     */
+    void tabletAdded(int vendorId, int productId);
+
+    /**
+     * Emitted when the last kernel device of a tablet was removed.
+     *
+     * @param vendorId  The USB vendor id of the tablet.
+     * @param productId The USB product id of the tablet.
+     */
+    void tabletRemoved(int vendorId, int productId);
+
+
+private Q_SLOTS:
+    /**
+     * Called when the udev monitor has events to read.
+     */
+    void onMonitorReadable();
+
+
+private:
+    /**
+     * Extracts vendor and product id from the udev properties of a tablet device.
+     *
+     * @param properties The udev properties of the device.
+     * @param vendorId   Set to the vendor id of the tablet.
+     * @param productId  Set to the product id of the tablet.
+     *
+     * @return True if the device belongs to a tablet, else false.
+     */
+    static bool parseTabletIds(const QHash<QString, QString>& properties, int& vendorId, int& productId);
+
+    Q_DECLARE_PRIVATE(UdevTabletWatcher)
+    UdevTabletWatcherPrivate *const d_ptr; /**< d-pointer for this class */
+
+}; // CLASS
+}  // NAMESPACE
+#endif // HEADER PROTECTION
@@ -18,6 +18,9 @@
  */
 
 #include <QCoreApplication>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
 
 #include "private/qtx11extras_p.h"
 
@@ -35,7 +38,17 @@ namespace Wacom
     {
         public:
             bool isStarted = false;
+
+            QHash<int, QString>                       deviceNames;       //!< Names of all devices which sent property events by id, empty for non-tablet devices.
+            QHash<int, QSet<X11InputDevice::Atom> >   pendingProperties; //!< Changed property atoms per device id which were not reported yet.
+            QTimer                                    propertiesTimer;   //!< Coalesces property events into one signal per device.
     };
+
+    /**
+     * Time in milliseconds property events are collected before they are reported.
+     * Setting a whole profile changes dozens of properties within a few milliseconds.
+     */
+    static const int PROPERTY_EVENTS_DELAY = 100;
 }
 
 using namespace Wacom;
@@ -45,7 +58,11 @@ X11EventNotifier::X11EventNotifier()
     , QAbstractNativeEventFilter()
     , d_ptr(new X11EventNotifierPrivate)
 {
+    Q_D (X11EventNotifier);
 
+    d->propertiesTimer.setSingleShot(true);
+    d->propertiesTimer.setInterval(PROPERTY_EVENTS_DELAY);
+    connect(&d->propertiesTimer, &QTimer::timeout, this, &X11EventNotifier::publishDeviceProperties);
 }
 
 X11EventNotifier::~X11EventNotifier()
@@ -86,6 +103,9 @@ void X11EventNotifier::stop()
     if( QCoreApplication::instance() != nullptr ) {
         QCoreApplication::instance()->removeNativeEventFilter(this);
         d->isStarted = false;
+
+        d->propertiesTimer.stop();
+        d->pendingProperties.clear();
     }
 }
 
@@ -99,6 +119,8 @@ bool X11EventNotifier::nativeEventFilter(const QByteArray &eventType, void *mess
 
     if (event->response_type == XCB_GE_GENERIC && cookie->event_type == XCB_INPUT_HIERARCHY) {
         handleX11InputEvent(cookie);
+    } else if (event->response_type == XCB_GE_GENERIC && cookie->event_type == XCB_INPUT_PROPERTY) {
+        handleX11PropertyEvent(cookie);
     }
 
     // return QWidget::x11Event(event);
@@ -109,6 +131,8 @@ bool X11EventNotifier::nativeEventFilter(const QByteArray &eventType, void *mess
 
 void X11EventNotifier::handleX11InputEvent(xcb_ge_generic_event_t* event)
 {
+    Q_D (X11EventNotifier);
+
     xcb_input_hierarchy_event_t *hev  = (xcb_input_hierarchy_event_t *) event;
 
     xcb_input_hierarchy_info_iterator_t iter;
@@ -117,6 +141,12 @@ void X11EventNotifier::handleX11InputEvent(xcb_ge_generic_event_t* event)
     iter.index = reinterpret_cast<char*>(iter.data) - reinterpret_cast<char*>(hev);
 
     for (; iter.rem; xcb_input_hierarchy_info_next(&iter)) {
+        // device ids are reused, so forget what we know about the device
+        if (iter.data->flags & (XCB_INPUT_HIERARCHY_MASK_SLAVE_REMOVED | XCB_INPUT_HIERARCHY_MASK_SLAVE_ADDED)) {
+            d->deviceNames.remove(iter.data->deviceid);
+            d->pendingProperties.remove(iter.data->deviceid);
+        }
+
         if (iter.data->flags & XCB_INPUT_HIERARCHY_MASK_SLAVE_REMOVED) {
             qCDebug(KDED) << QString::fromLatin1("X11 device with id '%1' removed.").arg(iter.data->deviceid);
             emit tabletRemoved(iter.data->deviceid);
@@ -136,6 +166,91 @@ void X11EventNotifier::handleX11InputEvent(xcb_ge_generic_event_t* event)
 
 
 
+void X11EventNotifier::handleX11PropertyEvent(xcb_ge_generic_event_t* event)
+{
+    Q_D (X11EventNotifier);
+
+    xcb_input_property_event_t *pev = reinterpret_cast<xcb_input_property_event_t*>(event);
+
+    if (getTabletDeviceName(pev->deviceid).isEmpty()) {
+        return;
+    }
+
+    d->pendingProperties[pev->deviceid].insert(pev->property);
+
+    if (!d->propertiesTimer.isActive()) {
+        d->propertiesTimer.start();
+    }
+}
+
+
+
+void X11EventNotifier::publishDeviceProperties()
+{
+    Q_D (X11EventNotifier);
+
+    // take the pending changes first, so signal handlers can queue new ones
+    const QHash<int, QSet<X11InputDevice::Atom> > pendingProperties = d->pendingProperties;
+    d->pendingProperties.clear();
+
+    for (auto device = pendingProperties.constBegin() ; device != pendingProperties.constEnd() ; ++device) {
+        QStringList properties;
+
+        foreach (const X11InputDevice::Atom& atom, device.value()) {
+            const QString name = X11Input::getAtomName(atom);
+
+            if (!name.isEmpty()) {
+                properties.append(name);
+            }
+        }
+
+        properties.sort();
+
+        const QString deviceName = d->deviceNames.value(device.key());
+
+        qCDebug(KDED) << QString::fromLatin1("Properties of X11 device '%1' changed: %2").arg(deviceName).arg(properties.join(QLatin1String(", ")));
+        emit devicePropertiesChanged(deviceName, properties);
+    }
+}
+
+
+
+QString X11EventNotifier::getTabletDeviceName(int deviceId)
+{
+    Q_D (X11EventNotifier);
+
+    auto cached = d->deviceNames.constFind(deviceId);
+
+    if (cached != d->deviceNames.constEnd()) {
+        return cached.value();
+    }
+
+    QString name;
+
+    X11InputDevice device (deviceId, QLatin1String("Unknown X11 Device"));
+
+    if (device.isOpen() && device.isTabletDevice()) {
+        xcb_input_xi_query_device_cookie_t cookie = xcb_input_xi_query_device(QX11Info::connection(), deviceId);
+        xcb_input_xi_query_device_reply_t* reply  = xcb_input_xi_query_device_reply(QX11Info::connection(), cookie, nullptr);
+
+        if (reply) {
+            xcb_input_xi_device_info_iterator_t info = xcb_input_xi_query_device_infos_iterator(reply);
+
+            if (info.rem > 0) {
+                name = QString::fromUtf8(xcb_input_xi_device_info_name(info.data), xcb_input_xi_device_info_name_length(info.data));
+            }
+
+            free(reply);
+        }
+    }
+
+    d->deviceNames.insert(deviceId, name);
+
+    return name;
+}
+
+
+
 int X11EventNotifier::registerForNewDeviceEvent(xcb_connection_t* conn)
 {
     char buf[sizeof(xcb_input_event_mask_t) + sizeof(uint32_t)];
@@ -145,7 +260,9 @@ int X11EventNotifier::registerForNewDeviceEvent(xcb_connection_t* conn)
     evmask->mask_len = 1;
 
     uint32_t* mask_buf = xcb_input_event_mask_mask( evmask );
-    mask_buf[0] = XCB_INPUT_XI_EVENT_MASK_HIERARCHY;
+    // property events are selected for all devices and filtered on arrival, so
+    // tablets connected later do not have to be selected one by one
+    mask_buf[0] = XCB_INPUT_XI_EVENT_MASK_HIERARCHY | XCB_INPUT_XI_EVENT_MASK_PROPERTY;
 
     xcb_input_xi_select_events(conn, QX11Info::appRootWindow(), 1, evmask);
     return 0;
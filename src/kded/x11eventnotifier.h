@@ -31,6 +31,9 @@ class X11EventNotifierPrivate;
 
 /**
  * @brief Singleton that listens to X11 events, mainly tablet plug/unplug events
+ *
+ * Property changes of tablet devices are collected for a short time and
+ * then reported as one devicePropertiesChanged() signal per device.
  */
 class X11EventNotifier : public EventNotifier, public QAbstractNativeEventFilter
 {
@@ -74,6 +77,24 @@ private:
      */
     void handleX11InputEvent(xcb_ge_generic_event_t* event);
 
+    /**
+     * Handles X11 input events which signal a property change of a device.
+     * The change is only queued, it is reported by publishDeviceProperties().
+     */
+    void handleX11PropertyEvent(xcb_ge_generic_event_t* event);
+
+    /**
+     * Emits a devicePropertiesChanged signal for every device with queued
+     * property changes. The property atoms are resolved to their names.
+     */
+    void publishDeviceProperties();
+
+    /**
+     * Gets the name of the tablet device with the given id. Devices are only
+     * queried once, other devices are remembered with an empty name.
+     */
+    QString getTabletDeviceName(int deviceId);
+
     /**
       * Register the eventhandler with the X11 system
       */
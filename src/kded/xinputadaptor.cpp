@@ -25,7 +25,8 @@
 #include "xinputproperty.h"
 #include "x11input.h"
 #include "x11inputdevice.h"
-#include "screensinfo.h"
+#include "screentopology.h"
+#include "tabletmapping.h"
 #include "x11wacom.h"
 
 #include <QApplication>
@@ -38,6 +39,8 @@ class XinputAdaptorPrivate
     public:
         QString        deviceName;
         X11InputDevice device;
+        QString        screenSpace;               //!< The screen space the tablet was mapped to last.
+        bool           keepAspectRatio = false;   //!< Letterbox the screen space to the tablet area.
 }; // CLASS
 } // NAMESPACE
 
@@ -84,6 +87,19 @@ const QString XinputAdaptor::getProperty(const Property& property) const
 }
 
 
+const QString XinputAdaptor::getPropertyState(const Property& property) const
+{
+    Q_D(const XinputAdaptor);
+
+    // the screen space can not be read back, but the matrix tells if it is still set
+    if (property == Property::ScreenSpace && d->device.isOpen()) {
+        return getFloatProperty(XinputProperty::ScreenSpace, 9);
+    }
+
+    return getProperty(property);
+}
+
+
 bool XinputAdaptor::setProperty(const Property& property, const QString& value)
 {
     Q_D(const XinputAdaptor);
@@ -132,6 +148,13 @@ const QString XinputAdaptor::getProperty(const XinputProperty& property) const
     } else if (property == XinputProperty::InvertScroll) {
         return (X11Wacom::isScrollDirectionInverted(d->deviceName) ? QLatin1String("on") : QLatin1String("off"));
 
+    } else if (property == XinputProperty::KeepAspectRatio) {
+        return (d->keepAspectRatio ? QLatin1String("true") : QLatin1String("false"));
+
+    } else if (property == XinputProperty::ScreenSpace) {
+        // the screen space can not be read back from the device
+        return d->screenSpace;
+
     } else {
         qCWarning(KDED) << QString::fromLatin1("Getting Xinput property '%1' is not yet implemented!").arg(property.key());
     }
@@ -179,10 +202,8 @@ bool XinputAdaptor::mapTabletToScreen(const QString& screenArea) const
 
     // what we need is the Coordinate Transformation Matrix
     // in the normal case where the whole screen is used we end up with a 3x3 identity matrix
-    //in our case we want to change that
-    // | w  0  offsetX |
-    // | 0  h  offsetY |
-    // | 0  0     1    |
+    // the driver applies rotation and tablet area itself, so all we have to fold
+    // into the matrix is the screen space and the letterboxing
 
     qCDebug(KDED) << "Mapping to area: " << screenArea;
 
@@ -191,65 +212,86 @@ bool XinputAdaptor::mapTabletToScreen(const QString& screenArea) const
     }
 
     // get the space the user wants to use to map the tablet
-    QRect          screenAreaGeometry;
-    QRect          fullScreenGeometry = ScreensInfo::getUnifiedDisplayGeometry();
-    ScreenSpace    screenSpace(screenArea);
+    const ScreenTopology topology = ScreenTopology::current();
+    QRect                screenAreaGeometry;
+    QTransform           matrix;
+    ScreenSpace          screenSpace(screenArea);
 
     switch (screenSpace.getType()) {
     case Wacom::ScreenSpace::ScreenSpaceType::Desktop:
     {
-        qCDebug(KDED) << "Full screen area selected: " << fullScreenGeometry;
-        screenAreaGeometry = fullScreenGeometry;
+        qCDebug(KDED) << "Full screen area selected: " << topology.desktopGeometry();
+        screenAreaGeometry = topology.desktopGeometry();
+        matrix             = topology.desktopMatrix();
 
         break;
     }
     case Wacom::ScreenSpace::ScreenSpaceType::Output:
     {
         auto output = screenSpace.toString();
-        QMap<QString, QRect> screenList = ScreensInfo::getScreenGeometries();
+        bool found  = false;
+
+        matrix = topology.outputMatrix(output, &found);
 
-        if (!screenList.contains(output)) {
-            qCDebug(KDED) << "Selected monitor no longer connected - using full screen: " << fullScreenGeometry;
-            screenAreaGeometry = fullScreenGeometry;
+        if (!found) {
+            qCDebug(KDED) << "Selected monitor no longer connected - using full screen: " << topology.desktopGeometry();
+            screenAreaGeometry = topology.desktopGeometry();
         } else {
-            qCDebug(KDED) << "Use monitor geometry for screen " << output << ": " << screenList.value(output);
-            screenAreaGeometry = screenList.value(output);
+            qCDebug(KDED) << "Use monitor geometry for screen " << output << ": " << topology.outputGeometry(output);
+            screenAreaGeometry = topology.outputGeometry(output);
         }
 
         break;
     }
     case Wacom::ScreenSpace::ScreenSpaceType::Area:
     {
+        qCDebug(KDED) << "Geometry selected: " << screenSpace.getArea();
         screenAreaGeometry = screenSpace.getArea();
-        qCDebug(KDED) << "Geometry selected: " << screenAreaGeometry;
+        matrix             = topology.areaMatrix(screenAreaGeometry);
         break;
     }
     case Wacom::ScreenSpace::ScreenSpaceType::ArbitraryTranslationMatrix:
     {
         qCDebug(KDED) << "Arbitrary transformation matrix is selected" << screenSpace.getSpeed();
 
-        return X11Wacom::setCoordinateTransformationMatrix(d->deviceName, 0, 0, screenSpace.getSpeed().x(), screenSpace.getSpeed().y());
+        matrix = QTransform::fromScale(screenSpace.getSpeed().x(), screenSpace.getSpeed().y());
+        return d->device.setFloatProperty(X11Input::PROPERTY_TRANSFORM_MATRIX, TabletMapping::toPropertyValues(matrix));
     }
     }
 
-    // calculate the new transformation matrix
-    int screenX = screenAreaGeometry.x();
-    int screenY = screenAreaGeometry.y();
-    int screenW = screenAreaGeometry.width();
-    int screenH = screenAreaGeometry.height();
+    if (d->keepAspectRatio) {
+        qreal aspectRatio = getTabletAreaAspectRatio();
 
-    qreal w = static_cast<qreal>(screenW) / fullScreenGeometry.width();
-    qreal h = static_cast<qreal>(screenH) / fullScreenGeometry.height();
-
-    qreal offsetX = static_cast<qreal>(screenX) / fullScreenGeometry.width();
-    qreal offsetY = static_cast<qreal>(screenY) / fullScreenGeometry.height();
+        qCDebug(KDED) << "Letterbox screen area to aspect ratio" << aspectRatio;
+        matrix = TabletMapping::calculateMatrix(topology.desktopGeometry(), screenAreaGeometry, ScreenRotation::NONE, aspectRatio);
+    }
 
-    qCDebug(KDED) << "Apply Coordinate Transformation Matrix";
-    qCDebug(KDED) << w << "0" << offsetX;
-    qCDebug(KDED) << "0" << h << offsetY;
+    qCDebug(KDED) << "Apply Coordinate Transformation Matrix of screen topology" << topology.generation();
+    qCDebug(KDED) << matrix.m11() << matrix.m21() << matrix.dx();
+    qCDebug(KDED) << matrix.m12() << matrix.m22() << matrix.dy();
     qCDebug(KDED) << "0" << "0" << "1";
 
-    return X11Wacom::setCoordinateTransformationMatrix(d->deviceName, offsetX, offsetY, w, h);
+    // the device is already open, so this is a single property write
+    return d->device.setFloatProperty(X11Input::PROPERTY_TRANSFORM_MATRIX, TabletMapping::toPropertyValues(matrix));
+}
+
+
+
+qreal XinputAdaptor::getTabletAreaAspectRatio() const
+{
+    Q_D( const XinputAdaptor );
+
+    // the driver reports the area after its rotation as "x1 y1 x2 y2"
+    QList<long> area;
+
+    if (!d->device.getLongProperty(X11Input::PROPERTY_WACOM_TABLET_AREA, area, 4) || area.size() != 4) {
+        return 0;
+    }
+
+    long width  = area.at(2) - area.at(0);
+    long height = area.at(3) - area.at(1);
+
+    return (width > 0 && height > 0) ? static_cast<qreal>(width) / height : 0;
 }
 
 
@@ -272,9 +314,9 @@ const QString XinputAdaptor::numbersToString(const QList<T>& values) const
 
 
 
-bool XinputAdaptor::setProperty (const XinputProperty& property, const QString& value) const
+bool XinputAdaptor::setProperty (const XinputProperty& property, const QString& value)
 {
-    Q_D( const XinputAdaptor );
+    Q_D( XinputAdaptor );
 
     if (property == XinputProperty::CursorAccelProfile) {
         return d->device.setLongProperty (property.key(), value);
@@ -291,7 +333,14 @@ bool XinputAdaptor::setProperty (const XinputProperty& property, const QString&
     } else if (property == XinputProperty::InvertScroll) {
         return X11Wacom::setScrollDirection(d->deviceName, StringUtils::asBool(value));
 
+    } else if (property == XinputProperty::KeepAspectRatio) {
+        d->keepAspectRatio = StringUtils::asBool(value);
+
+        // the letterboxing is part of the screen space mapping
+        return (d->screenSpace.isEmpty() || mapTabletToScreen (d->screenSpace));
+
     } else if (property == XinputProperty::ScreenSpace) {
+        d->screenSpace = value;
         return mapTabletToScreen (value);
 
     } else {
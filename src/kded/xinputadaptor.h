@@ -54,6 +54,14 @@ public:
      */
     const QString getProperty(const Property& property) const override;
 
+    /**
+     * Gets the transformation matrix as the state of the screen space,
+     * all other states are the property values.
+     *
+     * @sa PropertyAdaptor::getPropertyState(const Property&)
+     */
+    const QString getPropertyState(const Property& property) const override;
+
     /**
      * @sa PropertyAdaptor::setProperty(const Property&, const QString&)
      */
@@ -73,12 +81,17 @@ private:
 
     const QString getLongProperty(const XinputProperty& property, long nelements = 1) const;
 
+    /**
+     * @return The aspect ratio of the tablet area as set in the driver or 0 if it is unknown.
+     */
+    qreal getTabletAreaAspectRatio() const;
+
     bool mapTabletToScreen(const QString& screenArea) const;
 
     template<typename T>
     const QString numbersToString(const QList<T>& values) const;
 
-    bool setProperty(const XinputProperty& property, const QString& value) const;
+    bool setProperty(const XinputProperty& property, const QString& value);
 
     Q_DECLARE_PRIVATE( XinputAdaptor )
     XinputAdaptorPrivate *const d_ptr; /**< d-pointer for this class */
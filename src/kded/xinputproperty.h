@@ -43,6 +43,7 @@ public:
     static const XinputProperty CursorAccelAdaptiveDeceleration;
     static const XinputProperty CursorAccelVelocityScaling;
     static const XinputProperty InvertScroll;
+    static const XinputProperty KeepAspectRatio;
     static const XinputProperty ScreenSpace;
 
 private:
@@ -22,14 +22,13 @@
 
 #include "hwbuttondialog.h"
 #include "tabletdatabase.h"
+#include "x11tabletfinder.h"
 
 #include <KSharedConfig>
 #include <KConfigGroup>
 
-#include <QProcess>
-#include <QMap>
-#include <QMapIterator>
 #include <QAbstractButton>
+#include <QtConcurrentRun>
 
 using namespace Wacom;
 
@@ -40,6 +39,9 @@ Dialog::Dialog(QWidget *parent)
 {
     m_ui->setupUi(this);
 
+    connect(&m_scanWatcher, &QFutureWatcher<QList<TabletInformation> >::finished,
+            this, &Dialog::onTabletsScanned);
+
     connect(m_ui->refreshButton, SIGNAL(clicked()),
             SLOT(refreshTabletList()));
     connect(m_ui->listTablets, SIGNAL(currentIndexChanged(int)),
@@ -80,11 +82,33 @@ Dialog::Dialog(QWidget *parent)
 
 Dialog::~Dialog()
 {
+    // the scan uses the X11 connection of the application, let it finish first
+    m_scanWatcher.waitForFinished();
+
     delete m_ui;
 }
 
 void Dialog::refreshTabletList()
 {
+    if (m_scanWatcher.isRunning()) {
+        return;
+    }
+
+    // scanning all input devices can take a moment, so do not block the dialog
+    m_ui->refreshButton->setEnabled(false);
+
+    m_scanWatcher.setFuture(QtConcurrent::run([]() {
+        X11TabletFinder tabletFinder;
+        tabletFinder.scanDevices();
+
+        return tabletFinder.getTablets();
+    }));
+}
+
+void Dialog::onTabletsScanned()
+{
+    m_ui->refreshButton->setEnabled(true);
+
     m_ui->listTablets->blockSignals(true);
     m_ui->comboTouchSensor->blockSignals(true);
 
@@ -93,52 +117,20 @@ void Dialog::refreshTabletList()
 
     m_tabletList.clear();
 
-    // fetch all connected tablets
-    QLatin1String program("xsetwacom");
-    QStringList arguments;
-    arguments << QLatin1String("--list") << QLatin1String("devices");
-
-    QProcess listDevices;
-    listDevices.start(program, arguments);
-    listDevices.waitForFinished();
-
-    QString listDevicesString = QString::fromLatin1(listDevices.readAll());
-    QStringList listDevicesStringList = listDevicesString.split(QLatin1String("\n"));
+    // for each tablet figure out the common base name of its devices
+    // for most this is the name without "pad", "stylus", "touch" etc
+    // for some like the Wacom Pen and Touch we remove "Finger" as well
+    const QList<TabletInformation> tablets = m_scanWatcher.result();
 
-    // for each tablet device fetch the device id
-    QMap<QString, QStringList> tabletList;
-    foreach(const QString &s, listDevicesStringList) {
-        QString device = s.split(QLatin1String("\t")).first();
-        device = device.trimmed();
+    foreach (const TabletInformation& tabletInformation, tablets) {
+        QString name;
+        QStringList deviceList = tabletInformation.getDeviceList();
 
-        if(device.isEmpty()) {
+        if (deviceList.isEmpty()) {
             continue;
         }
 
-        QProcess checkTabletID;
-        arguments.clear();
-        arguments << QLatin1String("--get") << device << QLatin1String("TabletID");
-        checkTabletID.start(program, arguments);
-        checkTabletID.waitForFinished();
-
-        QString checkTabletIDString = QString::fromLatin1(checkTabletID.readAll());
-        checkTabletIDString.remove(QLatin1String("\n"));
-        QString tabletID = checkTabletIDString.trimmed();
-
-        QStringList tl = tabletList.value(tabletID);
-        tl << device;
-        tabletList.insert(tabletID, tl);
-    }
-
-    // for each device id figure out the common base name
-    // for most this is the name without "pad", "stylus", "touch" etc
-    // for some like the Wacom Pen and Touch we remove "Finger" as well
-    QMapIterator<QString, QStringList> i(tabletList);
-    while (i.hasNext()) {
-        i.next();
-
-        QString name;
-        QStringList deviceList = i.value();
+        const QStringList devices = deviceList;
         QString firstDevice = deviceList.takeFirst();
         bool end = false;
 
@@ -146,7 +138,7 @@ void Dialog::refreshTabletList()
             QChar c = firstDevice.at(j);
 
             foreach(const QString &s, deviceList) {
-                if(s.at(j) != c) {
+                if(j >= s.length() || s.at(j) != c) {
                     end = true;
                     break;
                 }
@@ -161,10 +153,10 @@ void Dialog::refreshTabletList()
 
         // create the Tablet entry
         Tablet t;
-        t.serialID = i.key().toInt();
+        t.serialID = static_cast<int>(tabletInformation.getTabletSerial());
         t.company = QLatin1String("Wacom");
         t.name = name.trimmed();
-        t.devices = i.value();
+        t.devices = devices;
 
         QString hexNumber = QString::number( t.serialID, 16 );
         while(hexNumber.length() < 4) {
@@ -21,6 +21,8 @@
 #define DIALOG_H
 
 #include <QDialog>
+#include <QFutureWatcher>
+#include <QList>
 
 #include "tabletinformation.h"
 
@@ -48,6 +50,7 @@ public:
 private slots:
     // tablet detection and user selection
     void refreshTabletList();
+    void onTabletsScanned();
     void changeTabletSelection(int index);
 
     // update internal representation on user changes
@@ -102,6 +105,7 @@ private:
 
     QList<TabletInformation> m_tabletInformation;
     QList<Tablet> m_tabletList;
+    QFutureWatcher<QList<TabletInformation> > m_scanWatcher; //!< Scans for tablets without blocking the dialog.
     Wacom::HWButtonDialog *m_hwbDialog;
 };
 }